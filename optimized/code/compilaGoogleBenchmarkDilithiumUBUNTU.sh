@@ -12,7 +12,7 @@ do
     echo -e "\n\nCompilando e executando benchmark para Dilithium versão $VERSION\n"
 
     # Definir o DILITHIUM_MODE, compilar e suprimir warnings com a flag -w
-    g++ -O3 -w -std=c++11 -DDILITHIUM_MODE=$VERSION -I /usr/local/include test/googleBenchmarkDilithiun.cpp sign.c poly.c polyvec.c randombytes.c ntt.c reduce.c fips202.c fips202x2.c packing.c rounding.c symmetric-shake.c feat.S -L /usr/local/lib -lbenchmark -lpthread -o test/googleBenchmarkDilithiun_UBUNTU_mode$VERSION
+    g++ -O3 -w -std=c++11 -DDILITHIUM_MODE=$VERSION -I /usr/local/include test/googleBenchmarkDilithiun.cpp sign.c poly.c poly_neon.c polyvec.c randombytes.c ntt.c reduce.c fips202.c fips202x2.c fips202x3.c packing.c rounding.c symmetric-shake.c feat.S feat_sha3.c cpu.c -L /usr/local/lib -lbenchmark -lpthread -o test/googleBenchmarkDilithiun_UBUNTU_mode$VERSION
 
     # Executar o benchmark
     ./test/googleBenchmarkDilithiun_UBUNTU_mode$VERSION
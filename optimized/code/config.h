@@ -3,6 +3,9 @@
 
 //#define DILITHIUM_MODE 2
 #define DILITHIUM_RANDOMIZED_SIGNING
+#define DILITHIUM_INTERLEAVED_MASK
+//#define DILITHIUM_DRBG_SHAKE256
+#define DILITHIUM_RUNTIME_DISPATCH
 //#define USE_RDPMC
 //#define DBENCH
 
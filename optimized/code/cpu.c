@@ -0,0 +1,54 @@
+#include <stdlib.h>
+#include "cpu.h"
+
+#if defined(__linux__) && defined(__aarch64__)
+#include <sys/auxv.h>
+#ifndef HWCAP_SHA3
+#define HWCAP_SHA3 (1UL << 17)
+#endif
+#ifndef HWCAP_SVE
+#define HWCAP_SVE (1UL << 22)
+#endif
+#ifndef HWCAP2_SVE2
+#define HWCAP2_SVE2 (1UL << 1)
+#endif
+#endif
+
+/*************************************************
+* Name:        dilithium_cpu_features
+*
+* Description: Detect the optional Armv8 extensions of the running core
+*              (getauxval HWCAP/HWCAP2 on Linux). Meant to be called once
+*              from the load-time dispatch initializers.
+*              The environment variable DILITHIUM_ARMCAP, if set, is a
+*              mask (strtoul syntax, e.g. "0" or "0x1") ANDed with the
+*              detected bits, so slower paths can be forced for testing
+*              and benchmarking.
+*
+* Returns bitwise OR of CPU_FEATURE_* flags
+**************************************************/
+unsigned int dilithium_cpu_features(void) {
+  unsigned int features = 0;
+  const char *mask;
+
+#if defined(__linux__) && defined(__aarch64__)
+  unsigned long hwcap = getauxval(AT_HWCAP);
+  unsigned long hwcap2 = getauxval(AT_HWCAP2);
+
+  if(hwcap & HWCAP_SHA3)
+    features |= CPU_FEATURE_SHA3;
+  if(hwcap & HWCAP_SVE)
+    features |= CPU_FEATURE_SVE;
+  if(hwcap2 & HWCAP2_SVE2)
+    features |= CPU_FEATURE_SVE2;
+#elif defined(__APPLE__) && defined(__aarch64__)
+  /* Todos os núcleos Apple Silicon (M1 em diante) têm SHA3 e nenhum tem SVE */
+  features |= CPU_FEATURE_SHA3;
+#endif
+
+  mask = getenv("DILITHIUM_ARMCAP");
+  if(mask)
+    features &= (unsigned int)strtoul(mask, NULL, 0);
+
+  return features;
+}
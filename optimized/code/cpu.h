@@ -0,0 +1,36 @@
+#ifndef CPU_H
+#define CPU_H
+
+#include "config.h"
+
+/* Bits devolvidos por dilithium_cpu_features() */
+#define CPU_FEATURE_SHA3 (1u << 0)  // EOR3, RAX1, XAR, BCAX (Armv8.2-SHA3)
+#define CPU_FEATURE_SVE  (1u << 1)
+#define CPU_FEATURE_SVE2 (1u << 2)
+
+/* Seleção da permutação Keccak:
+ * - KECCAK_SHA3_STATIC: o compilador já garante SHA3 (ou Apple Silicon),
+ *   f1600/f1600x2 são chamadas diretamente;
+ * - KECCAK_SHA3_DISPATCH: binário genérico em Linux/AArch64, a versão SHA3
+ *   é escolhida em tempo de carga se o HWCAP indicar suporte. */
+#if (defined(__APPLE__) && defined(__ARM_FEATURE_CRYPTO)) || defined(__ARM_FEATURE_SHA3)
+#define KECCAK_SHA3_STATIC
+#elif defined(DILITHIUM_RUNTIME_DISPATCH) && defined(__linux__) && defined(__aarch64__)
+#define KECCAK_SHA3_DISPATCH
+#endif
+
+/* Seleção da NTT e da rejeição SVE (ntt_sve.c, poly_sve.c):
+ * - POLY_SVE_STATIC: compilado com SVE (ARCH=sve/sve2), os núcleos SVE
+ *   substituem diretamente os NEON;
+ * - POLY_SVE_DISPATCH: binário NEON genérico em Linux/AArch64, ntt,
+ *   invntt_tomont, rej_uniform e rej_eta passam para SVE em tempo de carga
+ *   se o HWCAP indicar suporte. */
+#if defined(__ARM_FEATURE_SVE)
+#define POLY_SVE_STATIC
+#elif defined(DILITHIUM_RUNTIME_DISPATCH) && defined(__linux__) && defined(__aarch64__)
+#define POLY_SVE_DISPATCH
+#endif
+
+unsigned int dilithium_cpu_features(void);
+
+#endif
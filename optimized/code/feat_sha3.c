@@ -0,0 +1,284 @@
+/*
+ * Permutações Keccak-f[1600] com as instruções da extensão SHA3 do Armv8.2
+ * (EOR3, RAX1, XAR, BCAX) escritas com intrínsecos, para GCC/clang em Linux.
+ * É a mesma sequência de instruções da macro "round" de feat.S (sintaxe
+ * Apple), com os registradores v0..v31 mantidos como variáveis locais, e
+ * exporta os mesmos símbolos f1600 e f1600x2.
+ *
+ * Com -march=armv8.2-a+sha3 (ou -mcpu=neoverse-v1, -mcpu=native em núcleos
+ * com SHA3) as funções são chamadas diretamente. Com
+ * DILITHIUM_RUNTIME_DISPATCH o arquivo é compilado para o alvo SHA3 mesmo
+ * num binário armv8-a genérico, e fips202*.c só o chamam quando o HWCAP
+ * do núcleo em execução indicar suporte.
+ */
+#include "cpu.h"
+
+#if !defined(__APPLE__) && (defined(__ARM_FEATURE_SHA3) || defined(KECCAK_SHA3_DISPATCH))
+
+#if !defined(__ARM_FEATURE_SHA3)
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sha3"))), apply_to = function)
+#else
+#pragma GCC target ("arch=armv8.2-a+sha3")
+#endif
+#endif
+
+#include <stdint.h>
+#include <arm_neon.h>
+
+#define NROUNDS 24
+
+// Uma rodada completa: theta, rho, pi, chi e iota (rc = constante da rodada)
+#define SHA3_ROUND(rc) do {                                            \
+    /* Execute theta, but without xoring into the state yet. */        \
+    /* Compute parities p[i] = a[i] ^ a[5+i] ^ ... ^ a[20+i]. */       \
+    v25 = veor3q_u64(v0, v5, v10);                                     \
+    v26 = veor3q_u64(v1, v6, v11);                                     \
+    v27 = veor3q_u64(v2, v7, v12);                                     \
+    v28 = veor3q_u64(v3, v8, v13);                                     \
+    v29 = veor3q_u64(v4, v9, v14);                                     \
+                                                                       \
+    v25 = veor3q_u64(v25, v15, v20);                                   \
+    v26 = veor3q_u64(v26, v16, v21);                                   \
+    v27 = veor3q_u64(v27, v17, v22);                                   \
+    v28 = veor3q_u64(v28, v18, v23);                                   \
+    v29 = veor3q_u64(v29, v19, v24);                                   \
+                                                                       \
+    v30 = vrax1q_u64(v29, v26); /* d[0] = rotl(p[1], 1) ^ p[4] */      \
+    v29 = vrax1q_u64(v27, v29); /* d[3] = rotl(p[4], 1) ^ p[2] */      \
+    v27 = vrax1q_u64(v25, v27); /* d[1] = rotl(p[2], 1) ^ p[0] */      \
+    v25 = vrax1q_u64(v28, v25); /* d[4] = rotl(p[0], 1) ^ p[3] */      \
+    v28 = vrax1q_u64(v26, v28); /* d[2] = rotl(p[3], 1) ^ p[1] */      \
+                                                                       \
+    /* Xor parities from step theta into the state at the same time */ \
+    /* as executing rho and pi. */                                     \
+    v0 = veorq_u64(v0, v30);                                           \
+    v31 = v1;                                                          \
+    v1 = vxarq_u64(v6, v27, 20);                                       \
+    v6 = vxarq_u64(v9, v25, 44);                                       \
+    v9 = vxarq_u64(v22, v28, 3);                                       \
+    v22 = vxarq_u64(v14, v25, 25);                                     \
+    v14 = vxarq_u64(v20, v30, 46);                                     \
+    v20 = vxarq_u64(v2, v28, 2);                                       \
+    v2 = vxarq_u64(v12, v28, 21);                                      \
+    v12 = vxarq_u64(v13, v29, 39);                                     \
+    v13 = vxarq_u64(v19, v25, 56);                                     \
+    v19 = vxarq_u64(v23, v29, 8);                                      \
+    v23 = vxarq_u64(v15, v30, 23);                                     \
+    v15 = vxarq_u64(v4, v25, 37);                                      \
+    v4 = vxarq_u64(v24, v25, 50);                                      \
+    v24 = vxarq_u64(v21, v27, 62);                                     \
+    v21 = vxarq_u64(v8, v29, 9);                                       \
+    v8 = vxarq_u64(v16, v27, 19);                                      \
+    v16 = vxarq_u64(v5, v30, 28);                                      \
+    v5 = vxarq_u64(v3, v29, 36);                                       \
+    v3 = vxarq_u64(v18, v29, 43);                                      \
+    v18 = vxarq_u64(v17, v28, 49);                                     \
+    v17 = vxarq_u64(v11, v27, 54);                                     \
+    v11 = vxarq_u64(v7, v28, 58);                                      \
+    v7 = vxarq_u64(v10, v30, 61);                                      \
+    v10 = vxarq_u64(v31, v27, 63);                                     \
+                                                                       \
+    /* Chi */                                                          \
+    v25 = vbcaxq_u64(v0, v2, v1);                                      \
+    v26 = vbcaxq_u64(v1, v3, v2);                                      \
+    v2 = vbcaxq_u64(v2, v4, v3);                                       \
+    v3 = vbcaxq_u64(v3, v0, v4);                                       \
+    v4 = vbcaxq_u64(v4, v1, v0);                                       \
+    v0 = v25;                                                          \
+    v1 = v26;                                                          \
+                                                                       \
+    v25 = vbcaxq_u64(v5, v7, v6);                                      \
+    v26 = vbcaxq_u64(v6, v8, v7);                                      \
+    v7 = vbcaxq_u64(v7, v9, v8);                                       \
+    v8 = vbcaxq_u64(v8, v5, v9);                                       \
+    v9 = vbcaxq_u64(v9, v6, v5);                                       \
+    v5 = v25;                                                          \
+    v6 = v26;                                                          \
+                                                                       \
+    v25 = vbcaxq_u64(v10, v12, v11);                                   \
+    v26 = vbcaxq_u64(v11, v13, v12);                                   \
+    v12 = vbcaxq_u64(v12, v14, v13);                                   \
+    v13 = vbcaxq_u64(v13, v10, v14);                                   \
+    v14 = vbcaxq_u64(v14, v11, v10);                                   \
+    v10 = v25;                                                         \
+    v11 = v26;                                                         \
+                                                                       \
+    v25 = vbcaxq_u64(v15, v17, v16);                                   \
+    v26 = vbcaxq_u64(v16, v18, v17);                                   \
+    v17 = vbcaxq_u64(v17, v19, v18);                                   \
+    v18 = vbcaxq_u64(v18, v15, v19);                                   \
+    v19 = vbcaxq_u64(v19, v16, v15);                                   \
+    v15 = v25;                                                         \
+    v16 = v26;                                                         \
+                                                                       \
+    v25 = vbcaxq_u64(v20, v22, v21);                                   \
+    v26 = vbcaxq_u64(v21, v23, v22);                                   \
+    v22 = vbcaxq_u64(v22, v24, v23);                                   \
+    v23 = vbcaxq_u64(v23, v20, v24);                                   \
+    v24 = vbcaxq_u64(v24, v21, v20);                                   \
+    v20 = v25;                                                         \
+    v21 = v26;                                                         \
+                                                                       \
+    /* iota */                                                         \
+    v0 = veorq_u64(v0, vdupq_n_u64(rc));                               \
+} while (0)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+void f1600x2(uint64x2_t *state, const uint64_t *rc);
+void f1600(uint64_t *state, const uint64_t *rc);
+#ifdef __cplusplus
+}
+#endif
+
+/*************************************************
+* Name:        f1600x2
+*
+* Description: Two Keccak-f[1600] permutations, one per 64-bit lane.
+*
+* Arguments:   - uint64x2_t *state: pointer to input/output interleaved state
+*              - const uint64_t *rc: pointer to the 24 round constants
+**************************************************/
+void f1600x2(uint64x2_t *state, const uint64_t *rc) {
+    uint64x2_t v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12;
+    uint64x2_t v13, v14, v15, v16, v17, v18, v19, v20, v21, v22, v23, v24;
+    uint64x2_t v25, v26, v27, v28, v29, v30, v31;
+    int round;
+
+    v0 = state[0];
+    v1 = state[1];
+    v2 = state[2];
+    v3 = state[3];
+    v4 = state[4];
+    v5 = state[5];
+    v6 = state[6];
+    v7 = state[7];
+    v8 = state[8];
+    v9 = state[9];
+    v10 = state[10];
+    v11 = state[11];
+    v12 = state[12];
+    v13 = state[13];
+    v14 = state[14];
+    v15 = state[15];
+    v16 = state[16];
+    v17 = state[17];
+    v18 = state[18];
+    v19 = state[19];
+    v20 = state[20];
+    v21 = state[21];
+    v22 = state[22];
+    v23 = state[23];
+    v24 = state[24];
+
+    for (round = 0; round < NROUNDS; ++round) {
+        SHA3_ROUND(rc[round]);
+    }
+
+    state[0] = v0;
+    state[1] = v1;
+    state[2] = v2;
+    state[3] = v3;
+    state[4] = v4;
+    state[5] = v5;
+    state[6] = v6;
+    state[7] = v7;
+    state[8] = v8;
+    state[9] = v9;
+    state[10] = v10;
+    state[11] = v11;
+    state[12] = v12;
+    state[13] = v13;
+    state[14] = v14;
+    state[15] = v15;
+    state[16] = v16;
+    state[17] = v17;
+    state[18] = v18;
+    state[19] = v19;
+    state[20] = v20;
+    state[21] = v21;
+    state[22] = v22;
+    state[23] = v23;
+    state[24] = v24;
+}
+
+/*************************************************
+* Name:        f1600
+*
+* Description: One Keccak-f[1600] permutation, computed in the low lane of
+*              the vector registers (as ld1.1d does in feat.S).
+*
+* Arguments:   - uint64_t *state: pointer to input/output state
+*              - const uint64_t *rc: pointer to the 24 round constants
+**************************************************/
+void f1600(uint64_t *state, const uint64_t *rc) {
+    uint64x2_t v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12;
+    uint64x2_t v13, v14, v15, v16, v17, v18, v19, v20, v21, v22, v23, v24;
+    uint64x2_t v25, v26, v27, v28, v29, v30, v31;
+    const uint64x1_t zero = vdup_n_u64(0);
+    int round;
+
+    v0 = vcombine_u64(vld1_u64(&state[0]), zero);
+    v1 = vcombine_u64(vld1_u64(&state[1]), zero);
+    v2 = vcombine_u64(vld1_u64(&state[2]), zero);
+    v3 = vcombine_u64(vld1_u64(&state[3]), zero);
+    v4 = vcombine_u64(vld1_u64(&state[4]), zero);
+    v5 = vcombine_u64(vld1_u64(&state[5]), zero);
+    v6 = vcombine_u64(vld1_u64(&state[6]), zero);
+    v7 = vcombine_u64(vld1_u64(&state[7]), zero);
+    v8 = vcombine_u64(vld1_u64(&state[8]), zero);
+    v9 = vcombine_u64(vld1_u64(&state[9]), zero);
+    v10 = vcombine_u64(vld1_u64(&state[10]), zero);
+    v11 = vcombine_u64(vld1_u64(&state[11]), zero);
+    v12 = vcombine_u64(vld1_u64(&state[12]), zero);
+    v13 = vcombine_u64(vld1_u64(&state[13]), zero);
+    v14 = vcombine_u64(vld1_u64(&state[14]), zero);
+    v15 = vcombine_u64(vld1_u64(&state[15]), zero);
+    v16 = vcombine_u64(vld1_u64(&state[16]), zero);
+    v17 = vcombine_u64(vld1_u64(&state[17]), zero);
+    v18 = vcombine_u64(vld1_u64(&state[18]), zero);
+    v19 = vcombine_u64(vld1_u64(&state[19]), zero);
+    v20 = vcombine_u64(vld1_u64(&state[20]), zero);
+    v21 = vcombine_u64(vld1_u64(&state[21]), zero);
+    v22 = vcombine_u64(vld1_u64(&state[22]), zero);
+    v23 = vcombine_u64(vld1_u64(&state[23]), zero);
+    v24 = vcombine_u64(vld1_u64(&state[24]), zero);
+
+    for (round = 0; round < NROUNDS; ++round) {
+        SHA3_ROUND(rc[round]);
+    }
+
+    vst1_u64(&state[0], vget_low_u64(v0));
+    vst1_u64(&state[1], vget_low_u64(v1));
+    vst1_u64(&state[2], vget_low_u64(v2));
+    vst1_u64(&state[3], vget_low_u64(v3));
+    vst1_u64(&state[4], vget_low_u64(v4));
+    vst1_u64(&state[5], vget_low_u64(v5));
+    vst1_u64(&state[6], vget_low_u64(v6));
+    vst1_u64(&state[7], vget_low_u64(v7));
+    vst1_u64(&state[8], vget_low_u64(v8));
+    vst1_u64(&state[9], vget_low_u64(v9));
+    vst1_u64(&state[10], vget_low_u64(v10));
+    vst1_u64(&state[11], vget_low_u64(v11));
+    vst1_u64(&state[12], vget_low_u64(v12));
+    vst1_u64(&state[13], vget_low_u64(v13));
+    vst1_u64(&state[14], vget_low_u64(v14));
+    vst1_u64(&state[15], vget_low_u64(v15));
+    vst1_u64(&state[16], vget_low_u64(v16));
+    vst1_u64(&state[17], vget_low_u64(v17));
+    vst1_u64(&state[18], vget_low_u64(v18));
+    vst1_u64(&state[19], vget_low_u64(v19));
+    vst1_u64(&state[20], vget_low_u64(v20));
+    vst1_u64(&state[21], vget_low_u64(v21));
+    vst1_u64(&state[22], vget_low_u64(v22));
+    vst1_u64(&state[23], vget_low_u64(v23));
+    vst1_u64(&state[24], vget_low_u64(v24));
+}
+
+#if !defined(__ARM_FEATURE_SHA3) && defined(__clang__)
+#pragma clang attribute pop
+#endif
+
+#endif
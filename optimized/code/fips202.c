@@ -5,9 +5,13 @@
 
 #include <stddef.h>
 #include <stdint.h>
-#include <arm_neon.h>
+#include <string.h>
 #include "fips202.h"
+#include "cpu.h"
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
 #include <arm_acle.h>  // Necessário para utilizar instruções intrínsecas SHA-3
+#endif
 
 #define NROUNDS 24
 #define ROL(a, offset) ((a << offset) ^ (a >> (64-offset)))
@@ -22,6 +26,13 @@
 * Returns the loaded 64-bit unsigned integer
 **************************************************/
 static uint64_t load64(const uint8_t x[8]) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  // Em little-endian a faixa já está na ordem certa: uma única carga
+  uint64_t r;
+
+  memcpy(&r, x, 8);
+  return r;
+#else
   unsigned int i;
   uint64_t r = 0;
 
@@ -29,6 +40,7 @@ static uint64_t load64(const uint8_t x[8]) {
     r |= (uint64_t)x[i] << 8*i;
 
   return r;
+#endif
 }
 
 /*************************************************
@@ -83,21 +95,213 @@ extern void f1600(uint64_t *, const uint64_t *);
 }
 #endif
 
+#if !defined(KECCAK_SHA3_STATIC)
+/* Duas rodadas, A -> E -> A, com as constantes round e round+1. A macro
+ * é expandida 12 vezes em KeccakF1600_StatePermute_generic: o desenrolar
+ * completo tira o laço e os índices das constantes do caminho crítico e
+ * deixa o escalonador misturar o fim de uma rodada com o início da
+ * próxima, o que mais ajuda nos núcleos em ordem (Cortex-A53/A55). */
+#define KECCAK_2ROUNDS(round) do {                                      \
+    /* prepareTheta */                                                  \
+    BCa = Aba^Aga^Aka^Ama^Asa;                                          \
+    BCe = Abe^Age^Ake^Ame^Ase;                                          \
+    BCi = Abi^Agi^Aki^Ami^Asi;                                          \
+    BCo = Abo^Ago^Ako^Amo^Aso;                                          \
+    BCu = Abu^Agu^Aku^Amu^Asu;                                          \
+                                                                        \
+    /* thetaRhoPiChiIotaPrepareTheta(round, A, E) */                    \
+    Da = BCu^ROL(BCe, 1);                                               \
+    De = BCa^ROL(BCi, 1);                                               \
+    Di = BCe^ROL(BCo, 1);                                               \
+    Do = BCi^ROL(BCu, 1);                                               \
+    Du = BCo^ROL(BCa, 1);                                               \
+                                                                        \
+    Aba ^= Da;                                                          \
+    BCa = Aba;                                                          \
+    Age ^= De;                                                          \
+    BCe = ROL(Age, 44);                                                 \
+    Aki ^= Di;                                                          \
+    BCi = ROL(Aki, 43);                                                 \
+    Amo ^= Do;                                                          \
+    BCo = ROL(Amo, 21);                                                 \
+    Asu ^= Du;                                                          \
+    BCu = ROL(Asu, 14);                                                 \
+    Eba =   BCa ^((~BCe)&  BCi );                                       \
+    Eba ^= (uint64_t)KeccakF_RoundConstants[(round)];                   \
+    Ebe =   BCe ^((~BCi)&  BCo );                                       \
+    Ebi =   BCi ^((~BCo)&  BCu );                                       \
+    Ebo =   BCo ^((~BCu)&  BCa );                                       \
+    Ebu =   BCu ^((~BCa)&  BCe );                                       \
+                                                                        \
+    /* Bloco 2 */                                                       \
+    Abo ^= Do;                                                          \
+    BCa = ROL(Abo, 28);                                                 \
+    Agu ^= Du;                                                          \
+    BCe = ROL(Agu, 20);                                                 \
+    Aka ^= Da;                                                          \
+    BCi = ROL(Aka,  3);                                                 \
+    Ame ^= De;                                                          \
+    BCo = ROL(Ame, 45);                                                 \
+    Asi ^= Di;                                                          \
+    BCu = ROL(Asi, 61);                                                 \
+    Ega =   BCa ^((~BCe)&  BCi );                                       \
+    Ege =   BCe ^((~BCi)&  BCo );                                       \
+    Egi =   BCi ^((~BCo)&  BCu );                                       \
+    Ego =   BCo ^((~BCu)&  BCa );                                       \
+    Egu =   BCu ^((~BCa)&  BCe );                                       \
+                                                                        \
+    Abe ^= De;                                                          \
+    BCa = ROL(Abe,  1);                                                 \
+    Agi ^= Di;                                                          \
+    BCe = ROL(Agi,  6);                                                 \
+    Ako ^= Do;                                                          \
+    BCi = ROL(Ako, 25);                                                 \
+    Amu ^= Du;                                                          \
+    BCo = ROL(Amu,  8);                                                 \
+    Asa ^= Da;                                                          \
+    BCu = ROL(Asa, 18);                                                 \
+    Eka =   BCa ^((~BCe)&  BCi );                                       \
+    Eke =   BCe ^((~BCi)&  BCo );                                       \
+    Eki =   BCi ^((~BCo)&  BCu );                                       \
+    Eko =   BCo ^((~BCu)&  BCa );                                       \
+    Eku =   BCu ^((~BCa)&  BCe );                                       \
+                                                                        \
+    Abu ^= Du;                                                          \
+    BCa = ROL(Abu, 27);                                                 \
+    Aga ^= Da;                                                          \
+    BCe = ROL(Aga, 36);                                                 \
+    Ake ^= De;                                                          \
+    BCi = ROL(Ake, 10);                                                 \
+    Ami ^= Di;                                                          \
+    BCo = ROL(Ami, 15);                                                 \
+    Aso ^= Do;                                                          \
+    BCu = ROL(Aso, 56);                                                 \
+    Ema =   BCa ^((~BCe)&  BCi );                                       \
+    Eme =   BCe ^((~BCi)&  BCo );                                       \
+    Emi =   BCi ^((~BCo)&  BCu );                                       \
+    Emo =   BCo ^((~BCu)&  BCa );                                       \
+    Emu =   BCu ^((~BCa)&  BCe );                                       \
+                                                                        \
+    Abi ^= Di;                                                          \
+    BCa = ROL(Abi, 62);                                                 \
+    Ago ^= Do;                                                          \
+    BCe = ROL(Ago, 55);                                                 \
+    Aku ^= Du;                                                          \
+    BCi = ROL(Aku, 39);                                                 \
+    Ama ^= Da;                                                          \
+    BCo = ROL(Ama, 41);                                                 \
+    Ase ^= De;                                                          \
+    BCu = ROL(Ase,  2);                                                 \
+    Esa =   BCa ^((~BCe)&  BCi );                                       \
+    Ese =   BCe ^((~BCi)&  BCo );                                       \
+    Esi =   BCi ^((~BCo)&  BCu );                                       \
+    Eso =   BCo ^((~BCu)&  BCa );                                       \
+    Esu =   BCu ^((~BCa)&  BCe );                                       \
+                                                                        \
+    /* prepareTheta */                                                  \
+    BCa = Eba^Ega^Eka^Ema^Esa;                                          \
+    BCe = Ebe^Ege^Eke^Eme^Ese;                                          \
+    BCi = Ebi^Egi^Eki^Emi^Esi;                                          \
+    BCo = Ebo^Ego^Eko^Emo^Eso;                                          \
+    BCu = Ebu^Egu^Eku^Emu^Esu;                                          \
+                                                                        \
+    /* thetaRhoPiChiIotaPrepareTheta(round+1, E, A) */                  \
+    Da = BCu^ROL(BCe, 1);                                               \
+    De = BCa^ROL(BCi, 1);                                               \
+    Di = BCe^ROL(BCo, 1);                                               \
+    Do = BCi^ROL(BCu, 1);                                               \
+    Du = BCo^ROL(BCa, 1);                                               \
+                                                                        \
+    Eba ^= Da;                                                          \
+    BCa = Eba;                                                          \
+    Ege ^= De;                                                          \
+    BCe = ROL(Ege, 44);                                                 \
+    Eki ^= Di;                                                          \
+    BCi = ROL(Eki, 43);                                                 \
+    Emo ^= Do;                                                          \
+    BCo = ROL(Emo, 21);                                                 \
+    Esu ^= Du;                                                          \
+    BCu = ROL(Esu, 14);                                                 \
+    Aba =   BCa ^((~BCe)&  BCi );                                       \
+    Aba ^= (uint64_t)KeccakF_RoundConstants[(round)+1];                 \
+    Abe =   BCe ^((~BCi)&  BCo );                                       \
+    Abi =   BCi ^((~BCo)&  BCu );                                       \
+    Abo =   BCo ^((~BCu)&  BCa );                                       \
+    Abu =   BCu ^((~BCa)&  BCe );                                       \
+                                                                        \
+    Ebo ^= Do;                                                          \
+    BCa = ROL(Ebo, 28);                                                 \
+    Egu ^= Du;                                                          \
+    BCe = ROL(Egu, 20);                                                 \
+    Eka ^= Da;                                                          \
+    BCi = ROL(Eka, 3);                                                  \
+    Eme ^= De;                                                          \
+    BCo = ROL(Eme, 45);                                                 \
+    Esi ^= Di;                                                          \
+    BCu = ROL(Esi, 61);                                                 \
+    Aga =   BCa ^((~BCe)&  BCi );                                       \
+    Age =   BCe ^((~BCi)&  BCo );                                       \
+    Agi =   BCi ^((~BCo)&  BCu );                                       \
+    Ago =   BCo ^((~BCu)&  BCa );                                       \
+    Agu =   BCu ^((~BCa)&  BCe );                                       \
+                                                                        \
+    Ebe ^= De;                                                          \
+    BCa = ROL(Ebe, 1);                                                  \
+    Egi ^= Di;                                                          \
+    BCe = ROL(Egi, 6);                                                  \
+    Eko ^= Do;                                                          \
+    BCi = ROL(Eko, 25);                                                 \
+    Emu ^= Du;                                                          \
+    BCo = ROL(Emu, 8);                                                  \
+    Esa ^= Da;                                                          \
+    BCu = ROL(Esa, 18);                                                 \
+    Aka =   BCa ^((~BCe)&  BCi );                                       \
+    Ake =   BCe ^((~BCi)&  BCo );                                       \
+    Aki =   BCi ^((~BCo)&  BCu );                                       \
+    Ako =   BCo ^((~BCu)&  BCa );                                       \
+    Aku =   BCu ^((~BCa)&  BCe );                                       \
+                                                                        \
+    Ebu ^= Du;                                                          \
+    BCa = ROL(Ebu, 27);                                                 \
+    Ega ^= Da;                                                          \
+    BCe = ROL(Ega, 36);                                                 \
+    Eke ^= De;                                                          \
+    BCi = ROL(Eke, 10);                                                 \
+    Emi ^= Di;                                                          \
+    BCo = ROL(Emi, 15);                                                 \
+    Eso ^= Do;                                                          \
+    BCu = ROL(Eso, 56);                                                 \
+    Ama =   BCa ^((~BCe)&  BCi );                                       \
+    Ame =   BCe ^((~BCi)&  BCo );                                       \
+    Ami =   BCi ^((~BCo)&  BCu );                                       \
+    Amo =   BCo ^((~BCu)&  BCa );                                       \
+    Amu =   BCu ^((~BCa)&  BCe );                                       \
+                                                                        \
+    Ebi ^= Di;                                                          \
+    BCa = ROL(Ebi, 62);                                                 \
+    Ego ^= Do;                                                          \
+    BCe = ROL(Ego, 55);                                                 \
+    Eku ^= Du;                                                          \
+    BCi = ROL(Eku, 39);                                                 \
+    Ema ^= Da;                                                          \
+    BCo = ROL(Ema, 41);                                                 \
+    Ese ^= De;                                                          \
+    BCu = ROL(Ese, 2);                                                  \
+    Asa =   BCa ^((~BCe)&  BCi );                                       \
+    Ase =   BCe ^((~BCi)&  BCo );                                       \
+    Asi =   BCi ^((~BCo)&  BCu );                                       \
+    Aso =   BCo ^((~BCu)&  BCa );                                       \
+    Asu =   BCu ^((~BCa)&  BCe );                                       \
+} while(0)
+
 /*************************************************
-* Name:        KeccakF1600_StatePermute
+* Name:        KeccakF1600_StatePermute_generic
 *
-* Description: The Keccak F1600 Permutation
+* Description: The Keccak F1600 Permutation on general-purpose registers
 *
 * Arguments:   - uint64_t *state: pointer to input/output Keccak state
 **************************************************/
-static void KeccakF1600_StatePermute(uint64_t state[25]) {
-#if (__APPLE__ && __ARM_FEATURE_CRYPTO) || (__ARM_FEATURE_SHA3)
-    (void)KeccakF_RoundConstants;
-    f1600(state, KeccakF_RoundConstants);
-#else
-
-        int round;
-
+static void KeccakF1600_StatePermute_generic(uint64_t state[25]) {
         uint64_t Aba, Abe, Abi, Abo, Abu;
         uint64_t Aga, Age, Agi, Ago, Agu;
         uint64_t Aka, Ake, Aki, Ako, Aku;
@@ -138,201 +342,18 @@ static void KeccakF1600_StatePermute(uint64_t state[25]) {
         Aso = state[23];
         Asu = state[24];
 
-        for(round = 0; round < NROUNDS; round += 2) {            
-            
-            //    prepareTheta            
-            BCa = Aba^Aga^Aka^Ama^Asa;
-            BCe = Abe^Age^Ake^Ame^Ase;
-            BCi = Abi^Agi^Aki^Ami^Asi;
-            BCo = Abo^Ago^Ako^Amo^Aso;
-            BCu = Abu^Agu^Aku^Amu^Asu;
-            
-            //thetaRhoPiChiIotaPrepareTheta(round, A, E)            
-            Da = BCu^ROL(BCe, 1);
-            De = BCa^ROL(BCi, 1);
-            Di = BCe^ROL(BCo, 1);
-            Do = BCi^ROL(BCu, 1);
-            Du = BCo^ROL(BCa, 1);     
-          
-
-            Aba ^= Da;
-            BCa = Aba;
-            Age ^= De;
-            BCe = ROL(Age, 44);
-            Aki ^= Di;
-            BCi = ROL(Aki, 43);
-            Amo ^= Do;
-            BCo = ROL(Amo, 21);
-            Asu ^= Du;
-            BCu = ROL(Asu, 14);
-            Eba =   BCa ^((~BCe)&  BCi );
-            Eba ^= (uint64_t)KeccakF_RoundConstants[round];
-            Ebe =   BCe ^((~BCi)&  BCo );
-            Ebi =   BCi ^((~BCo)&  BCu );
-            Ebo =   BCo ^((~BCu)&  BCa );
-            Ebu =   BCu ^((~BCa)&  BCe );
-            
-        
-          // Bloco 2
-            Abo ^= Do;
-            BCa = ROL(Abo, 28);
-            Agu ^= Du;
-            BCe = ROL(Agu, 20);
-            Aka ^= Da;
-            BCi = ROL(Aka,  3);
-            Ame ^= De;
-            BCo = ROL(Ame, 45);
-            Asi ^= Di;
-            BCu = ROL(Asi, 61);
-            Ega =   BCa ^((~BCe)&  BCi );
-            Ege =   BCe ^((~BCi)&  BCo );
-            Egi =   BCi ^((~BCo)&  BCu );
-            Ego =   BCo ^((~BCu)&  BCa );
-            Egu =   BCu ^((~BCa)&  BCe );
-
-            Abe ^= De;
-            BCa = ROL(Abe,  1);
-            Agi ^= Di;
-            BCe = ROL(Agi,  6);
-            Ako ^= Do;
-            BCi = ROL(Ako, 25);
-            Amu ^= Du;
-            BCo = ROL(Amu,  8);
-            Asa ^= Da;
-            BCu = ROL(Asa, 18);
-            Eka =   BCa ^((~BCe)&  BCi );
-            Eke =   BCe ^((~BCi)&  BCo );
-            Eki =   BCi ^((~BCo)&  BCu );
-            Eko =   BCo ^((~BCu)&  BCa );
-            Eku =   BCu ^((~BCa)&  BCe );
-
-            Abu ^= Du;
-            BCa = ROL(Abu, 27);
-            Aga ^= Da;
-            BCe = ROL(Aga, 36);
-            Ake ^= De;
-            BCi = ROL(Ake, 10);
-            Ami ^= Di;
-            BCo = ROL(Ami, 15);
-            Aso ^= Do;
-            BCu = ROL(Aso, 56);
-            Ema =   BCa ^((~BCe)&  BCi );
-            Eme =   BCe ^((~BCi)&  BCo );
-            Emi =   BCi ^((~BCo)&  BCu );
-            Emo =   BCo ^((~BCu)&  BCa );
-            Emu =   BCu ^((~BCa)&  BCe );
-
-            Abi ^= Di;
-            BCa = ROL(Abi, 62);
-            Ago ^= Do;
-            BCe = ROL(Ago, 55);
-            Aku ^= Du;
-            BCi = ROL(Aku, 39);
-            Ama ^= Da;
-            BCo = ROL(Ama, 41);
-            Ase ^= De;
-            BCu = ROL(Ase,  2);
-            Esa =   BCa ^((~BCe)&  BCi );
-            Ese =   BCe ^((~BCi)&  BCo );
-            Esi =   BCi ^((~BCo)&  BCu );
-            Eso =   BCo ^((~BCu)&  BCa );
-            Esu =   BCu ^((~BCa)&  BCe );
-
-            //    prepareTheta
-            BCa = Eba^Ega^Eka^Ema^Esa;
-            BCe = Ebe^Ege^Eke^Eme^Ese;
-            BCi = Ebi^Egi^Eki^Emi^Esi;
-            BCo = Ebo^Ego^Eko^Emo^Eso;
-            BCu = Ebu^Egu^Eku^Emu^Esu;
-
-            //thetaRhoPiChiIotaPrepareTheta(round+1, E, A)
-            Da = BCu^ROL(BCe, 1);
-            De = BCa^ROL(BCi, 1);
-            Di = BCe^ROL(BCo, 1);
-            Do = BCi^ROL(BCu, 1);
-            Du = BCo^ROL(BCa, 1);
-
-            Eba ^= Da;
-            BCa = Eba;
-            Ege ^= De;
-            BCe = ROL(Ege, 44);
-            Eki ^= Di;
-            BCi = ROL(Eki, 43);
-            Emo ^= Do;
-            BCo = ROL(Emo, 21);
-            Esu ^= Du;
-            BCu = ROL(Esu, 14);
-            Aba =   BCa ^((~BCe)&  BCi );
-            Aba ^= (uint64_t)KeccakF_RoundConstants[round+1];
-            Abe =   BCe ^((~BCi)&  BCo );
-            Abi =   BCi ^((~BCo)&  BCu );
-            Abo =   BCo ^((~BCu)&  BCa );
-            Abu =   BCu ^((~BCa)&  BCe );
-
-            Ebo ^= Do;
-            BCa = ROL(Ebo, 28);
-            Egu ^= Du;
-            BCe = ROL(Egu, 20);
-            Eka ^= Da;
-            BCi = ROL(Eka, 3);
-            Eme ^= De;
-            BCo = ROL(Eme, 45);
-            Esi ^= Di;
-            BCu = ROL(Esi, 61);
-            Aga =   BCa ^((~BCe)&  BCi );
-            Age =   BCe ^((~BCi)&  BCo );
-            Agi =   BCi ^((~BCo)&  BCu );
-            Ago =   BCo ^((~BCu)&  BCa );
-            Agu =   BCu ^((~BCa)&  BCe );
-
-            Ebe ^= De;
-            BCa = ROL(Ebe, 1);
-            Egi ^= Di;
-            BCe = ROL(Egi, 6);
-            Eko ^= Do;
-            BCi = ROL(Eko, 25);
-            Emu ^= Du;
-            BCo = ROL(Emu, 8);
-            Esa ^= Da;
-            BCu = ROL(Esa, 18);
-            Aka =   BCa ^((~BCe)&  BCi );
-            Ake =   BCe ^((~BCi)&  BCo );
-            Aki =   BCi ^((~BCo)&  BCu );
-            Ako =   BCo ^((~BCu)&  BCa );
-            Aku =   BCu ^((~BCa)&  BCe );
-
-            Ebu ^= Du;
-            BCa = ROL(Ebu, 27);
-            Ega ^= Da;
-            BCe = ROL(Ega, 36);
-            Eke ^= De;
-            BCi = ROL(Eke, 10);
-            Emi ^= Di;
-            BCo = ROL(Emi, 15);
-            Eso ^= Do;
-            BCu = ROL(Eso, 56);
-            Ama =   BCa ^((~BCe)&  BCi );
-            Ame =   BCe ^((~BCi)&  BCo );
-            Ami =   BCi ^((~BCo)&  BCu );
-            Amo =   BCo ^((~BCu)&  BCa );
-            Amu =   BCu ^((~BCa)&  BCe );
-
-            Ebi ^= Di;
-            BCa = ROL(Ebi, 62);
-            Ego ^= Do;
-            BCe = ROL(Ego, 55);
-            Eku ^= Du;
-            BCi = ROL(Eku, 39);
-            Ema ^= Da;
-            BCo = ROL(Ema, 41);
-            Ese ^= De;
-            BCu = ROL(Ese, 2);
-            Asa =   BCa ^((~BCe)&  BCi );
-            Ase =   BCe ^((~BCi)&  BCo );
-            Asi =   BCi ^((~BCo)&  BCu );
-            Aso =   BCo ^((~BCu)&  BCa );
-            Asu =   BCu ^((~BCa)&  BCe );
-        }
+        KECCAK_2ROUNDS(0);
+        KECCAK_2ROUNDS(2);
+        KECCAK_2ROUNDS(4);
+        KECCAK_2ROUNDS(6);
+        KECCAK_2ROUNDS(8);
+        KECCAK_2ROUNDS(10);
+        KECCAK_2ROUNDS(12);
+        KECCAK_2ROUNDS(14);
+        KECCAK_2ROUNDS(16);
+        KECCAK_2ROUNDS(18);
+        KECCAK_2ROUNDS(20);
+        KECCAK_2ROUNDS(22);
 
         //copyToState(state, A)
         state[ 0] = Aba;
@@ -360,7 +381,43 @@ static void KeccakF1600_StatePermute(uint64_t state[25]) {
         state[22] = Asi;
         state[23] = Aso;
         state[24] = Asu;
-  #endif
+}
+#endif
+
+#if defined(KECCAK_SHA3_DISPATCH)
+
+static void KeccakF1600_StatePermute_sha3(uint64_t state[25]) {
+    f1600(state, KeccakF_RoundConstants);
+}
+
+static void (*KeccakF1600_StatePermute_impl)(uint64_t state[25]) =
+    KeccakF1600_StatePermute_generic;
+
+// Escolhe a permutação uma única vez, ao carregar o binário/biblioteca
+__attribute__((constructor))
+static void KeccakF1600_StatePermute_dispatch(void) {
+    if(dilithium_cpu_features() & CPU_FEATURE_SHA3)
+        KeccakF1600_StatePermute_impl = KeccakF1600_StatePermute_sha3;
+}
+#endif
+
+/*************************************************
+* Name:        KeccakF1600_StatePermute
+*
+* Description: The Keccak F1600 Permutation. Uses the SHA3 extension when it
+*              is guaranteed at compile time or, with
+*              DILITHIUM_RUNTIME_DISPATCH, present on the running core.
+*
+* Arguments:   - uint64_t *state: pointer to input/output Keccak state
+**************************************************/
+static void KeccakF1600_StatePermute(uint64_t state[25]) {
+#if defined(KECCAK_SHA3_STATIC)
+    f1600(state, KeccakF_RoundConstants);
+#elif defined(KECCAK_SHA3_DISPATCH)
+    KeccakF1600_StatePermute_impl(state);
+#else
+    KeccakF1600_StatePermute_generic(state);
+#endif
 }
 
 /*************************************************
@@ -377,6 +434,67 @@ static void keccak_init(uint64_t s[25])
     s[i] = 0;
 }
 
+/*************************************************
+* Name:        keccak_xorbytes
+*
+* Description: XOR len bytes of input into the state starting at byte
+*              offset pos. Bytes are handled one by one only up to the next
+*              lane boundary and after the last whole lane; everything in
+*              between goes in as 16-byte NEON loads (two lanes) and at
+*              most one 8-byte lane.
+*
+* Arguments:   - uint64_t *s: pointer to Keccak state
+*              - unsigned int pos: byte offset in the state
+*              - const uint8_t *in: pointer to input
+*              - size_t len: number of bytes, pos + len <= 200
+**************************************************/
+static void keccak_xorbytes(uint64_t s[25],
+                            unsigned int pos,
+                            const uint8_t *in,
+                            size_t len)
+{
+  // Bytes até a próxima fronteira de faixa
+  while(len && pos%8) {
+    s[pos/8] ^= (uint64_t)*in++ << 8*(pos%8);
+    pos++;
+    len--;
+  }
+
+#if defined(__ARM_NEON)
+  // Duas faixas por vez (vld1q_u8 aceita entrada desalinhada)
+  while(len >= 16) {
+    uint64x2_t t = vld1q_u64(&s[pos/8]);
+    t = veorq_u64(t, vreinterpretq_u64_u8(vld1q_u8(in)));
+    vst1q_u64(&s[pos/8], t);
+    in += 16;
+    pos += 16;
+    len -= 16;
+  }
+
+  if(len >= 8) {
+    s[pos/8] ^= vget_lane_u64(vreinterpret_u64_u8(vld1_u8(in)), 0);
+    in += 8;
+    pos += 8;
+    len -= 8;
+  }
+#else
+  // Sem NEON: uma faixa por vez, com load64 (correta em qualquer ordem de
+  // bytes do hospedeiro, e uma única carga em little-endian)
+  while(len >= 8) {
+    s[pos/8] ^= load64(in);
+    in += 8;
+    pos += 8;
+    len -= 8;
+  }
+#endif
+
+  while(len) {
+    s[pos/8] ^= (uint64_t)*in++ << 8*(pos%8);
+    pos++;
+    len--;
+  }
+}
+
 /*************************************************
 * Name:        keccak_absorb
 *
@@ -396,20 +514,17 @@ static unsigned int keccak_absorb(uint64_t s[25],
                                   const uint8_t *in,
                                   size_t inlen)
 {
-  unsigned int i;
-
   while(pos+inlen >= r) {
-    for(i=pos;i<r;i++)
-      s[i/8] ^= (uint64_t)*in++ << 8*(i%8);
+    keccak_xorbytes(s, pos, in, r-pos);
+    in += r-pos;
     inlen -= r-pos;
     KeccakF1600_StatePermute(s);
     pos = 0;
   }
 
-  for(i=pos;i<pos+inlen;i++)
-    s[i/8] ^= (uint64_t)*in++ << 8*(i%8);
+  keccak_xorbytes(s, pos, in, inlen);
 
-  return i;
+  return pos+inlen;
 }
 
 /*************************************************
@@ -478,8 +593,12 @@ static unsigned int keccak_squeeze(uint8_t *out, size_t outlen, uint64_t s[25],
 
     // Processar blocos de 8 bytes por vez usando NEON, quando possível
     while (pos + 8 <= r && outlen >= 8) {
+#if defined(__ARM_NEON)
       uint64x1_t data = vld1_u64(&s[pos / 8]); // Carregar um bloco de 8 bytes
       vst1_u8(out, vreinterpret_u8_u64(data)); // Escrever 8 bytes
+#else
+      store64(out, s[pos / 8]);
+#endif
       out += 8;
       outlen -= 8;
       pos += 8;
@@ -523,17 +642,15 @@ static void keccak_absorb_once(uint64_t s[25],
     s[i] = 0;
 
   while(inlen >= r) {
-    for(i=0;i<r/8;i++)
-      s[i] ^= load64(in+8*i);
+    keccak_xorbytes(s, 0, in, r);
     in += r;
     inlen -= r;
     KeccakF1600_StatePermute(s);
   }
 
-  for(i=0;i<inlen;i++)
-    s[i/8] ^= (uint64_t)in[i] << 8*(i%8);
+  keccak_xorbytes(s, 0, in, inlen);
 
-  s[i/8] ^= (uint64_t)p << 8*(i%8);
+  s[inlen/8] ^= (uint64_t)p << 8*(inlen%8);
   s[(r-1)/8] ^= 1ULL << 63;
 }
 
@@ -566,6 +683,26 @@ static void keccak_squeezeblocks(uint8_t *out,
   }
 }
 
+/*************************************************
+* Name:        keccak_clone
+*
+* Description: Copy a Keccak state, 16 bytes (two lanes) at a time.
+*
+* Arguments:   - uint64_t *dst: pointer to output Keccak state
+*              - const uint64_t *src: pointer to input Keccak state
+**************************************************/
+static void keccak_clone(uint64_t dst[25], const uint64_t src[25])
+{
+#if defined(__ARM_NEON)
+  unsigned int i;
+  for(i=0;i<24;i+=2)
+    vst1q_u64(&dst[i], vld1q_u64(&src[i]));
+  dst[24] = src[24];
+#else
+  memcpy(dst, src, 25*sizeof(uint64_t));
+#endif
+}
+
 /*************************************************
 * Name:        shake128_init
 *
@@ -653,6 +790,22 @@ void shake128_squeezeblocks(uint8_t *out, size_t nblocks, keccak_state *state)
   keccak_squeezeblocks(out, nblocks, state->s, SHAKE128_RATE);
 }
 
+/*************************************************
+* Name:        shake128_clone
+*
+* Description: Snapshot of a SHAKE128 state in any phase, including the
+*              position in the current block. Lets a common prefix be
+*              absorbed once and then continued for several inputs.
+*
+* Arguments:   - keccak_state *dst: pointer to output Keccak state
+*              - const keccak_state *src: pointer to input Keccak state
+**************************************************/
+void shake128_clone(keccak_state *dst, const keccak_state *src)
+{
+  keccak_clone(dst->s, src->s);
+  dst->pos = src->pos;
+}
+
 /*************************************************
 * Name:        shake256_init
 *
@@ -740,6 +893,22 @@ void shake256_squeezeblocks(uint8_t *out, size_t nblocks, keccak_state *state)
   keccak_squeezeblocks(out, nblocks, state->s, SHAKE256_RATE);
 }
 
+/*************************************************
+* Name:        shake256_clone
+*
+* Description: Snapshot of a SHAKE256 state in any phase, including the
+*              position in the current block. Lets a common prefix be
+*              absorbed once and then continued for several inputs.
+*
+* Arguments:   - keccak_state *dst: pointer to output Keccak state
+*              - const keccak_state *src: pointer to input Keccak state
+**************************************************/
+void shake256_clone(keccak_state *dst, const keccak_state *src)
+{
+  keccak_clone(dst->s, src->s);
+  dst->pos = src->pos;
+}
+
 /*************************************************
 * Name:        shake128
 *
@@ -31,6 +31,8 @@ void shake128_squeeze(uint8_t *out, size_t outlen, keccak_state *state);
 void shake128_absorb_once(keccak_state *state, const uint8_t *in, size_t inlen);
 #define shake128_squeezeblocks FIPS202_NAMESPACE(shake128_squeezeblocks)
 void shake128_squeezeblocks(uint8_t *out, size_t nblocks, keccak_state *state);
+#define shake128_clone FIPS202_NAMESPACE(shake128_clone)
+void shake128_clone(keccak_state *dst, const keccak_state *src);
 
 #define shake256_init FIPS202_NAMESPACE(shake256_init)
 void shake256_init(keccak_state *state);
@@ -44,6 +46,8 @@ void shake256_squeeze(uint8_t *out, size_t outlen, keccak_state *state);
 void shake256_absorb_once(keccak_state *state, const uint8_t *in, size_t inlen);
 #define shake256_squeezeblocks FIPS202_NAMESPACE(shake256_squeezeblocks)
 void shake256_squeezeblocks(uint8_t *out, size_t nblocks,  keccak_state *state);
+#define shake256_clone FIPS202_NAMESPACE(shake256_clone)
+void shake256_clone(keccak_state *dst, const keccak_state *src);
 
 #define shake128 FIPS202_NAMESPACE(shake128)
 void shake128(uint8_t *out, size_t outlen, const uint8_t *in, size_t inlen);
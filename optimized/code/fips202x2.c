@@ -1,6 +1,7 @@
 #include <arm_neon.h>
 #include <stddef.h>
 #include "fips202x2.h"
+#include "cpu.h"
 
 #include <string.h>
 #include <stdint.h>
@@ -83,11 +84,9 @@ extern void f1600x2(v128 *, const uint64_t *);
 }
 #endif
 
+#if !defined(KECCAK_SHA3_STATIC)
 static inline
-void KeccakF1600_StatePermutex2(v128 state[25]) {
-    #if (__APPLE__ && __ARM_FEATURE_CRYPTO) || (__ARM_FEATURE_SHA3) /* although not sure what is being implemented, we find something fast */
-    f1600x2(state, neon_KeccakF_RoundConstants);
-    #else
+void KeccakF1600_StatePermutex2_neon(v128 state[25]) {
     v128 Aba, Abe, Abi, Abo, Abu;
     v128 Aga, Age, Agi, Ago, Agu;
     v128 Aka, Ake, Aki, Ako, Aku;
@@ -355,98 +354,38 @@ void KeccakF1600_StatePermutex2(v128 state[25]) {
     state[22] = Asi;
     state[23] = Aso;
     state[24] = Asu;
-    #endif
 }
+#endif
 
+#if defined(KECCAK_SHA3_DISPATCH)
+static void KeccakF1600_StatePermutex2_generic(v128 state[25]) {
+    KeccakF1600_StatePermutex2_neon(state);
+}
 
-/*************************************************
-* Name:        keccakx2_absorb_once (Introduzida por mim)
-*
-* Description: Absorb step of Keccak;
-*              non-incremental, starts by zeroeing the state.
-*             This function is implemented in assembly.
-* Arguments:   - uint64_t *s: pointer to (uninitialized) output Keccak state
-*              - unsigned int r: rate in bytes (e.g., 168 for SHAKE128)
-*              - const uint8_t *m: pointer to input to be absorbed into s
-*              - size_t mlen: length of input in bytes
-*              - uint8_t p: domain-separation byte for different
-*                           Keccak-derived functions
-**************************************************/
-static void keccakx2_absorb_once(uint64x2_t s[25],
-                                 unsigned int r,
-                                 const uint8_t *in0,
-                                 const uint8_t *in1,
-                                 size_t inlen,
-                                 uint8_t p)
-{
-  size_t i;
-  size_t pos = 0;
-  uint64x2_t t;
-
-  // Inicializar o estado com zeros
-  for(i = 0; i < 25; ++i)
-    s[i] = vdupq_n_u64(0);
-
-  // Loop principal de absorção
-  while(inlen >= r) {
-    for(i = 0; i < r / 8; ++i) {
-      uint64_t val0 = *(const uint64_t *)(in0 + pos);
-      uint64_t val1 = *(const uint64_t *)(in1 + pos);
-      t = vcombine_u64(vcreate_u64(val0), vcreate_u64(val1));
-      s[i] = veorq_u64(s[i], t);
-      pos += 8;
-    }
-    inlen -= r;
-    
-    f1600x2(s, neon_KeccakF_RoundConstants);
-  }
-
-  // Processar o restante dos dados
-  if(inlen > 0) {
-    size_t partial_blocks = inlen / 8;
-    for(i = 0; i < partial_blocks; ++i) {
-      uint64_t val0 = *(const uint64_t *)(in0 + pos);
-      uint64_t val1 = *(const uint64_t *)(in1 + pos);
-      t = vcombine_u64(vcreate_u64(val0), vcreate_u64(val1));
-      s[i] = veorq_u64(s[i], t);
-      pos += 8;
-    }
-    inlen -= 8 * partial_blocks;
-
-    // Se ainda houver dados incompletos
-    if(inlen > 0) {
-      uint64_t val0 = 0, val1 = 0;
-      memcpy(&val0, in0 + pos, inlen);
-      memcpy(&val1, in1 + pos, inlen);
-      t = vcombine_u64(vcreate_u64(val0), vcreate_u64(val1));
-
-      uint64_t mask = (1ULL << (8 * inlen)) - 1;
-      uint64x2_t mask_vec = vdupq_n_u64(mask);
-      t = vandq_u64(t, mask_vec);
+static void KeccakF1600_StatePermutex2_sha3(v128 state[25]) {
+    f1600x2(state, neon_KeccakF_RoundConstants);
+}
 
-      s[i] = veorq_u64(s[i], t);
-    }
+static void (*KeccakF1600_StatePermutex2_impl)(v128 state[25]) =
+    KeccakF1600_StatePermutex2_generic;
 
-    // Adicionar padding
-    uint64_t pad = (uint64_t)p << (8 * (pos % 8));
-    uint64x2_t pad_vec = vdupq_n_u64(pad);
-    s[i] = veorq_u64(s[i], pad_vec);
-  } else {
-    // Adicionar padding quando inlen é múltiplo de r
-    uint64_t pad = (uint64_t)p;
-    uint64x2_t pad_vec = vdupq_n_u64(pad);
-    s[0] = veorq_u64(s[0], pad_vec);
-  }
-
-  // Aplicar o bit final
-  uint64_t final_mask = 1ULL << 63;
-  uint64x2_t final_mask_vec = vdupq_n_u64(final_mask);
-  s[(r / 8) - 1] = veorq_u64(s[(r / 8) - 1], final_mask_vec);
+// Escolhe a permutação uma única vez, ao carregar o binário/biblioteca
+__attribute__((constructor))
+static void KeccakF1600_StatePermutex2_dispatch(void) {
+    if(dilithium_cpu_features() & CPU_FEATURE_SHA3)
+        KeccakF1600_StatePermutex2_impl = KeccakF1600_StatePermutex2_sha3;
 }
+#endif
 
-
-void FIPS202X2_NAMESPACE(shake128x2_absorb_once)(keccakx2_state *state, const uint8_t *in0, const uint8_t *in1, size_t inlen) {    
-    keccakx2_absorb_once(state->s, SHAKE128_RATE, in0, in1, inlen, 0x1F);
+static inline
+void KeccakF1600_StatePermutex2(v128 state[25]) {
+    #if defined(KECCAK_SHA3_STATIC)
+    f1600x2(state, neon_KeccakF_RoundConstants);
+    #elif defined(KECCAK_SHA3_DISPATCH)
+    KeccakF1600_StatePermutex2_impl(state);
+    #else
+    KeccakF1600_StatePermutex2_neon(state);
+    #endif
 }
 
 
@@ -543,11 +482,11 @@ void keccakx2_absorb(v128 s[25],
     }
 
     if (inlen) {
-        a = vld1_u64((uint64_t *)&in0[pos]);
-        b = vld1_u64((uint64_t *)&in1[pos]);
-        tmp = vcombine_u64(a, b);
-        mask = vdupq_n_u64((1ULL << (8 * inlen)) - 1);
-        tmp = vandq_u64(tmp, mask);
+        // Últimos bytes: copiar para faixas zeradas em vez de ler além do fim da entrada
+        uint64_t t0 = 0, t1 = 0;
+        memcpy(&t0, &in0[pos], inlen);
+        memcpy(&t1, &in1[pos], inlen);
+        tmp = vcombine_u64(vcreate_u64(t0), vcreate_u64(t1));
         vxor(s[i], s[i], tmp);
     }
 
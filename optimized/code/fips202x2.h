@@ -26,7 +26,11 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#if defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#else
 #include <arm_neon.h>
+#endif
 
 #define SHAKE128_RATE 168
 #define SHAKE256_RATE 136
@@ -36,13 +40,24 @@
 #define REJ_UNIFORM_NBLOCKS ((768+STREAM128_BLOCKBYTES-1)/STREAM128_BLOCKBYTES)
 #define REJ_UNIFORM_BUFLEN (REJ_UNIFORM_NBLOCKS*STREAM128_BLOCKBYTES)
 
+/* Dois estados Keccak intercalados: a faixa i dos dois estados ocupa os
+ * dois elementos de 64 bits de s[i] (NEON ou WebAssembly SIMD128). */
+#if defined(__wasm_simd128__)
+typedef v128_t v128;
+#else
 typedef uint64x2_t v128;
+#endif
 
 typedef struct {
     v128 s[25];
 } keccakx2_state;
 
 
+void FIPS202X2_NAMESPACE(shake128x2_absorb)(keccakx2_state *state,
+                            const uint8_t *in0,
+                            const uint8_t *in1,
+                            size_t inlen);
+
 void FIPS202X2_NAMESPACE(shake128x2_absorb_once)(keccakx2_state *state,
                             const uint8_t *in0,
                             const uint8_t *in1,
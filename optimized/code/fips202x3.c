@@ -0,0 +1,948 @@
+#include <arm_neon.h>
+#include <stddef.h>
+#include "fips202x3.h"
+#include "cpu.h"
+
+#include <string.h>
+#include <stdint.h>
+
+
+#ifdef PROFILE_HASHING
+#include "hal.h"
+extern unsigned long long hash_cycles;
+#endif
+
+#define NROUNDS 24
+
+// Define NEON operation (faixas 0 e 1)
+// c = a ^ b
+#define vxor(c, a, b) c = veorq_u64(a, b);
+// Rotate by n bit ((a << offset) ^ (a >> (64-offset)))
+#define vROL(out, a, offset)    \
+    out = vshlq_n_u64(a, offset); \
+    out = vsriq_n_u64(out, a, 64 - offset);
+// Xor chain: out = a ^ b ^ c ^ d ^ e
+#define vXOR4(out, a, b, c, d, e) \
+    out = veorq_u64(a, b);          \
+    out = veorq_u64(out, c);        \
+    out = veorq_u64(out, d);        \
+    out = veorq_u64(out, e);
+// Xor Not And: out = a ^ ( (~b) & c)
+#define vXNA(out, a, b, c) \
+    out = vbicq_u64(c, b);   \
+    out = veorq_u64(out, a);
+
+// Define scalar operation (faixa 2), mesmas operações nos registradores inteiros
+#define sxor(c, a, b) c = (a) ^ (b);
+#define sROL(out, a, offset) out = ((a) << (offset)) ^ ((a) >> (64 - (offset)));
+#define sXOR4(out, a, b, c, d, e) out = (a) ^ (b) ^ (c) ^ (d) ^ (e);
+#define sXNA(out, a, b, c) out = (a) ^ (~(b) & (c));
+// End Define
+
+/* Keccak round constants */
+static const uint64_t hybrid_KeccakF_RoundConstants[NROUNDS] = {
+    (uint64_t)0x0000000000000001ULL,
+    (uint64_t)0x0000000000008082ULL,
+    (uint64_t)0x800000000000808aULL,
+    (uint64_t)0x8000000080008000ULL,
+    (uint64_t)0x000000000000808bULL,
+    (uint64_t)0x0000000080000001ULL,
+    (uint64_t)0x8000000080008081ULL,
+    (uint64_t)0x8000000000008009ULL,
+    (uint64_t)0x000000000000008aULL,
+    (uint64_t)0x0000000000000088ULL,
+    (uint64_t)0x0000000080008009ULL,
+    (uint64_t)0x000000008000000aULL,
+    (uint64_t)0x000000008000808bULL,
+    (uint64_t)0x800000000000008bULL,
+    (uint64_t)0x8000000000008089ULL,
+    (uint64_t)0x8000000000008003ULL,
+    (uint64_t)0x8000000000008002ULL,
+    (uint64_t)0x8000000000000080ULL,
+    (uint64_t)0x000000000000800aULL,
+    (uint64_t)0x800000008000000aULL,
+    (uint64_t)0x8000000080008081ULL,
+    (uint64_t)0x8000000000008080ULL,
+    (uint64_t)0x0000000080000001ULL,
+    (uint64_t)0x8000000080008008ULL
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+extern void f1600x2(v128 *, const uint64_t *);
+extern void f1600(uint64_t *, const uint64_t *);
+#ifdef __cplusplus
+}
+#endif
+
+/*************************************************
+* Name:        KeccakF1600_StatePermutex3
+*
+* Description: Three Keccak F1600 permutations at once: lanes 0 and 1 run
+*              on NEON as in KeccakF1600_StatePermutex2, lane 2 runs on the
+*              general-purpose registers. Both instruction streams are
+*              interleaved statement by statement so the scalar ALUs work
+*              while the vector pipes are busy.
+*
+* Arguments:   - v128 *state: pointer to input/output NEON state (lanes 0, 1)
+*              - uint64_t *state1: pointer to input/output scalar state (lane 2)
+**************************************************/
+#if !defined(KECCAK_SHA3_STATIC)
+static inline
+void KeccakF1600_StatePermutex3_hybrid(v128 state[25], uint64_t state1[25]) {
+    v128 Aba, Abe, Abi, Abo, Abu;
+    v128 Aga, Age, Agi, Ago, Agu;
+    v128 Aka, Ake, Aki, Ako, Aku;
+    v128 Ama, Ame, Ami, Amo, Amu;
+    v128 Asa, Ase, Asi, Aso, Asu;
+    v128 BCa, BCe, BCi, BCo, BCu; // tmp
+    v128 Da, De, Di, Do, Du;      // D
+    v128 Eba, Ebe, Ebi, Ebo, Ebu;
+    v128 Ega, Ege, Egi, Ego, Egu;
+    v128 Eka, Eke, Eki, Eko, Eku;
+    v128 Ema, Eme, Emi, Emo, Emu;
+    v128 Esa, Ese, Esi, Eso, Esu;
+    uint64_t sAba, sAbe, sAbi, sAbo, sAbu;
+    uint64_t sAga, sAge, sAgi, sAgo, sAgu;
+    uint64_t sAka, sAke, sAki, sAko, sAku;
+    uint64_t sAma, sAme, sAmi, sAmo, sAmu;
+    uint64_t sAsa, sAse, sAsi, sAso, sAsu;
+    uint64_t sBCa, sBCe, sBCi, sBCo, sBCu;
+    uint64_t sDa, sDe, sDi, sDo, sDu;
+    uint64_t sEba, sEbe, sEbi, sEbo, sEbu;
+    uint64_t sEga, sEge, sEgi, sEgo, sEgu;
+    uint64_t sEka, sEke, sEki, sEko, sEku;
+    uint64_t sEma, sEme, sEmi, sEmo, sEmu;
+    uint64_t sEsa, sEse, sEsi, sEso, sEsu;
+
+    //copyFromState(A, state)
+    Aba = state[0];
+    sAba = state1[0];
+    Abe = state[1];
+    sAbe = state1[1];
+    Abi = state[2];
+    sAbi = state1[2];
+    Abo = state[3];
+    sAbo = state1[3];
+    Abu = state[4];
+    sAbu = state1[4];
+    Aga = state[5];
+    sAga = state1[5];
+    Age = state[6];
+    sAge = state1[6];
+    Agi = state[7];
+    sAgi = state1[7];
+    Ago = state[8];
+    sAgo = state1[8];
+    Agu = state[9];
+    sAgu = state1[9];
+    Aka = state[10];
+    sAka = state1[10];
+    Ake = state[11];
+    sAke = state1[11];
+    Aki = state[12];
+    sAki = state1[12];
+    Ako = state[13];
+    sAko = state1[13];
+    Aku = state[14];
+    sAku = state1[14];
+    Ama = state[15];
+    sAma = state1[15];
+    Ame = state[16];
+    sAme = state1[16];
+    Ami = state[17];
+    sAmi = state1[17];
+    Amo = state[18];
+    sAmo = state1[18];
+    Amu = state[19];
+    sAmu = state1[19];
+    Asa = state[20];
+    sAsa = state1[20];
+    Ase = state[21];
+    sAse = state1[21];
+    Asi = state[22];
+    sAsi = state1[22];
+    Aso = state[23];
+    sAso = state1[23];
+    Asu = state[24];
+    sAsu = state1[24];
+
+    for (int round = 0; round < NROUNDS; round += 2) {
+        //    prepareTheta
+        vXOR4(BCa, Aba, Aga, Aka, Ama, Asa);
+        sXOR4(sBCa, sAba, sAga, sAka, sAma, sAsa);
+        vXOR4(BCe, Abe, Age, Ake, Ame, Ase);
+        sXOR4(sBCe, sAbe, sAge, sAke, sAme, sAse);
+        vXOR4(BCi, Abi, Agi, Aki, Ami, Asi);
+        sXOR4(sBCi, sAbi, sAgi, sAki, sAmi, sAsi);
+        vXOR4(BCo, Abo, Ago, Ako, Amo, Aso);
+        sXOR4(sBCo, sAbo, sAgo, sAko, sAmo, sAso);
+        vXOR4(BCu, Abu, Agu, Aku, Amu, Asu);
+        sXOR4(sBCu, sAbu, sAgu, sAku, sAmu, sAsu);
+
+        //thetaRhoPiChiIotaPrepareTheta(round  , A, E)
+        vROL(Da, BCe, 1);
+        sROL(sDa, sBCe, 1);
+        vxor(Da, BCu, Da);
+        sxor(sDa, sBCu, sDa);
+        vROL(De, BCi, 1);
+        sROL(sDe, sBCi, 1);
+        vxor(De, BCa, De);
+        sxor(sDe, sBCa, sDe);
+        vROL(Di, BCo, 1);
+        sROL(sDi, sBCo, 1);
+        vxor(Di, BCe, Di);
+        sxor(sDi, sBCe, sDi);
+        vROL(Do, BCu, 1);
+        sROL(sDo, sBCu, 1);
+        vxor(Do, BCi, Do);
+        sxor(sDo, sBCi, sDo);
+        vROL(Du, BCa, 1);
+        sROL(sDu, sBCa, 1);
+        vxor(Du, BCo, Du);
+        sxor(sDu, sBCo, sDu);
+
+        vxor(Aba, Aba, Da);
+        sxor(sAba, sAba, sDa);
+        vxor(Age, Age, De);
+        sxor(sAge, sAge, sDe);
+        vROL(BCe, Age, 44);
+        sROL(sBCe, sAge, 44);
+        vxor(Aki, Aki, Di);
+        sxor(sAki, sAki, sDi);
+        vROL(BCi, Aki, 43);
+        sROL(sBCi, sAki, 43);
+        vxor(Amo, Amo, Do);
+        sxor(sAmo, sAmo, sDo);
+        vROL(BCo, Amo, 21);
+        sROL(sBCo, sAmo, 21);
+        vxor(Asu, Asu, Du);
+        sxor(sAsu, sAsu, sDu);
+        vROL(BCu, Asu, 14);
+        sROL(sBCu, sAsu, 14);
+        vXNA(Eba, Aba, BCe, BCi);
+        sXNA(sEba, sAba, sBCe, sBCi);
+        vxor(Eba, Eba, vdupq_n_u64(hybrid_KeccakF_RoundConstants[round]));
+        sEba ^= hybrid_KeccakF_RoundConstants[round];
+        vXNA(Ebe, BCe, BCi, BCo);
+        sXNA(sEbe, sBCe, sBCi, sBCo);
+        vXNA(Ebi, BCi, BCo, BCu);
+        sXNA(sEbi, sBCi, sBCo, sBCu);
+        vXNA(Ebo, BCo, BCu, Aba);
+        sXNA(sEbo, sBCo, sBCu, sAba);
+        vXNA(Ebu, BCu, Aba, BCe);
+        sXNA(sEbu, sBCu, sAba, sBCe);
+
+        vxor(Abo, Abo, Do);
+        sxor(sAbo, sAbo, sDo);
+        vROL(BCa, Abo, 28);
+        sROL(sBCa, sAbo, 28);
+        vxor(Agu, Agu, Du);
+        sxor(sAgu, sAgu, sDu);
+        vROL(BCe, Agu, 20);
+        sROL(sBCe, sAgu, 20);
+        vxor(Aka, Aka, Da);
+        sxor(sAka, sAka, sDa);
+        vROL(BCi, Aka, 3);
+        sROL(sBCi, sAka, 3);
+        vxor(Ame, Ame, De);
+        sxor(sAme, sAme, sDe);
+        vROL(BCo, Ame, 45);
+        sROL(sBCo, sAme, 45);
+        vxor(Asi, Asi, Di);
+        sxor(sAsi, sAsi, sDi);
+        vROL(BCu, Asi, 61);
+        sROL(sBCu, sAsi, 61);
+        vXNA(Ega, BCa, BCe, BCi);
+        sXNA(sEga, sBCa, sBCe, sBCi);
+        vXNA(Ege, BCe, BCi, BCo);
+        sXNA(sEge, sBCe, sBCi, sBCo);
+        vXNA(Egi, BCi, BCo, BCu);
+        sXNA(sEgi, sBCi, sBCo, sBCu);
+        vXNA(Ego, BCo, BCu, BCa);
+        sXNA(sEgo, sBCo, sBCu, sBCa);
+        vXNA(Egu, BCu, BCa, BCe);
+        sXNA(sEgu, sBCu, sBCa, sBCe);
+
+        vxor(Abe, Abe, De);
+        sxor(sAbe, sAbe, sDe);
+        vROL(BCa, Abe, 1);
+        sROL(sBCa, sAbe, 1);
+        vxor(Agi, Agi, Di);
+        sxor(sAgi, sAgi, sDi);
+        vROL(BCe, Agi, 6);
+        sROL(sBCe, sAgi, 6);
+        vxor(Ako, Ako, Do);
+        sxor(sAko, sAko, sDo);
+        vROL(BCi, Ako, 25);
+        sROL(sBCi, sAko, 25);
+        vxor(Amu, Amu, Du);
+        sxor(sAmu, sAmu, sDu);
+        vROL(BCo, Amu, 8);
+        sROL(sBCo, sAmu, 8);
+        vxor(Asa, Asa, Da);
+        sxor(sAsa, sAsa, sDa);
+        vROL(BCu, Asa, 18);
+        sROL(sBCu, sAsa, 18);
+        vXNA(Eka, BCa, BCe, BCi);
+        sXNA(sEka, sBCa, sBCe, sBCi);
+        vXNA(Eke, BCe, BCi, BCo);
+        sXNA(sEke, sBCe, sBCi, sBCo);
+        vXNA(Eki, BCi, BCo, BCu);
+        sXNA(sEki, sBCi, sBCo, sBCu);
+        vXNA(Eko, BCo, BCu, BCa);
+        sXNA(sEko, sBCo, sBCu, sBCa);
+        vXNA(Eku, BCu, BCa, BCe);
+        sXNA(sEku, sBCu, sBCa, sBCe);
+
+        vxor(Abu, Abu, Du);
+        sxor(sAbu, sAbu, sDu);
+        vROL(BCa, Abu, 27);
+        sROL(sBCa, sAbu, 27);
+        vxor(Aga, Aga, Da);
+        sxor(sAga, sAga, sDa);
+        vROL(BCe, Aga, 36);
+        sROL(sBCe, sAga, 36);
+        vxor(Ake, Ake, De);
+        sxor(sAke, sAke, sDe);
+        vROL(BCi, Ake, 10);
+        sROL(sBCi, sAke, 10);
+        vxor(Ami, Ami, Di);
+        sxor(sAmi, sAmi, sDi);
+        vROL(BCo, Ami, 15);
+        sROL(sBCo, sAmi, 15);
+        vxor(Aso, Aso, Do);
+        sxor(sAso, sAso, sDo);
+        vROL(BCu, Aso, 56);
+        sROL(sBCu, sAso, 56);
+        vXNA(Ema, BCa, BCe, BCi);
+        sXNA(sEma, sBCa, sBCe, sBCi);
+        vXNA(Eme, BCe, BCi, BCo);
+        sXNA(sEme, sBCe, sBCi, sBCo);
+        vXNA(Emi, BCi, BCo, BCu);
+        sXNA(sEmi, sBCi, sBCo, sBCu);
+        vXNA(Emo, BCo, BCu, BCa);
+        sXNA(sEmo, sBCo, sBCu, sBCa);
+        vXNA(Emu, BCu, BCa, BCe);
+        sXNA(sEmu, sBCu, sBCa, sBCe);
+
+        vxor(Abi, Abi, Di);
+        sxor(sAbi, sAbi, sDi);
+        vROL(BCa, Abi, 62);
+        sROL(sBCa, sAbi, 62);
+        vxor(Ago, Ago, Do);
+        sxor(sAgo, sAgo, sDo);
+        vROL(BCe, Ago, 55);
+        sROL(sBCe, sAgo, 55);
+        vxor(Aku, Aku, Du);
+        sxor(sAku, sAku, sDu);
+        vROL(BCi, Aku, 39);
+        sROL(sBCi, sAku, 39);
+        vxor(Ama, Ama, Da);
+        sxor(sAma, sAma, sDa);
+        vROL(BCo, Ama, 41);
+        sROL(sBCo, sAma, 41);
+        vxor(Ase, Ase, De);
+        sxor(sAse, sAse, sDe);
+        vROL(BCu, Ase, 2);
+        sROL(sBCu, sAse, 2);
+        vXNA(Esa, BCa, BCe, BCi);
+        sXNA(sEsa, sBCa, sBCe, sBCi);
+        vXNA(Ese, BCe, BCi, BCo);
+        sXNA(sEse, sBCe, sBCi, sBCo);
+        vXNA(Esi, BCi, BCo, BCu);
+        sXNA(sEsi, sBCi, sBCo, sBCu);
+        vXNA(Eso, BCo, BCu, BCa);
+        sXNA(sEso, sBCo, sBCu, sBCa);
+        vXNA(Esu, BCu, BCa, BCe);
+        sXNA(sEsu, sBCu, sBCa, sBCe);
+
+        // Next Round
+
+        //    prepareTheta
+        vXOR4(BCa, Eba, Ega, Eka, Ema, Esa);
+        sXOR4(sBCa, sEba, sEga, sEka, sEma, sEsa);
+        vXOR4(BCe, Ebe, Ege, Eke, Eme, Ese);
+        sXOR4(sBCe, sEbe, sEge, sEke, sEme, sEse);
+        vXOR4(BCi, Ebi, Egi, Eki, Emi, Esi);
+        sXOR4(sBCi, sEbi, sEgi, sEki, sEmi, sEsi);
+        vXOR4(BCo, Ebo, Ego, Eko, Emo, Eso);
+        sXOR4(sBCo, sEbo, sEgo, sEko, sEmo, sEso);
+        vXOR4(BCu, Ebu, Egu, Eku, Emu, Esu);
+        sXOR4(sBCu, sEbu, sEgu, sEku, sEmu, sEsu);
+
+        //thetaRhoPiChiIotaPrepareTheta(round+1, E, A)
+        vROL(Da, BCe, 1);
+        sROL(sDa, sBCe, 1);
+        vxor(Da, BCu, Da);
+        sxor(sDa, sBCu, sDa);
+        vROL(De, BCi, 1);
+        sROL(sDe, sBCi, 1);
+        vxor(De, BCa, De);
+        sxor(sDe, sBCa, sDe);
+        vROL(Di, BCo, 1);
+        sROL(sDi, sBCo, 1);
+        vxor(Di, BCe, Di);
+        sxor(sDi, sBCe, sDi);
+        vROL(Do, BCu, 1);
+        sROL(sDo, sBCu, 1);
+        vxor(Do, BCi, Do);
+        sxor(sDo, sBCi, sDo);
+        vROL(Du, BCa, 1);
+        sROL(sDu, sBCa, 1);
+        vxor(Du, BCo, Du);
+        sxor(sDu, sBCo, sDu);
+
+        vxor(Eba, Eba, Da);
+        sxor(sEba, sEba, sDa);
+        vxor(Ege, Ege, De);
+        sxor(sEge, sEge, sDe);
+        vROL(BCe, Ege, 44);
+        sROL(sBCe, sEge, 44);
+        vxor(Eki, Eki, Di);
+        sxor(sEki, sEki, sDi);
+        vROL(BCi, Eki, 43);
+        sROL(sBCi, sEki, 43);
+        vxor(Emo, Emo, Do);
+        sxor(sEmo, sEmo, sDo);
+        vROL(BCo, Emo, 21);
+        sROL(sBCo, sEmo, 21);
+        vxor(Esu, Esu, Du);
+        sxor(sEsu, sEsu, sDu);
+        vROL(BCu, Esu, 14);
+        sROL(sBCu, sEsu, 14);
+        vXNA(Aba, Eba, BCe, BCi);
+        sXNA(sAba, sEba, sBCe, sBCi);
+        vxor(Aba, Aba, vdupq_n_u64(hybrid_KeccakF_RoundConstants[round + 1]));
+        sAba ^= hybrid_KeccakF_RoundConstants[round + 1];
+        vXNA(Abe, BCe, BCi, BCo);
+        sXNA(sAbe, sBCe, sBCi, sBCo);
+        vXNA(Abi, BCi, BCo, BCu);
+        sXNA(sAbi, sBCi, sBCo, sBCu);
+        vXNA(Abo, BCo, BCu, Eba);
+        sXNA(sAbo, sBCo, sBCu, sEba);
+        vXNA(Abu, BCu, Eba, BCe);
+        sXNA(sAbu, sBCu, sEba, sBCe);
+
+        vxor(Ebo, Ebo, Do);
+        sxor(sEbo, sEbo, sDo);
+        vROL(BCa, Ebo, 28);
+        sROL(sBCa, sEbo, 28);
+        vxor(Egu, Egu, Du);
+        sxor(sEgu, sEgu, sDu);
+        vROL(BCe, Egu, 20);
+        sROL(sBCe, sEgu, 20);
+        vxor(Eka, Eka, Da);
+        sxor(sEka, sEka, sDa);
+        vROL(BCi, Eka, 3);
+        sROL(sBCi, sEka, 3);
+        vxor(Eme, Eme, De);
+        sxor(sEme, sEme, sDe);
+        vROL(BCo, Eme, 45);
+        sROL(sBCo, sEme, 45);
+        vxor(Esi, Esi, Di);
+        sxor(sEsi, sEsi, sDi);
+        vROL(BCu, Esi, 61);
+        sROL(sBCu, sEsi, 61);
+        vXNA(Aga, BCa, BCe, BCi);
+        sXNA(sAga, sBCa, sBCe, sBCi);
+        vXNA(Age, BCe, BCi, BCo);
+        sXNA(sAge, sBCe, sBCi, sBCo);
+        vXNA(Agi, BCi, BCo, BCu);
+        sXNA(sAgi, sBCi, sBCo, sBCu);
+        vXNA(Ago, BCo, BCu, BCa);
+        sXNA(sAgo, sBCo, sBCu, sBCa);
+        vXNA(Agu, BCu, BCa, BCe);
+        sXNA(sAgu, sBCu, sBCa, sBCe);
+
+        vxor(Ebe, Ebe, De);
+        sxor(sEbe, sEbe, sDe);
+        vROL(BCa, Ebe, 1);
+        sROL(sBCa, sEbe, 1);
+        vxor(Egi, Egi, Di);
+        sxor(sEgi, sEgi, sDi);
+        vROL(BCe, Egi, 6);
+        sROL(sBCe, sEgi, 6);
+        vxor(Eko, Eko, Do);
+        sxor(sEko, sEko, sDo);
+        vROL(BCi, Eko, 25);
+        sROL(sBCi, sEko, 25);
+        vxor(Emu, Emu, Du);
+        sxor(sEmu, sEmu, sDu);
+        vROL(BCo, Emu, 8);
+        sROL(sBCo, sEmu, 8);
+        vxor(Esa, Esa, Da);
+        sxor(sEsa, sEsa, sDa);
+        vROL(BCu, Esa, 18);
+        sROL(sBCu, sEsa, 18);
+        vXNA(Aka, BCa, BCe, BCi);
+        sXNA(sAka, sBCa, sBCe, sBCi);
+        vXNA(Ake, BCe, BCi, BCo);
+        sXNA(sAke, sBCe, sBCi, sBCo);
+        vXNA(Aki, BCi, BCo, BCu);
+        sXNA(sAki, sBCi, sBCo, sBCu);
+        vXNA(Ako, BCo, BCu, BCa);
+        sXNA(sAko, sBCo, sBCu, sBCa);
+        vXNA(Aku, BCu, BCa, BCe);
+        sXNA(sAku, sBCu, sBCa, sBCe);
+
+        vxor(Ebu, Ebu, Du);
+        sxor(sEbu, sEbu, sDu);
+        vROL(BCa, Ebu, 27);
+        sROL(sBCa, sEbu, 27);
+        vxor(Ega, Ega, Da);
+        sxor(sEga, sEga, sDa);
+        vROL(BCe, Ega, 36);
+        sROL(sBCe, sEga, 36);
+        vxor(Eke, Eke, De);
+        sxor(sEke, sEke, sDe);
+        vROL(BCi, Eke, 10);
+        sROL(sBCi, sEke, 10);
+        vxor(Emi, Emi, Di);
+        sxor(sEmi, sEmi, sDi);
+        vROL(BCo, Emi, 15);
+        sROL(sBCo, sEmi, 15);
+        vxor(Eso, Eso, Do);
+        sxor(sEso, sEso, sDo);
+        vROL(BCu, Eso, 56);
+        sROL(sBCu, sEso, 56);
+        vXNA(Ama, BCa, BCe, BCi);
+        sXNA(sAma, sBCa, sBCe, sBCi);
+        vXNA(Ame, BCe, BCi, BCo);
+        sXNA(sAme, sBCe, sBCi, sBCo);
+        vXNA(Ami, BCi, BCo, BCu);
+        sXNA(sAmi, sBCi, sBCo, sBCu);
+        vXNA(Amo, BCo, BCu, BCa);
+        sXNA(sAmo, sBCo, sBCu, sBCa);
+        vXNA(Amu, BCu, BCa, BCe);
+        sXNA(sAmu, sBCu, sBCa, sBCe);
+
+        vxor(Ebi, Ebi, Di);
+        sxor(sEbi, sEbi, sDi);
+        vROL(BCa, Ebi, 62);
+        sROL(sBCa, sEbi, 62);
+        vxor(Ego, Ego, Do);
+        sxor(sEgo, sEgo, sDo);
+        vROL(BCe, Ego, 55);
+        sROL(sBCe, sEgo, 55);
+        vxor(Eku, Eku, Du);
+        sxor(sEku, sEku, sDu);
+        vROL(BCi, Eku, 39);
+        sROL(sBCi, sEku, 39);
+        vxor(Ema, Ema, Da);
+        sxor(sEma, sEma, sDa);
+        vROL(BCo, Ema, 41);
+        sROL(sBCo, sEma, 41);
+        vxor(Ese, Ese, De);
+        sxor(sEse, sEse, sDe);
+        vROL(BCu, Ese, 2);
+        sROL(sBCu, sEse, 2);
+        vXNA(Asa, BCa, BCe, BCi);
+        sXNA(sAsa, sBCa, sBCe, sBCi);
+        vXNA(Ase, BCe, BCi, BCo);
+        sXNA(sAse, sBCe, sBCi, sBCo);
+        vXNA(Asi, BCi, BCo, BCu);
+        sXNA(sAsi, sBCi, sBCo, sBCu);
+        vXNA(Aso, BCo, BCu, BCa);
+        sXNA(sAso, sBCo, sBCu, sBCa);
+        vXNA(Asu, BCu, BCa, BCe);
+        sXNA(sAsu, sBCu, sBCa, sBCe);
+    }
+
+    state[0] = Aba;
+    state1[0] = sAba;
+    state[1] = Abe;
+    state1[1] = sAbe;
+    state[2] = Abi;
+    state1[2] = sAbi;
+    state[3] = Abo;
+    state1[3] = sAbo;
+    state[4] = Abu;
+    state1[4] = sAbu;
+    state[5] = Aga;
+    state1[5] = sAga;
+    state[6] = Age;
+    state1[6] = sAge;
+    state[7] = Agi;
+    state1[7] = sAgi;
+    state[8] = Ago;
+    state1[8] = sAgo;
+    state[9] = Agu;
+    state1[9] = sAgu;
+    state[10] = Aka;
+    state1[10] = sAka;
+    state[11] = Ake;
+    state1[11] = sAke;
+    state[12] = Aki;
+    state1[12] = sAki;
+    state[13] = Ako;
+    state1[13] = sAko;
+    state[14] = Aku;
+    state1[14] = sAku;
+    state[15] = Ama;
+    state1[15] = sAma;
+    state[16] = Ame;
+    state1[16] = sAme;
+    state[17] = Ami;
+    state1[17] = sAmi;
+    state[18] = Amo;
+    state1[18] = sAmo;
+    state[19] = Amu;
+    state1[19] = sAmu;
+    state[20] = Asa;
+    state1[20] = sAsa;
+    state[21] = Ase;
+    state1[21] = sAse;
+    state[22] = Asi;
+    state1[22] = sAsi;
+    state[23] = Aso;
+    state1[23] = sAso;
+    state[24] = Asu;
+    state1[24] = sAsu;
+}
+#endif
+
+#if defined(KECCAK_SHA3_DISPATCH)
+static void KeccakF1600_StatePermutex3_generic(v128 state[25], uint64_t state1[25]) {
+    KeccakF1600_StatePermutex3_hybrid(state, state1);
+}
+
+static void KeccakF1600_StatePermutex3_sha3(v128 state[25], uint64_t state1[25]) {
+    f1600x2(state, hybrid_KeccakF_RoundConstants);
+    f1600(state1, hybrid_KeccakF_RoundConstants);
+}
+
+static void (*KeccakF1600_StatePermutex3_impl)(v128 state[25], uint64_t state1[25]) =
+    KeccakF1600_StatePermutex3_generic;
+
+// Escolhe a permutação uma única vez, ao carregar o binário/biblioteca
+__attribute__((constructor))
+static void KeccakF1600_StatePermutex3_dispatch(void) {
+    if(dilithium_cpu_features() & CPU_FEATURE_SHA3)
+        KeccakF1600_StatePermutex3_impl = KeccakF1600_StatePermutex3_sha3;
+}
+#endif
+
+static inline
+void KeccakF1600_StatePermutex3(v128 state[25], uint64_t state1[25]) {
+    #if defined(KECCAK_SHA3_STATIC)
+    f1600x2(state, hybrid_KeccakF_RoundConstants);
+    f1600(state1, hybrid_KeccakF_RoundConstants);
+    #elif defined(KECCAK_SHA3_DISPATCH)
+    KeccakF1600_StatePermutex3_impl(state, state1);
+    #else
+    KeccakF1600_StatePermutex3_hybrid(state, state1);
+    #endif
+}
+
+
+/*************************************************
+* Name:        keccakx3_absorb
+*
+* Description: Absorb step of Keccak for three inputs of equal length;
+*              non-incremental, starts by zeroeing the state.
+*
+* Arguments:   - v128 *s: pointer to (uninitialized) NEON state (lanes 0, 1)
+*              - uint64_t *s1: pointer to (uninitialized) scalar state (lane 2)
+*              - unsigned int r: rate in bytes (e.g., 168 for SHAKE128)
+*              - const uint8_t *in0, *in1, *in2: pointers to the inputs
+*              - size_t inlen: length of each input in bytes
+*              - uint8_t p: domain-separation byte for different
+*                           Keccak-derived functions
+**************************************************/
+static
+void keccakx3_absorb(v128 s[25],
+                     uint64_t s1[25],
+                     unsigned int r,
+                     const uint8_t *in0,
+                     const uint8_t *in1,
+                     const uint8_t *in2,
+                     size_t inlen,
+                     uint8_t p) {
+    size_t i, pos = 0;
+    uint64_t t2;
+    uint8_t t[3][200];
+
+    for (i = 0; i < 25; ++i) {
+        s[i] = vdupq_n_u64(0);
+        s1[i] = 0;
+    }
+
+    while (inlen >= r) {
+        for (i = 0; i < r / 8; ++i) {
+            s[i] = veorq_u64(s[i], vcombine_u64(vld1_u64((const uint64_t *)&in0[pos]),
+                                                vld1_u64((const uint64_t *)&in1[pos])));
+            memcpy(&t2, &in2[pos], 8);
+            s1[i] ^= t2;
+            pos += 8;
+        }
+
+        KeccakF1600_StatePermutex3(s, s1);
+        inlen -= r;
+    }
+
+    // Último bloco com padding, montado em buffers zerados
+    memset(t, 0, sizeof(t));
+    memcpy(t[0], &in0[pos], inlen);
+    memcpy(t[1], &in1[pos], inlen);
+    memcpy(t[2], &in2[pos], inlen);
+    for (i = 0; i < 3; ++i) {
+        t[i][inlen] = p;
+        t[i][r - 1] |= 0x80;
+    }
+
+    for (i = 0; i < r / 8; ++i) {
+        s[i] = veorq_u64(s[i], vcombine_u64(vld1_u64((const uint64_t *)&t[0][8 * i]),
+                                            vld1_u64((const uint64_t *)&t[1][8 * i])));
+        memcpy(&t2, &t[2][8 * i], 8);
+        s1[i] ^= t2;
+    }
+}
+
+/*************************************************
+* Name:        keccakx3_squeezeblocks
+*
+* Description: Squeeze step of Keccak. Squeezes full blocks of r bytes each
+*              for the three lanes. Modifies the state. Can be called
+*              multiple times to keep squeezing, i.e., is incremental.
+*
+* Arguments:   - uint8_t *out0, *out1, *out2: pointers to output blocks
+*              - size_t nblocks: number of blocks to be squeezed
+*              - unsigned int r: rate in bytes (e.g., 168 for SHAKE128)
+*              - v128 *s: pointer to input/output NEON state (lanes 0, 1)
+*              - uint64_t *s1: pointer to input/output scalar state (lane 2)
+**************************************************/
+static
+void keccakx3_squeezeblocks(uint8_t *out0,
+                            uint8_t *out1,
+                            uint8_t *out2,
+                            size_t nblocks,
+                            unsigned int r,
+                            v128 s[25],
+                            uint64_t s1[25]) {
+    unsigned int i;
+
+    uint64x1_t a, b;
+    uint64x2x2_t a2, b2;
+
+    while (nblocks > 0) {
+        KeccakF1600_StatePermutex3(s, s1);
+
+        for (i = 0; i < r / 8 - 1; i += 4) {
+            a2.val[0] = vuzp1q_u64(s[i], s[i + 1]);
+            b2.val[0] = vuzp2q_u64(s[i], s[i + 1]);
+            a2.val[1] = vuzp1q_u64(s[i + 2], s[i + 3]);
+            b2.val[1] = vuzp2q_u64(s[i + 2], s[i + 3]);
+            vst1q_u64_x2((uint64_t *)out0, a2);
+            vst1q_u64_x2((uint64_t *)out1, b2);
+
+            out0 += 32;
+            out1 += 32;
+        }
+
+        i = r / 8 - 1;
+        // Last iteration
+        a = vget_low_u64(s[i]);
+        b = vget_high_u64(s[i]);
+        vst1_u64((uint64_t *)out0, a);
+        vst1_u64((uint64_t *)out1, b);
+
+        out0 += 8;
+        out1 += 8;
+
+        // Faixa escalar
+        memcpy(out2, s1, r);
+        out2 += r;
+
+        --nblocks;
+    }
+}
+
+/*************************************************
+* Name:        shake128x3_absorb
+*
+* Description: Absorb step of the SHAKE128 XOF for three inputs.
+*              non-incremental, starts by zeroeing the state.
+*
+* Arguments:   - keccakx3_state *state: pointer to (uninitialized) output
+*                                     Keccak state
+*              - const uint8_t *in0, *in1, *in2: pointers to the inputs
+*              - size_t inlen:        length of each input in bytes
+**************************************************/
+void FIPS202X3_NAMESPACE(shake128x3_absorb)(keccakx3_state *state,
+                       const uint8_t *in0,
+                       const uint8_t *in1,
+                       const uint8_t *in2,
+                       size_t inlen) {
+    #ifdef PROFILE_HASHING
+    uint64_t t0 = hal_get_time();
+    #endif
+    keccakx3_absorb(state->s, state->s1, SHAKE128_RATE, in0, in1, in2, inlen, 0x1F);
+    #ifdef PROFILE_HASHING
+    uint64_t t1 = hal_get_time();
+    hash_cycles += (t1 - t0);
+    #endif
+}
+
+/*************************************************
+* Name:        shake128x3_squeezeblocks
+*
+* Description: Squeeze step of SHAKE128 XOF for three lanes. Squeezes full
+*              blocks of SHAKE128_RATE bytes each. Modifies the state. Can be
+*              called multiple times to keep squeezing, i.e., is incremental.
+*
+* Arguments:   - uint8_t *out0, *out1, *out2: pointers to output blocks
+*              - size_t nblocks:  number of blocks to be squeezed
+*                                 (written to each output)
+*              - keccakx3_state *s: pointer to input/output Keccak state
+**************************************************/
+void FIPS202X3_NAMESPACE(shake128x3_squeezeblocks)(uint8_t *out0,
+                              uint8_t *out1,
+                              uint8_t *out2,
+                              size_t nblocks,
+                              keccakx3_state *state) {
+    #ifdef PROFILE_HASHING
+    uint64_t t0 = hal_get_time();
+    #endif
+    keccakx3_squeezeblocks(out0, out1, out2, nblocks, SHAKE128_RATE, state->s, state->s1);
+    #ifdef PROFILE_HASHING
+    uint64_t t1 = hal_get_time();
+    hash_cycles += (t1 - t0);
+    #endif
+}
+
+/*************************************************
+* Name:        shake256x3_absorb
+*
+* Description: Absorb step of the SHAKE256 XOF for three inputs.
+*              non-incremental, starts by zeroeing the state.
+*
+* Arguments:   - keccakx3_state *state: pointer to (uninitialized) output
+*                                     Keccak state
+*              - const uint8_t *in0, *in1, *in2: pointers to the inputs
+*              - size_t inlen:        length of each input in bytes
+**************************************************/
+void FIPS202X3_NAMESPACE(shake256x3_absorb)(keccakx3_state *state,
+                       const uint8_t *in0,
+                       const uint8_t *in1,
+                       const uint8_t *in2,
+                       size_t inlen) {
+    #ifdef PROFILE_HASHING
+    uint64_t t0 = hal_get_time();
+    #endif
+    keccakx3_absorb(state->s, state->s1, SHAKE256_RATE, in0, in1, in2, inlen, 0x1F);
+    #ifdef PROFILE_HASHING
+    uint64_t t1 = hal_get_time();
+    hash_cycles += (t1 - t0);
+    #endif
+}
+
+/*************************************************
+* Name:        shake256x3_squeezeblocks
+*
+* Description: Squeeze step of SHAKE256 XOF for three lanes. Squeezes full
+*              blocks of SHAKE256_RATE bytes each. Modifies the state. Can be
+*              called multiple times to keep squeezing, i.e., is incremental.
+*
+* Arguments:   - uint8_t *out0, *out1, *out2: pointers to output blocks
+*              - size_t nblocks:  number of blocks to be squeezed
+*                                 (written to each output)
+*              - keccakx3_state *s: pointer to input/output Keccak state
+**************************************************/
+void FIPS202X3_NAMESPACE(shake256x3_squeezeblocks)(uint8_t *out0,
+                              uint8_t *out1,
+                              uint8_t *out2,
+                              size_t nblocks,
+                              keccakx3_state *state) {
+    #ifdef PROFILE_HASHING
+    uint64_t t0 = hal_get_time();
+    #endif
+    keccakx3_squeezeblocks(out0, out1, out2, nblocks, SHAKE256_RATE, state->s, state->s1);
+    #ifdef PROFILE_HASHING
+    uint64_t t1 = hal_get_time();
+    hash_cycles += (t1 - t0);
+    #endif
+}
+
+/*************************************************
+* Name:        shake128x3
+*
+* Description: SHAKE128 XOF with non-incremental API, three instances
+*
+* Arguments:   - uint8_t *out0, *out1, *out2: pointers to outputs
+*              - size_t outlen:     requested output length in bytes
+*              - const uint8_t *in0, *in1, *in2: pointers to inputs
+*              - size_t inlen:      length of each input in bytes
+**************************************************/
+void FIPS202X3_NAMESPACE(shake128x3)(uint8_t *out0,
+                uint8_t *out1,
+                uint8_t *out2,
+                size_t outlen,
+                const uint8_t *in0,
+                const uint8_t *in1,
+                const uint8_t *in2,
+                size_t inlen) {
+    unsigned int i;
+    size_t nblocks = outlen / SHAKE128_RATE;
+    uint8_t t[3][SHAKE128_RATE];
+    keccakx3_state state;
+
+    FIPS202X3_NAMESPACE(shake128x3_absorb)(&state, in0, in1, in2, inlen);
+    FIPS202X3_NAMESPACE(shake128x3_squeezeblocks)(out0, out1, out2, nblocks, &state);
+
+    out0 += nblocks * SHAKE128_RATE;
+    out1 += nblocks * SHAKE128_RATE;
+    out2 += nblocks * SHAKE128_RATE;
+    outlen -= nblocks * SHAKE128_RATE;
+
+    if (outlen) {
+        FIPS202X3_NAMESPACE(shake128x3_squeezeblocks)(t[0], t[1], t[2], 1, &state);
+        for (i = 0; i < outlen; ++i) {
+            out0[i] = t[0][i];
+            out1[i] = t[1][i];
+            out2[i] = t[2][i];
+        }
+    }
+}
+
+/*************************************************
+* Name:        shake256x3
+*
+* Description: SHAKE256 XOF with non-incremental API, three instances
+*
+* Arguments:   - uint8_t *out0, *out1, *out2: pointers to outputs
+*              - size_t outlen:     requested output length in bytes
+*              - const uint8_t *in0, *in1, *in2: pointers to inputs
+*              - size_t inlen:      length of each input in bytes
+**************************************************/
+void FIPS202X3_NAMESPACE(shake256x3)(uint8_t *out0,
+                uint8_t *out1,
+                uint8_t *out2,
+                size_t outlen,
+                const uint8_t *in0,
+                const uint8_t *in1,
+                const uint8_t *in2,
+                size_t inlen) {
+    unsigned int i;
+    size_t nblocks = outlen / SHAKE256_RATE;
+    uint8_t t[3][SHAKE256_RATE];
+    keccakx3_state state;
+
+    FIPS202X3_NAMESPACE(shake256x3_absorb)(&state, in0, in1, in2, inlen);
+    FIPS202X3_NAMESPACE(shake256x3_squeezeblocks)(out0, out1, out2, nblocks, &state);
+
+    out0 += nblocks * SHAKE256_RATE;
+    out1 += nblocks * SHAKE256_RATE;
+    out2 += nblocks * SHAKE256_RATE;
+    outlen -= nblocks * SHAKE256_RATE;
+
+    if (outlen) {
+        FIPS202X3_NAMESPACE(shake256x3_squeezeblocks)(t[0], t[1], t[2], 1, &state);
+        for (i = 0; i < outlen; ++i) {
+            out0[i] = t[0][i];
+            out1[i] = t[1][i];
+            out2[i] = t[2][i];
+        }
+    }
+}
@@ -0,0 +1,63 @@
+#ifndef FIPS202x3_H
+#define FIPS202x3_H
+
+#ifndef FIPS202X3_NAMESPACE
+#define FIPS202X3_NAMESPACE(s) dilithium_fips202x3_##s
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <arm_neon.h>
+#include "fips202x2.h"
+
+/* Estado híbrido: faixas 0 e 1 em registradores NEON, faixa 2 escalar */
+typedef struct {
+    v128 s[25];
+    uint64_t s1[25];
+} keccakx3_state;
+
+
+void FIPS202X3_NAMESPACE(shake128x3_absorb)(keccakx3_state *state,
+                            const uint8_t *in0,
+                            const uint8_t *in1,
+                            const uint8_t *in2,
+                            size_t inlen);
+
+void FIPS202X3_NAMESPACE(shake128x3_squeezeblocks)(uint8_t *out0,
+                              uint8_t *out1,
+                              uint8_t *out2,
+                              size_t nblocks,
+                              keccakx3_state *state);
+
+void FIPS202X3_NAMESPACE(shake256x3_absorb)(keccakx3_state *state,
+                            const uint8_t *in0,
+                            const uint8_t *in1,
+                            const uint8_t *in2,
+                            size_t inlen);
+
+void FIPS202X3_NAMESPACE(shake256x3_squeezeblocks)(uint8_t *out0,
+                              uint8_t *out1,
+                              uint8_t *out2,
+                              size_t nblocks,
+                              keccakx3_state *state);
+
+
+void FIPS202X3_NAMESPACE(shake128x3)(uint8_t *out0,
+                uint8_t *out1,
+                uint8_t *out2,
+                size_t outlen,
+                const uint8_t *in0,
+                const uint8_t *in1,
+                const uint8_t *in2,
+                size_t inlen);
+
+void FIPS202X3_NAMESPACE(shake256x3)(uint8_t *out0,
+                uint8_t *out1,
+                uint8_t *out2,
+                size_t outlen,
+                const uint8_t *in0,
+                const uint8_t *in1,
+                const uint8_t *in2,
+                size_t inlen);
+
+#endif
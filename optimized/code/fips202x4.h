@@ -0,0 +1,81 @@
+#ifndef FIPS202X4_H
+#define FIPS202X4_H
+
+#ifndef FIPS202X4_NAMESPACE
+#define FIPS202X4_NAMESPACE(s) dilithium_fips202x4_##s
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#define SHAKE128_RATE 168
+#define SHAKE256_RATE 136
+
+/* Quatro estados Keccak intercalados: a faixa i dos quatro estados
+ * ocupa os quatro elementos de 64 bits de s[i]. Os tipos vetoriais do
+ * RVV não têm tamanho fixo, então lá o estado fica em memória. */
+#if defined(__AVX2__)
+typedef struct {
+    __m256i s[25];
+} keccakx4_state;
+#else
+typedef struct {
+    uint64_t s[25][4];
+} keccakx4_state;
+#endif
+
+
+void FIPS202X4_NAMESPACE(shake128x4_absorb_once)(keccakx4_state *state,
+                            const uint8_t *in0,
+                            const uint8_t *in1,
+                            const uint8_t *in2,
+                            const uint8_t *in3,
+                            size_t inlen);
+
+void FIPS202X4_NAMESPACE(shake128x4_squeezeblocks)(uint8_t *out0,
+                              uint8_t *out1,
+                              uint8_t *out2,
+                              uint8_t *out3,
+                              size_t nblocks,
+                              keccakx4_state *state);
+
+void FIPS202X4_NAMESPACE(shake256x4_absorb_once)(keccakx4_state *state,
+                            const uint8_t *in0,
+                            const uint8_t *in1,
+                            const uint8_t *in2,
+                            const uint8_t *in3,
+                            size_t inlen);
+
+void FIPS202X4_NAMESPACE(shake256x4_squeezeblocks)(uint8_t *out0,
+                              uint8_t *out1,
+                              uint8_t *out2,
+                              uint8_t *out3,
+                              size_t nblocks,
+                              keccakx4_state *state);
+
+void FIPS202X4_NAMESPACE(shake128x4)(uint8_t *out0,
+                uint8_t *out1,
+                uint8_t *out2,
+                uint8_t *out3,
+                size_t outlen,
+                const uint8_t *in0,
+                const uint8_t *in1,
+                const uint8_t *in2,
+                const uint8_t *in3,
+                size_t inlen);
+
+void FIPS202X4_NAMESPACE(shake256x4)(uint8_t *out0,
+                uint8_t *out1,
+                uint8_t *out2,
+                uint8_t *out3,
+                size_t outlen,
+                const uint8_t *in0,
+                const uint8_t *in1,
+                const uint8_t *in2,
+                const uint8_t *in3,
+                size_t inlen);
+
+#endif
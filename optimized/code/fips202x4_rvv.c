@@ -0,0 +1,608 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <riscv_vector.h>
+#include "fips202x4.h"
+
+#define NROUNDS 24
+
+/* Keccak de 4 vias para RVV 1.0: os quatro estados ocupam um grupo de
+ * registradores LMUL=2 de elementos de 64 bits (vl = 4 já com VLEN = 128). */
+
+// Operações RVV com os mesmos nomes usados nas versões NEON e AVX2
+// c = a ^ b
+#define vxor(c, a, b) c = __riscv_vxor_vv_u64m2(a, b, vl);
+// Rotate by n bit ((a << offset) ^ (a >> (64-offset)))
+#define vROL(out, a, offset)                                 \
+    out = __riscv_vor_vv_u64m2(__riscv_vsll_vx_u64m2(a, offset, vl), \
+                               __riscv_vsrl_vx_u64m2(a, 64 - offset, vl), vl);
+// Xor chain: out = a ^ b ^ c ^ d ^ e
+#define vXOR4(out, a, b, c, d, e)          \
+    out = __riscv_vxor_vv_u64m2(a, b, vl);   \
+    out = __riscv_vxor_vv_u64m2(out, c, vl); \
+    out = __riscv_vxor_vv_u64m2(out, d, vl); \
+    out = __riscv_vxor_vv_u64m2(out, e, vl);
+// Xor Not And: out = a ^ ( (~b) & c)
+#define vXNA(out, a, b, c) \
+    out = __riscv_vxor_vv_u64m2(a, __riscv_vand_vv_u64m2(__riscv_vnot_v_u64m2(b, vl), c, vl), vl);
+// End Define
+
+/* Keccak round constants */
+static const uint64_t KeccakF_RoundConstants[NROUNDS] = {
+    (uint64_t)0x0000000000000001ULL,
+    (uint64_t)0x0000000000008082ULL,
+    (uint64_t)0x800000000000808aULL,
+    (uint64_t)0x8000000080008000ULL,
+    (uint64_t)0x000000000000808bULL,
+    (uint64_t)0x0000000080000001ULL,
+    (uint64_t)0x8000000080008081ULL,
+    (uint64_t)0x8000000000008009ULL,
+    (uint64_t)0x000000000000008aULL,
+    (uint64_t)0x0000000000000088ULL,
+    (uint64_t)0x0000000080008009ULL,
+    (uint64_t)0x000000008000000aULL,
+    (uint64_t)0x000000008000808bULL,
+    (uint64_t)0x800000000000008bULL,
+    (uint64_t)0x8000000000008089ULL,
+    (uint64_t)0x8000000000008003ULL,
+    (uint64_t)0x8000000000008002ULL,
+    (uint64_t)0x8000000000000080ULL,
+    (uint64_t)0x000000000000800aULL,
+    (uint64_t)0x800000008000000aULL,
+    (uint64_t)0x8000000080008081ULL,
+    (uint64_t)0x8000000000008080ULL,
+    (uint64_t)0x0000000080000001ULL,
+    (uint64_t)0x8000000080008008ULL
+};
+
+/*************************************************
+* Name:        KeccakF1600_StatePermutex4
+*
+* Description: The Keccak F1600 Permutation applied to four interleaved
+*              states; row i of state holds lane i of the four states
+*
+* Arguments:   - uint64_t state[25][4]: pointer to input/output Keccak states
+**************************************************/
+static
+void KeccakF1600_StatePermutex4(uint64_t state[25][4]) {
+    const size_t vl = __riscv_vsetvl_e64m2(4);
+    vuint64m2_t Aba, Abe, Abi, Abo, Abu;
+    vuint64m2_t Aga, Age, Agi, Ago, Agu;
+    vuint64m2_t Aka, Ake, Aki, Ako, Aku;
+    vuint64m2_t Ama, Ame, Ami, Amo, Amu;
+    vuint64m2_t Asa, Ase, Asi, Aso, Asu;
+    vuint64m2_t BCa, BCe, BCi, BCo, BCu; // tmp
+    vuint64m2_t Da, De, Di, Do, Du;      // D
+    vuint64m2_t Eba, Ebe, Ebi, Ebo, Ebu;
+    vuint64m2_t Ega, Ege, Egi, Ego, Egu;
+    vuint64m2_t Eka, Eke, Eki, Eko, Eku;
+    vuint64m2_t Ema, Eme, Emi, Emo, Emu;
+    vuint64m2_t Esa, Ese, Esi, Eso, Esu;
+
+    //copyFromState(A, state)
+    Aba = __riscv_vle64_v_u64m2(state[0], vl);
+    Abe = __riscv_vle64_v_u64m2(state[1], vl);
+    Abi = __riscv_vle64_v_u64m2(state[2], vl);
+    Abo = __riscv_vle64_v_u64m2(state[3], vl);
+    Abu = __riscv_vle64_v_u64m2(state[4], vl);
+    Aga = __riscv_vle64_v_u64m2(state[5], vl);
+    Age = __riscv_vle64_v_u64m2(state[6], vl);
+    Agi = __riscv_vle64_v_u64m2(state[7], vl);
+    Ago = __riscv_vle64_v_u64m2(state[8], vl);
+    Agu = __riscv_vle64_v_u64m2(state[9], vl);
+    Aka = __riscv_vle64_v_u64m2(state[10], vl);
+    Ake = __riscv_vle64_v_u64m2(state[11], vl);
+    Aki = __riscv_vle64_v_u64m2(state[12], vl);
+    Ako = __riscv_vle64_v_u64m2(state[13], vl);
+    Aku = __riscv_vle64_v_u64m2(state[14], vl);
+    Ama = __riscv_vle64_v_u64m2(state[15], vl);
+    Ame = __riscv_vle64_v_u64m2(state[16], vl);
+    Ami = __riscv_vle64_v_u64m2(state[17], vl);
+    Amo = __riscv_vle64_v_u64m2(state[18], vl);
+    Amu = __riscv_vle64_v_u64m2(state[19], vl);
+    Asa = __riscv_vle64_v_u64m2(state[20], vl);
+    Ase = __riscv_vle64_v_u64m2(state[21], vl);
+    Asi = __riscv_vle64_v_u64m2(state[22], vl);
+    Aso = __riscv_vle64_v_u64m2(state[23], vl);
+    Asu = __riscv_vle64_v_u64m2(state[24], vl);
+
+    for (int round = 0; round < NROUNDS; round += 2) {
+        //    prepareTheta
+        vXOR4(BCa, Aba, Aga, Aka, Ama, Asa);
+        vXOR4(BCe, Abe, Age, Ake, Ame, Ase);
+        vXOR4(BCi, Abi, Agi, Aki, Ami, Asi);
+        vXOR4(BCo, Abo, Ago, Ako, Amo, Aso);
+        vXOR4(BCu, Abu, Agu, Aku, Amu, Asu);
+
+        //thetaRhoPiChiIotaPrepareTheta(round  , A, E)
+        vROL(Da, BCe, 1);
+        vxor(Da, BCu, Da);
+        vROL(De, BCi, 1);
+        vxor(De, BCa, De);
+        vROL(Di, BCo, 1);
+        vxor(Di, BCe, Di);
+        vROL(Do, BCu, 1);
+        vxor(Do, BCi, Do);
+        vROL(Du, BCa, 1);
+        vxor(Du, BCo, Du);
+
+        vxor(Aba, Aba, Da);
+        vxor(Age, Age, De);
+        vROL(BCe, Age, 44);
+        vxor(Aki, Aki, Di);
+        vROL(BCi, Aki, 43);
+        vxor(Amo, Amo, Do);
+        vROL(BCo, Amo, 21);
+        vxor(Asu, Asu, Du);
+        vROL(BCu, Asu, 14);
+        vXNA(Eba, Aba, BCe, BCi);
+        vxor(Eba, Eba, __riscv_vmv_v_x_u64m2(KeccakF_RoundConstants[round], vl));
+        vXNA(Ebe, BCe, BCi, BCo);
+        vXNA(Ebi, BCi, BCo, BCu);
+        vXNA(Ebo, BCo, BCu, Aba);
+        vXNA(Ebu, BCu, Aba, BCe);
+
+        vxor(Abo, Abo, Do);
+        vROL(BCa, Abo, 28);
+        vxor(Agu, Agu, Du);
+        vROL(BCe, Agu, 20);
+        vxor(Aka, Aka, Da);
+        vROL(BCi, Aka, 3);
+        vxor(Ame, Ame, De);
+        vROL(BCo, Ame, 45);
+        vxor(Asi, Asi, Di);
+        vROL(BCu, Asi, 61);
+        vXNA(Ega, BCa, BCe, BCi);
+        vXNA(Ege, BCe, BCi, BCo);
+        vXNA(Egi, BCi, BCo, BCu);
+        vXNA(Ego, BCo, BCu, BCa);
+        vXNA(Egu, BCu, BCa, BCe);
+
+        vxor(Abe, Abe, De);
+        vROL(BCa, Abe, 1);
+        vxor(Agi, Agi, Di);
+        vROL(BCe, Agi, 6);
+        vxor(Ako, Ako, Do);
+        vROL(BCi, Ako, 25);
+        vxor(Amu, Amu, Du);
+        vROL(BCo, Amu, 8);
+        vxor(Asa, Asa, Da);
+        vROL(BCu, Asa, 18);
+        vXNA(Eka, BCa, BCe, BCi);
+        vXNA(Eke, BCe, BCi, BCo);
+        vXNA(Eki, BCi, BCo, BCu);
+        vXNA(Eko, BCo, BCu, BCa);
+        vXNA(Eku, BCu, BCa, BCe);
+
+        vxor(Abu, Abu, Du);
+        vROL(BCa, Abu, 27);
+        vxor(Aga, Aga, Da);
+        vROL(BCe, Aga, 36);
+        vxor(Ake, Ake, De);
+        vROL(BCi, Ake, 10);
+        vxor(Ami, Ami, Di);
+        vROL(BCo, Ami, 15);
+        vxor(Aso, Aso, Do);
+        vROL(BCu, Aso, 56);
+        vXNA(Ema, BCa, BCe, BCi);
+        vXNA(Eme, BCe, BCi, BCo);
+        vXNA(Emi, BCi, BCo, BCu);
+        vXNA(Emo, BCo, BCu, BCa);
+        vXNA(Emu, BCu, BCa, BCe);
+
+        vxor(Abi, Abi, Di);
+        vROL(BCa, Abi, 62);
+        vxor(Ago, Ago, Do);
+        vROL(BCe, Ago, 55);
+        vxor(Aku, Aku, Du);
+        vROL(BCi, Aku, 39);
+        vxor(Ama, Ama, Da);
+        vROL(BCo, Ama, 41);
+        vxor(Ase, Ase, De);
+        vROL(BCu, Ase, 2);
+        vXNA(Esa, BCa, BCe, BCi);
+        vXNA(Ese, BCe, BCi, BCo);
+        vXNA(Esi, BCi, BCo, BCu);
+        vXNA(Eso, BCo, BCu, BCa);
+        vXNA(Esu, BCu, BCa, BCe);
+
+        // Next Round
+
+        //    prepareTheta
+        vXOR4(BCa, Eba, Ega, Eka, Ema, Esa);
+        vXOR4(BCe, Ebe, Ege, Eke, Eme, Ese);
+        vXOR4(BCi, Ebi, Egi, Eki, Emi, Esi);
+        vXOR4(BCo, Ebo, Ego, Eko, Emo, Eso);
+        vXOR4(BCu, Ebu, Egu, Eku, Emu, Esu);
+
+        //thetaRhoPiChiIotaPrepareTheta(round+1, E, A)
+        vROL(Da, BCe, 1);
+        vxor(Da, BCu, Da);
+        vROL(De, BCi, 1);
+        vxor(De, BCa, De);
+        vROL(Di, BCo, 1);
+        vxor(Di, BCe, Di);
+        vROL(Do, BCu, 1);
+        vxor(Do, BCi, Do);
+        vROL(Du, BCa, 1);
+        vxor(Du, BCo, Du);
+
+        vxor(Eba, Eba, Da);
+        vxor(Ege, Ege, De);
+        vROL(BCe, Ege, 44);
+        vxor(Eki, Eki, Di);
+        vROL(BCi, Eki, 43);
+        vxor(Emo, Emo, Do);
+        vROL(BCo, Emo, 21);
+        vxor(Esu, Esu, Du);
+        vROL(BCu, Esu, 14);
+        vXNA(Aba, Eba, BCe, BCi);
+        vxor(Aba, Aba, __riscv_vmv_v_x_u64m2(KeccakF_RoundConstants[round + 1], vl));
+        vXNA(Abe, BCe, BCi, BCo);
+        vXNA(Abi, BCi, BCo, BCu);
+        vXNA(Abo, BCo, BCu, Eba);
+        vXNA(Abu, BCu, Eba, BCe);
+
+        vxor(Ebo, Ebo, Do);
+        vROL(BCa, Ebo, 28);
+        vxor(Egu, Egu, Du);
+        vROL(BCe, Egu, 20);
+        vxor(Eka, Eka, Da);
+        vROL(BCi, Eka, 3);
+        vxor(Eme, Eme, De);
+        vROL(BCo, Eme, 45);
+        vxor(Esi, Esi, Di);
+        vROL(BCu, Esi, 61);
+        vXNA(Aga, BCa, BCe, BCi);
+        vXNA(Age, BCe, BCi, BCo);
+        vXNA(Agi, BCi, BCo, BCu);
+        vXNA(Ago, BCo, BCu, BCa);
+        vXNA(Agu, BCu, BCa, BCe);
+
+        vxor(Ebe, Ebe, De);
+        vROL(BCa, Ebe, 1);
+        vxor(Egi, Egi, Di);
+        vROL(BCe, Egi, 6);
+        vxor(Eko, Eko, Do);
+        vROL(BCi, Eko, 25);
+        vxor(Emu, Emu, Du);
+        vROL(BCo, Emu, 8);
+        vxor(Esa, Esa, Da);
+        vROL(BCu, Esa, 18);
+        vXNA(Aka, BCa, BCe, BCi);
+        vXNA(Ake, BCe, BCi, BCo);
+        vXNA(Aki, BCi, BCo, BCu);
+        vXNA(Ako, BCo, BCu, BCa);
+        vXNA(Aku, BCu, BCa, BCe);
+
+        vxor(Ebu, Ebu, Du);
+        vROL(BCa, Ebu, 27);
+        vxor(Ega, Ega, Da);
+        vROL(BCe, Ega, 36);
+        vxor(Eke, Eke, De);
+        vROL(BCi, Eke, 10);
+        vxor(Emi, Emi, Di);
+        vROL(BCo, Emi, 15);
+        vxor(Eso, Eso, Do);
+        vROL(BCu, Eso, 56);
+        vXNA(Ama, BCa, BCe, BCi);
+        vXNA(Ame, BCe, BCi, BCo);
+        vXNA(Ami, BCi, BCo, BCu);
+        vXNA(Amo, BCo, BCu, BCa);
+        vXNA(Amu, BCu, BCa, BCe);
+
+        vxor(Ebi, Ebi, Di);
+        vROL(BCa, Ebi, 62);
+        vxor(Ego, Ego, Do);
+        vROL(BCe, Ego, 55);
+        vxor(Eku, Eku, Du);
+        vROL(BCi, Eku, 39);
+        vxor(Ema, Ema, Da);
+        vROL(BCo, Ema, 41);
+        vxor(Ese, Ese, De);
+        vROL(BCu, Ese, 2);
+        vXNA(Asa, BCa, BCe, BCi);
+        vXNA(Ase, BCe, BCi, BCo);
+        vXNA(Asi, BCi, BCo, BCu);
+        vXNA(Aso, BCo, BCu, BCa);
+        vXNA(Asu, BCu, BCa, BCe);
+    }
+
+    __riscv_vse64_v_u64m2(state[0], Aba, vl);
+    __riscv_vse64_v_u64m2(state[1], Abe, vl);
+    __riscv_vse64_v_u64m2(state[2], Abi, vl);
+    __riscv_vse64_v_u64m2(state[3], Abo, vl);
+    __riscv_vse64_v_u64m2(state[4], Abu, vl);
+    __riscv_vse64_v_u64m2(state[5], Aga, vl);
+    __riscv_vse64_v_u64m2(state[6], Age, vl);
+    __riscv_vse64_v_u64m2(state[7], Agi, vl);
+    __riscv_vse64_v_u64m2(state[8], Ago, vl);
+    __riscv_vse64_v_u64m2(state[9], Agu, vl);
+    __riscv_vse64_v_u64m2(state[10], Aka, vl);
+    __riscv_vse64_v_u64m2(state[11], Ake, vl);
+    __riscv_vse64_v_u64m2(state[12], Aki, vl);
+    __riscv_vse64_v_u64m2(state[13], Ako, vl);
+    __riscv_vse64_v_u64m2(state[14], Aku, vl);
+    __riscv_vse64_v_u64m2(state[15], Ama, vl);
+    __riscv_vse64_v_u64m2(state[16], Ame, vl);
+    __riscv_vse64_v_u64m2(state[17], Ami, vl);
+    __riscv_vse64_v_u64m2(state[18], Amo, vl);
+    __riscv_vse64_v_u64m2(state[19], Amu, vl);
+    __riscv_vse64_v_u64m2(state[20], Asa, vl);
+    __riscv_vse64_v_u64m2(state[21], Ase, vl);
+    __riscv_vse64_v_u64m2(state[22], Asi, vl);
+    __riscv_vse64_v_u64m2(state[23], Aso, vl);
+    __riscv_vse64_v_u64m2(state[24], Asu, vl);
+}
+
+
+
+/*************************************************
+* Name:        load64
+*
+* Description: Load 8 bytes into uint64_t in little-endian order
+*
+* Arguments:   - const uint8_t *x: pointer to input byte array
+*
+* Returns the loaded 64-bit unsigned integer
+**************************************************/
+static inline uint64_t load64(const uint8_t *x) {
+    uint64_t r;
+    memcpy(&r, x, 8);
+    return r;
+}
+
+/*************************************************
+* Name:        keccakx4_absorb_once
+*
+* Description: Absorb step of Keccak on four inputs of equal length;
+*              non-incremental, starts by zeroeing the states.
+*
+* Arguments:   - uint64_t s[25][4]: pointer to (uninitialized) output Keccak states
+*              - unsigned int r: rate in bytes (e.g., 168 for SHAKE128)
+*              - const uint8_t *in[4]: pointers to the inputs
+*              - size_t inlen: length of each input in bytes
+*              - uint8_t p: domain-separation byte for different
+*                           Keccak-derived functions
+**************************************************/
+static
+void keccakx4_absorb_once(uint64_t s[25][4],
+                          unsigned int r,
+                          const uint8_t *const in[4],
+                          size_t inlen,
+                          uint8_t p) {
+    size_t i, j, pos = 0;
+    uint64_t t;
+
+    memset(s, 0, 25 * sizeof(s[0]));
+
+    while (inlen >= r) {
+        for (i = 0; i < r / 8; ++i) {
+            for (j = 0; j < 4; ++j)
+                s[i][j] ^= load64(&in[j][pos]);
+            pos += 8;
+        }
+
+        KeccakF1600_StatePermutex4(s);
+        inlen -= r;
+    }
+
+    for (i = 0; inlen >= 8; ++i) {
+        for (j = 0; j < 4; ++j)
+            s[i][j] ^= load64(&in[j][pos]);
+        pos += 8;
+        inlen -= 8;
+    }
+
+    // Últimos bytes e padding
+    for (j = 0; j < 4; ++j) {
+        t = 0;
+        memcpy(&t, &in[j][pos], inlen);
+        s[i][j] ^= t ^ ((uint64_t)p << (8 * inlen));
+        s[r / 8 - 1][j] ^= 1ULL << 63;
+    }
+}
+
+/*************************************************
+* Name:        keccakx4_squeezeblocks
+*
+* Description: Squeeze step of Keccak. Squeezes full blocks of r bytes
+*              from each of the four states. Modifies the states. Can be
+*              called multiple times to keep squeezing, i.e., is incremental.
+*
+* Arguments:   - uint8_t *out[4]: pointers to output blocks
+*              - size_t nblocks: number of blocks to be squeezed
+*              - unsigned int r: rate in bytes (e.g., 168 for SHAKE128)
+*              - uint64_t s[25][4]: pointer to input/output Keccak states
+**************************************************/
+static
+void keccakx4_squeezeblocks(uint8_t *const out[4],
+                            size_t nblocks,
+                            unsigned int r,
+                            uint64_t s[25][4]) {
+    unsigned int i, j;
+    size_t pos = 0;
+
+    while (nblocks > 0) {
+        KeccakF1600_StatePermutex4(s);
+
+        for (i = 0; i < r / 8; ++i)
+            for (j = 0; j < 4; ++j)
+                memcpy(&out[j][pos + 8 * i], &s[i][j], 8);
+
+        pos += r;
+        --nblocks;
+    }
+}
+
+/*************************************************
+* Name:        shake128x4_absorb_once
+*
+* Description: Absorb step of the SHAKE128 XOF on four inputs.
+*              non-incremental, starts by zeroeing the state.
+*
+* Arguments:   - keccakx4_state *state: pointer to (uninitialized) output
+*                                       Keccak state
+*              - const uint8_t *in0..in3: pointers to inputs
+*              - size_t inlen: length of each input in bytes
+**************************************************/
+void FIPS202X4_NAMESPACE(shake128x4_absorb_once)(keccakx4_state *state,
+                       const uint8_t *in0,
+                       const uint8_t *in1,
+                       const uint8_t *in2,
+                       const uint8_t *in3,
+                       size_t inlen) {
+    const uint8_t *in[4] = {in0, in1, in2, in3};
+
+    keccakx4_absorb_once(state->s, SHAKE128_RATE, in, inlen, 0x1F);
+}
+
+/*************************************************
+* Name:        shake128x4_squeezeblocks
+*
+* Description: Squeeze step of SHAKE128 XOF. Squeezes full blocks of
+*              SHAKE128_RATE bytes from each state. Modifies the state.
+*              Can be called multiple times to keep squeezing.
+*
+* Arguments:   - uint8_t *out0..out3: pointers to output blocks
+*              - size_t nblocks: number of blocks to be squeezed
+*              - keccakx4_state *state: pointer to input/output Keccak state
+**************************************************/
+void FIPS202X4_NAMESPACE(shake128x4_squeezeblocks)(uint8_t *out0,
+                              uint8_t *out1,
+                              uint8_t *out2,
+                              uint8_t *out3,
+                              size_t nblocks,
+                              keccakx4_state *state) {
+    uint8_t *out[4] = {out0, out1, out2, out3};
+
+    keccakx4_squeezeblocks(out, nblocks, SHAKE128_RATE, state->s);
+}
+
+/*************************************************
+* Name:        shake256x4_absorb_once
+*
+* Description: Absorb step of the SHAKE256 XOF on four inputs.
+*              non-incremental, starts by zeroeing the state.
+*
+* Arguments:   - keccakx4_state *state: pointer to (uninitialized) output
+*                                       Keccak state
+*              - const uint8_t *in0..in3: pointers to inputs
+*              - size_t inlen: length of each input in bytes
+**************************************************/
+void FIPS202X4_NAMESPACE(shake256x4_absorb_once)(keccakx4_state *state,
+                       const uint8_t *in0,
+                       const uint8_t *in1,
+                       const uint8_t *in2,
+                       const uint8_t *in3,
+                       size_t inlen) {
+    const uint8_t *in[4] = {in0, in1, in2, in3};
+
+    keccakx4_absorb_once(state->s, SHAKE256_RATE, in, inlen, 0x1F);
+}
+
+/*************************************************
+* Name:        shake256x4_squeezeblocks
+*
+* Description: Squeeze step of SHAKE256 XOF. Squeezes full blocks of
+*              SHAKE256_RATE bytes from each state. Modifies the state.
+*              Can be called multiple times to keep squeezing.
+*
+* Arguments:   - uint8_t *out0..out3: pointers to output blocks
+*              - size_t nblocks: number of blocks to be squeezed
+*              - keccakx4_state *state: pointer to input/output Keccak state
+**************************************************/
+void FIPS202X4_NAMESPACE(shake256x4_squeezeblocks)(uint8_t *out0,
+                              uint8_t *out1,
+                              uint8_t *out2,
+                              uint8_t *out3,
+                              size_t nblocks,
+                              keccakx4_state *state) {
+    uint8_t *out[4] = {out0, out1, out2, out3};
+
+    keccakx4_squeezeblocks(out, nblocks, SHAKE256_RATE, state->s);
+}
+
+/*************************************************
+* Name:        shake128x4
+*
+* Description: SHAKE128 XOF with non-incremental API on four inputs
+*
+* Arguments:   - uint8_t *out0..out3: pointers to outputs
+*              - size_t outlen: requested output length in bytes
+*              - const uint8_t *in0..in3: pointers to inputs
+*              - size_t inlen: length of each input in bytes
+**************************************************/
+void FIPS202X4_NAMESPACE(shake128x4)(uint8_t *out0,
+                uint8_t *out1,
+                uint8_t *out2,
+                uint8_t *out3,
+                size_t outlen,
+                const uint8_t *in0,
+                const uint8_t *in1,
+                const uint8_t *in2,
+                const uint8_t *in3,
+                size_t inlen) {
+    size_t nblocks = outlen / SHAKE128_RATE;
+    uint8_t t[4][SHAKE128_RATE];
+    keccakx4_state state;
+
+    FIPS202X4_NAMESPACE(shake128x4_absorb_once)(&state, in0, in1, in2, in3, inlen);
+    FIPS202X4_NAMESPACE(shake128x4_squeezeblocks)(out0, out1, out2, out3, nblocks, &state);
+
+    out0 += nblocks * SHAKE128_RATE;
+    out1 += nblocks * SHAKE128_RATE;
+    out2 += nblocks * SHAKE128_RATE;
+    out3 += nblocks * SHAKE128_RATE;
+    outlen -= nblocks * SHAKE128_RATE;
+
+    if (outlen) {
+        FIPS202X4_NAMESPACE(shake128x4_squeezeblocks)(t[0], t[1], t[2], t[3], 1, &state);
+        memcpy(out0, t[0], outlen);
+        memcpy(out1, t[1], outlen);
+        memcpy(out2, t[2], outlen);
+        memcpy(out3, t[3], outlen);
+    }
+}
+
+/*************************************************
+* Name:        shake256x4
+*
+* Description: SHAKE256 XOF with non-incremental API on four inputs
+*
+* Arguments:   - uint8_t *out0..out3: pointers to outputs
+*              - size_t outlen: requested output length in bytes
+*              - const uint8_t *in0..in3: pointers to inputs
+*              - size_t inlen: length of each input in bytes
+**************************************************/
+void FIPS202X4_NAMESPACE(shake256x4)(uint8_t *out0,
+                uint8_t *out1,
+                uint8_t *out2,
+                uint8_t *out3,
+                size_t outlen,
+                const uint8_t *in0,
+                const uint8_t *in1,
+                const uint8_t *in2,
+                const uint8_t *in3,
+                size_t inlen) {
+    size_t nblocks = outlen / SHAKE256_RATE;
+    uint8_t t[4][SHAKE256_RATE];
+    keccakx4_state state;
+
+    FIPS202X4_NAMESPACE(shake256x4_absorb_once)(&state, in0, in1, in2, in3, inlen);
+    FIPS202X4_NAMESPACE(shake256x4_squeezeblocks)(out0, out1, out2, out3, nblocks, &state);
+
+    out0 += nblocks * SHAKE256_RATE;
+    out1 += nblocks * SHAKE256_RATE;
+    out2 += nblocks * SHAKE256_RATE;
+    out3 += nblocks * SHAKE256_RATE;
+    outlen -= nblocks * SHAKE256_RATE;
+
+    if (outlen) {
+        FIPS202X4_NAMESPACE(shake256x4_squeezeblocks)(t[0], t[1], t[2], t[3], 1, &state);
+        memcpy(out0, t[0], outlen);
+        memcpy(out1, t[1], outlen);
+        memcpy(out2, t[2], outlen);
+        memcpy(out3, t[3], outlen);
+    }
+}
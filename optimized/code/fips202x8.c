@@ -0,0 +1,602 @@
+#include <immintrin.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "fips202x8.h"
+
+#define NROUNDS 24
+
+// Operações AVX-512 com os mesmos nomes usados nas versões NEON e AVX2
+// c = a ^ b
+#define vxor(c, a, b) c = _mm512_xor_si512(a, b);
+// Rotate by n bit: rotação nativa (vprolq)
+#define vROL(out, a, offset) \
+    out = _mm512_rol_epi64(a, offset);
+// Xor chain: out = a ^ b ^ c ^ d ^ e, com duas instruções ternárias (0x96 = a ^ b ^ c)
+#define vXOR4(out, a, b, c, d, e)                  \
+    out = _mm512_ternarylogic_epi64(a, b, c, 0x96); \
+    out = _mm512_ternarylogic_epi64(out, d, e, 0x96);
+// Xor Not And: out = a ^ ( (~b) & c), em uma instrução (0xD2)
+#define vXNA(out, a, b, c) \
+    out = _mm512_ternarylogic_epi64(a, b, c, 0xD2);
+// End Define
+
+/* Keccak round constants */
+static const uint64_t KeccakF_RoundConstants[NROUNDS] = {
+    (uint64_t)0x0000000000000001ULL,
+    (uint64_t)0x0000000000008082ULL,
+    (uint64_t)0x800000000000808aULL,
+    (uint64_t)0x8000000080008000ULL,
+    (uint64_t)0x000000000000808bULL,
+    (uint64_t)0x0000000080000001ULL,
+    (uint64_t)0x8000000080008081ULL,
+    (uint64_t)0x8000000000008009ULL,
+    (uint64_t)0x000000000000008aULL,
+    (uint64_t)0x0000000000000088ULL,
+    (uint64_t)0x0000000080008009ULL,
+    (uint64_t)0x000000008000000aULL,
+    (uint64_t)0x000000008000808bULL,
+    (uint64_t)0x800000000000008bULL,
+    (uint64_t)0x8000000000008089ULL,
+    (uint64_t)0x8000000000008003ULL,
+    (uint64_t)0x8000000000008002ULL,
+    (uint64_t)0x8000000000000080ULL,
+    (uint64_t)0x000000000000800aULL,
+    (uint64_t)0x800000008000000aULL,
+    (uint64_t)0x8000000080008081ULL,
+    (uint64_t)0x8000000000008080ULL,
+    (uint64_t)0x0000000080000001ULL,
+    (uint64_t)0x8000000080008008ULL
+};
+
+/*************************************************
+* Name:        KeccakF1600_StatePermutex8
+*
+* Description: The Keccak F1600 Permutation applied to eight interleaved
+*              states, one per 64-bit element of each AVX-512 register
+*
+* Arguments:   - __m512i *state: pointer to input/output Keccak states
+**************************************************/
+static
+void KeccakF1600_StatePermutex8(__m512i state[25]) {
+    __m512i Aba, Abe, Abi, Abo, Abu;
+    __m512i Aga, Age, Agi, Ago, Agu;
+    __m512i Aka, Ake, Aki, Ako, Aku;
+    __m512i Ama, Ame, Ami, Amo, Amu;
+    __m512i Asa, Ase, Asi, Aso, Asu;
+    __m512i BCa, BCe, BCi, BCo, BCu; // tmp
+    __m512i Da, De, Di, Do, Du;      // D
+    __m512i Eba, Ebe, Ebi, Ebo, Ebu;
+    __m512i Ega, Ege, Egi, Ego, Egu;
+    __m512i Eka, Eke, Eki, Eko, Eku;
+    __m512i Ema, Eme, Emi, Emo, Emu;
+    __m512i Esa, Ese, Esi, Eso, Esu;
+
+    //copyFromState(A, state)
+    Aba = state[0];
+    Abe = state[1];
+    Abi = state[2];
+    Abo = state[3];
+    Abu = state[4];
+    Aga = state[5];
+    Age = state[6];
+    Agi = state[7];
+    Ago = state[8];
+    Agu = state[9];
+    Aka = state[10];
+    Ake = state[11];
+    Aki = state[12];
+    Ako = state[13];
+    Aku = state[14];
+    Ama = state[15];
+    Ame = state[16];
+    Ami = state[17];
+    Amo = state[18];
+    Amu = state[19];
+    Asa = state[20];
+    Ase = state[21];
+    Asi = state[22];
+    Aso = state[23];
+    Asu = state[24];
+
+    for (int round = 0; round < NROUNDS; round += 2) {
+        //    prepareTheta
+        vXOR4(BCa, Aba, Aga, Aka, Ama, Asa);
+        vXOR4(BCe, Abe, Age, Ake, Ame, Ase);
+        vXOR4(BCi, Abi, Agi, Aki, Ami, Asi);
+        vXOR4(BCo, Abo, Ago, Ako, Amo, Aso);
+        vXOR4(BCu, Abu, Agu, Aku, Amu, Asu);
+
+        //thetaRhoPiChiIotaPrepareTheta(round  , A, E)
+        vROL(Da, BCe, 1);
+        vxor(Da, BCu, Da);
+        vROL(De, BCi, 1);
+        vxor(De, BCa, De);
+        vROL(Di, BCo, 1);
+        vxor(Di, BCe, Di);
+        vROL(Do, BCu, 1);
+        vxor(Do, BCi, Do);
+        vROL(Du, BCa, 1);
+        vxor(Du, BCo, Du);
+
+        vxor(Aba, Aba, Da);
+        vxor(Age, Age, De);
+        vROL(BCe, Age, 44);
+        vxor(Aki, Aki, Di);
+        vROL(BCi, Aki, 43);
+        vxor(Amo, Amo, Do);
+        vROL(BCo, Amo, 21);
+        vxor(Asu, Asu, Du);
+        vROL(BCu, Asu, 14);
+        vXNA(Eba, Aba, BCe, BCi);
+        vxor(Eba, Eba, _mm512_set1_epi64((long long)KeccakF_RoundConstants[round]));
+        vXNA(Ebe, BCe, BCi, BCo);
+        vXNA(Ebi, BCi, BCo, BCu);
+        vXNA(Ebo, BCo, BCu, Aba);
+        vXNA(Ebu, BCu, Aba, BCe);
+
+        vxor(Abo, Abo, Do);
+        vROL(BCa, Abo, 28);
+        vxor(Agu, Agu, Du);
+        vROL(BCe, Agu, 20);
+        vxor(Aka, Aka, Da);
+        vROL(BCi, Aka, 3);
+        vxor(Ame, Ame, De);
+        vROL(BCo, Ame, 45);
+        vxor(Asi, Asi, Di);
+        vROL(BCu, Asi, 61);
+        vXNA(Ega, BCa, BCe, BCi);
+        vXNA(Ege, BCe, BCi, BCo);
+        vXNA(Egi, BCi, BCo, BCu);
+        vXNA(Ego, BCo, BCu, BCa);
+        vXNA(Egu, BCu, BCa, BCe);
+
+        vxor(Abe, Abe, De);
+        vROL(BCa, Abe, 1);
+        vxor(Agi, Agi, Di);
+        vROL(BCe, Agi, 6);
+        vxor(Ako, Ako, Do);
+        vROL(BCi, Ako, 25);
+        vxor(Amu, Amu, Du);
+        vROL(BCo, Amu, 8);
+        vxor(Asa, Asa, Da);
+        vROL(BCu, Asa, 18);
+        vXNA(Eka, BCa, BCe, BCi);
+        vXNA(Eke, BCe, BCi, BCo);
+        vXNA(Eki, BCi, BCo, BCu);
+        vXNA(Eko, BCo, BCu, BCa);
+        vXNA(Eku, BCu, BCa, BCe);
+
+        vxor(Abu, Abu, Du);
+        vROL(BCa, Abu, 27);
+        vxor(Aga, Aga, Da);
+        vROL(BCe, Aga, 36);
+        vxor(Ake, Ake, De);
+        vROL(BCi, Ake, 10);
+        vxor(Ami, Ami, Di);
+        vROL(BCo, Ami, 15);
+        vxor(Aso, Aso, Do);
+        vROL(BCu, Aso, 56);
+        vXNA(Ema, BCa, BCe, BCi);
+        vXNA(Eme, BCe, BCi, BCo);
+        vXNA(Emi, BCi, BCo, BCu);
+        vXNA(Emo, BCo, BCu, BCa);
+        vXNA(Emu, BCu, BCa, BCe);
+
+        vxor(Abi, Abi, Di);
+        vROL(BCa, Abi, 62);
+        vxor(Ago, Ago, Do);
+        vROL(BCe, Ago, 55);
+        vxor(Aku, Aku, Du);
+        vROL(BCi, Aku, 39);
+        vxor(Ama, Ama, Da);
+        vROL(BCo, Ama, 41);
+        vxor(Ase, Ase, De);
+        vROL(BCu, Ase, 2);
+        vXNA(Esa, BCa, BCe, BCi);
+        vXNA(Ese, BCe, BCi, BCo);
+        vXNA(Esi, BCi, BCo, BCu);
+        vXNA(Eso, BCo, BCu, BCa);
+        vXNA(Esu, BCu, BCa, BCe);
+
+        // Next Round
+
+        //    prepareTheta
+        vXOR4(BCa, Eba, Ega, Eka, Ema, Esa);
+        vXOR4(BCe, Ebe, Ege, Eke, Eme, Ese);
+        vXOR4(BCi, Ebi, Egi, Eki, Emi, Esi);
+        vXOR4(BCo, Ebo, Ego, Eko, Emo, Eso);
+        vXOR4(BCu, Ebu, Egu, Eku, Emu, Esu);
+
+        //thetaRhoPiChiIotaPrepareTheta(round+1, E, A)
+        vROL(Da, BCe, 1);
+        vxor(Da, BCu, Da);
+        vROL(De, BCi, 1);
+        vxor(De, BCa, De);
+        vROL(Di, BCo, 1);
+        vxor(Di, BCe, Di);
+        vROL(Do, BCu, 1);
+        vxor(Do, BCi, Do);
+        vROL(Du, BCa, 1);
+        vxor(Du, BCo, Du);
+
+        vxor(Eba, Eba, Da);
+        vxor(Ege, Ege, De);
+        vROL(BCe, Ege, 44);
+        vxor(Eki, Eki, Di);
+        vROL(BCi, Eki, 43);
+        vxor(Emo, Emo, Do);
+        vROL(BCo, Emo, 21);
+        vxor(Esu, Esu, Du);
+        vROL(BCu, Esu, 14);
+        vXNA(Aba, Eba, BCe, BCi);
+        vxor(Aba, Aba, _mm512_set1_epi64((long long)KeccakF_RoundConstants[round + 1]));
+        vXNA(Abe, BCe, BCi, BCo);
+        vXNA(Abi, BCi, BCo, BCu);
+        vXNA(Abo, BCo, BCu, Eba);
+        vXNA(Abu, BCu, Eba, BCe);
+
+        vxor(Ebo, Ebo, Do);
+        vROL(BCa, Ebo, 28);
+        vxor(Egu, Egu, Du);
+        vROL(BCe, Egu, 20);
+        vxor(Eka, Eka, Da);
+        vROL(BCi, Eka, 3);
+        vxor(Eme, Eme, De);
+        vROL(BCo, Eme, 45);
+        vxor(Esi, Esi, Di);
+        vROL(BCu, Esi, 61);
+        vXNA(Aga, BCa, BCe, BCi);
+        vXNA(Age, BCe, BCi, BCo);
+        vXNA(Agi, BCi, BCo, BCu);
+        vXNA(Ago, BCo, BCu, BCa);
+        vXNA(Agu, BCu, BCa, BCe);
+
+        vxor(Ebe, Ebe, De);
+        vROL(BCa, Ebe, 1);
+        vxor(Egi, Egi, Di);
+        vROL(BCe, Egi, 6);
+        vxor(Eko, Eko, Do);
+        vROL(BCi, Eko, 25);
+        vxor(Emu, Emu, Du);
+        vROL(BCo, Emu, 8);
+        vxor(Esa, Esa, Da);
+        vROL(BCu, Esa, 18);
+        vXNA(Aka, BCa, BCe, BCi);
+        vXNA(Ake, BCe, BCi, BCo);
+        vXNA(Aki, BCi, BCo, BCu);
+        vXNA(Ako, BCo, BCu, BCa);
+        vXNA(Aku, BCu, BCa, BCe);
+
+        vxor(Ebu, Ebu, Du);
+        vROL(BCa, Ebu, 27);
+        vxor(Ega, Ega, Da);
+        vROL(BCe, Ega, 36);
+        vxor(Eke, Eke, De);
+        vROL(BCi, Eke, 10);
+        vxor(Emi, Emi, Di);
+        vROL(BCo, Emi, 15);
+        vxor(Eso, Eso, Do);
+        vROL(BCu, Eso, 56);
+        vXNA(Ama, BCa, BCe, BCi);
+        vXNA(Ame, BCe, BCi, BCo);
+        vXNA(Ami, BCi, BCo, BCu);
+        vXNA(Amo, BCo, BCu, BCa);
+        vXNA(Amu, BCu, BCa, BCe);
+
+        vxor(Ebi, Ebi, Di);
+        vROL(BCa, Ebi, 62);
+        vxor(Ego, Ego, Do);
+        vROL(BCe, Ego, 55);
+        vxor(Eku, Eku, Du);
+        vROL(BCi, Eku, 39);
+        vxor(Ema, Ema, Da);
+        vROL(BCo, Ema, 41);
+        vxor(Ese, Ese, De);
+        vROL(BCu, Ese, 2);
+        vXNA(Asa, BCa, BCe, BCi);
+        vXNA(Ase, BCe, BCi, BCo);
+        vXNA(Asi, BCi, BCo, BCu);
+        vXNA(Aso, BCo, BCu, BCa);
+        vXNA(Asu, BCu, BCa, BCe);
+    }
+
+    state[0] = Aba;
+    state[1] = Abe;
+    state[2] = Abi;
+    state[3] = Abo;
+    state[4] = Abu;
+    state[5] = Aga;
+    state[6] = Age;
+    state[7] = Agi;
+    state[8] = Ago;
+    state[9] = Agu;
+    state[10] = Aka;
+    state[11] = Ake;
+    state[12] = Aki;
+    state[13] = Ako;
+    state[14] = Aku;
+    state[15] = Ama;
+    state[16] = Ame;
+    state[17] = Ami;
+    state[18] = Amo;
+    state[19] = Amu;
+    state[20] = Asa;
+    state[21] = Ase;
+    state[22] = Asi;
+    state[23] = Aso;
+    state[24] = Asu;
+}
+
+/*************************************************
+* Name:        load64
+*
+* Description: Load 8 bytes into uint64_t in little-endian order
+*
+* Arguments:   - const uint8_t *x: pointer to input byte array
+*
+* Returns the loaded 64-bit unsigned integer
+**************************************************/
+static inline uint64_t load64(const uint8_t *x) {
+    uint64_t r;
+    memcpy(&r, x, 8);
+    return r;
+}
+
+/*************************************************
+* Name:        load64x8
+*
+* Description: Gather the 64-bit word at byte offset pos of eight inputs
+*              into one register, input j in element j
+*
+* Arguments:   - const uint8_t *in[8]: pointers to the inputs
+*              - size_t pos: byte offset
+*
+* Returns the interleaved words
+**************************************************/
+static inline __m512i load64x8(const uint8_t *const in[8], size_t pos) {
+    return _mm512_set_epi64((long long)load64(&in[7][pos]), (long long)load64(&in[6][pos]),
+                            (long long)load64(&in[5][pos]), (long long)load64(&in[4][pos]),
+                            (long long)load64(&in[3][pos]), (long long)load64(&in[2][pos]),
+                            (long long)load64(&in[1][pos]), (long long)load64(&in[0][pos]));
+}
+
+/*************************************************
+* Name:        keccakx8_absorb_once
+*
+* Description: Absorb step of Keccak on eight inputs of equal length;
+*              non-incremental, starts by zeroeing the states.
+*
+* Arguments:   - __m512i *s: pointer to (uninitialized) output Keccak states
+*              - unsigned int r: rate in bytes (e.g., 168 for SHAKE128)
+*              - const uint8_t *in[8]: pointers to the inputs
+*              - size_t inlen: length of each input in bytes
+*              - uint8_t p: domain-separation byte for different
+*                           Keccak-derived functions
+**************************************************/
+static
+void keccakx8_absorb_once(__m512i s[25],
+                          unsigned int r,
+                          const uint8_t *const in[8],
+                          size_t inlen,
+                          uint8_t p) {
+    size_t i, j, pos = 0;
+    uint64_t t[8];
+    __m512i tmp;
+
+    for (i = 0; i < 25; ++i)
+        s[i] = _mm512_setzero_si512();
+
+    while (inlen >= r) {
+        for (i = 0; i < r / 8; ++i) {
+            tmp = load64x8(in, pos);
+            vxor(s[i], s[i], tmp);
+            pos += 8;
+        }
+
+        KeccakF1600_StatePermutex8(s);
+        inlen -= r;
+    }
+
+    for (i = 0; inlen >= 8; ++i) {
+        tmp = load64x8(in, pos);
+        vxor(s[i], s[i], tmp);
+        pos += 8;
+        inlen -= 8;
+    }
+
+    // Últimos bytes e padding: copiar para faixas zeradas em vez de ler além do fim da entrada
+    memset(t, 0, sizeof(t));
+    for (j = 0; j < 8; ++j)
+        memcpy(&t[j], &in[j][pos], inlen);
+    tmp = _mm512_loadu_si512(t);
+    vxor(s[i], s[i], tmp);
+
+    tmp = _mm512_set1_epi64((long long)((uint64_t)p << (8 * inlen)));
+    vxor(s[i], s[i], tmp);
+
+    tmp = _mm512_set1_epi64((long long)(1ULL << 63));
+    vxor(s[r / 8 - 1], s[r / 8 - 1], tmp);
+}
+
+/*************************************************
+* Name:        keccakx8_squeezeblocks
+*
+* Description: Squeeze step of Keccak. Squeezes full blocks of r bytes
+*              from each of the eight states. Modifies the states. Can be
+*              called multiple times to keep squeezing, i.e., is incremental.
+*
+* Arguments:   - uint8_t *out[8]: pointers to output blocks; advanced by
+*                                 nblocks*r bytes
+*              - size_t nblocks: number of blocks to be squeezed
+*              - unsigned int r: rate in bytes (e.g., 168 for SHAKE128)
+*              - __m512i *s: pointer to input/output Keccak states
+**************************************************/
+static
+void keccakx8_squeezeblocks(uint8_t *out[8],
+                            size_t nblocks,
+                            unsigned int r,
+                            __m512i s[25]) {
+    unsigned int i, j;
+    uint64_t t[8];
+
+    while (nblocks > 0) {
+        KeccakF1600_StatePermutex8(s);
+
+        for (i = 0; i < r / 8; ++i) {
+            _mm512_storeu_si512(t, s[i]);
+            for (j = 0; j < 8; ++j)
+                memcpy(&out[j][8 * i], &t[j], 8);
+        }
+
+        for (j = 0; j < 8; ++j)
+            out[j] += r;
+
+        --nblocks;
+    }
+}
+
+/*************************************************
+* Name:        keccakx8
+*
+* Description: Keccak-based XOF with non-incremental API on eight inputs
+*
+* Arguments:   - uint8_t *out[8]: pointers to outputs
+*              - size_t outlen: requested output length in bytes
+*              - unsigned int r: rate in bytes
+*              - const uint8_t *in[8]: pointers to inputs
+*              - size_t inlen: length of each input in bytes
+*              - uint8_t p: domain-separation byte
+**************************************************/
+static
+void keccakx8(uint8_t *const out[8],
+              size_t outlen,
+              unsigned int r,
+              const uint8_t *const in[8],
+              size_t inlen,
+              uint8_t p) {
+    size_t j, nblocks = outlen / r;
+    uint8_t t[8][SHAKE128_RATE];
+    uint8_t *o[8];
+    __m512i s[25];
+
+    for (j = 0; j < 8; ++j)
+        o[j] = out[j];
+
+    keccakx8_absorb_once(s, r, in, inlen, p);
+    keccakx8_squeezeblocks(o, nblocks, r, s);
+    outlen -= nblocks * r;
+
+    if (outlen) {
+        uint8_t *tp[8];
+        for (j = 0; j < 8; ++j)
+            tp[j] = t[j];
+        keccakx8_squeezeblocks(tp, 1, r, s);
+        for (j = 0; j < 8; ++j)
+            memcpy(o[j], t[j], outlen);
+    }
+}
+
+/*************************************************
+* Name:        shake128x8_absorb_once
+*
+* Description: Absorb step of the SHAKE128 XOF on eight inputs.
+*              non-incremental, starts by zeroeing the state.
+*
+* Arguments:   - keccakx8_state *state: pointer to (uninitialized) output
+*                                       Keccak state
+*              - const uint8_t *in[8]: pointers to inputs
+*              - size_t inlen: length of each input in bytes
+**************************************************/
+void FIPS202X8_NAMESPACE(shake128x8_absorb_once)(keccakx8_state *state,
+                       const uint8_t *const in[8],
+                       size_t inlen) {
+    keccakx8_absorb_once(state->s, SHAKE128_RATE, in, inlen, 0x1F);
+}
+
+/*************************************************
+* Name:        shake128x8_squeezeblocks
+*
+* Description: Squeeze step of SHAKE128 XOF. Squeezes full blocks of
+*              SHAKE128_RATE bytes from each state. Modifies the state.
+*              Can be called multiple times to keep squeezing.
+*
+* Arguments:   - uint8_t *out[8]: pointers to output blocks; advanced by
+*                                 nblocks*SHAKE128_RATE bytes
+*              - size_t nblocks: number of blocks to be squeezed
+*              - keccakx8_state *state: pointer to input/output Keccak state
+**************************************************/
+void FIPS202X8_NAMESPACE(shake128x8_squeezeblocks)(uint8_t *out[8],
+                              size_t nblocks,
+                              keccakx8_state *state) {
+    keccakx8_squeezeblocks(out, nblocks, SHAKE128_RATE, state->s);
+}
+
+/*************************************************
+* Name:        shake256x8_absorb_once
+*
+* Description: Absorb step of the SHAKE256 XOF on eight inputs.
+*              non-incremental, starts by zeroeing the state.
+*
+* Arguments:   - keccakx8_state *state: pointer to (uninitialized) output
+*                                       Keccak state
+*              - const uint8_t *in[8]: pointers to inputs
+*              - size_t inlen: length of each input in bytes
+**************************************************/
+void FIPS202X8_NAMESPACE(shake256x8_absorb_once)(keccakx8_state *state,
+                       const uint8_t *const in[8],
+                       size_t inlen) {
+    keccakx8_absorb_once(state->s, SHAKE256_RATE, in, inlen, 0x1F);
+}
+
+/*************************************************
+* Name:        shake256x8_squeezeblocks
+*
+* Description: Squeeze step of SHAKE256 XOF. Squeezes full blocks of
+*              SHAKE256_RATE bytes from each state. Modifies the state.
+*              Can be called multiple times to keep squeezing.
+*
+* Arguments:   - uint8_t *out[8]: pointers to output blocks; advanced by
+*                                 nblocks*SHAKE256_RATE bytes
+*              - size_t nblocks: number of blocks to be squeezed
+*              - keccakx8_state *state: pointer to input/output Keccak state
+**************************************************/
+void FIPS202X8_NAMESPACE(shake256x8_squeezeblocks)(uint8_t *out[8],
+                              size_t nblocks,
+                              keccakx8_state *state) {
+    keccakx8_squeezeblocks(out, nblocks, SHAKE256_RATE, state->s);
+}
+
+/*************************************************
+* Name:        shake128x8
+*
+* Description: SHAKE128 XOF with non-incremental API on eight inputs
+*
+* Arguments:   - uint8_t *out[8]: pointers to outputs
+*              - size_t outlen: requested output length in bytes
+*              - const uint8_t *in[8]: pointers to inputs
+*              - size_t inlen: length of each input in bytes
+**************************************************/
+void FIPS202X8_NAMESPACE(shake128x8)(uint8_t *const out[8],
+                size_t outlen,
+                const uint8_t *const in[8],
+                size_t inlen) {
+    keccakx8(out, outlen, SHAKE128_RATE, in, inlen, 0x1F);
+}
+
+/*************************************************
+* Name:        shake256x8
+*
+* Description: SHAKE256 XOF with non-incremental API on eight inputs
+*
+* Arguments:   - uint8_t *out[8]: pointers to outputs
+*              - size_t outlen: requested output length in bytes
+*              - const uint8_t *in[8]: pointers to inputs
+*              - size_t inlen: length of each input in bytes
+**************************************************/
+void FIPS202X8_NAMESPACE(shake256x8)(uint8_t *const out[8],
+                size_t outlen,
+                const uint8_t *const in[8],
+                size_t inlen) {
+    keccakx8(out, outlen, SHAKE256_RATE, in, inlen, 0x1F);
+}
@@ -0,0 +1,48 @@
+#ifndef FIPS202X8_H
+#define FIPS202X8_H
+
+#ifndef FIPS202X8_NAMESPACE
+#define FIPS202X8_NAMESPACE(s) dilithium_fips202x8_##s
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <immintrin.h>
+
+#define SHAKE128_RATE 168
+#define SHAKE256_RATE 136
+
+/* Oito estados Keccak intercalados: a faixa i dos oito estados
+ * ocupa os oito elementos de 64 bits de s[i]. */
+typedef struct {
+    __m512i s[25];
+} keccakx8_state;
+
+
+void FIPS202X8_NAMESPACE(shake128x8_absorb_once)(keccakx8_state *state,
+                            const uint8_t *const in[8],
+                            size_t inlen);
+
+void FIPS202X8_NAMESPACE(shake128x8_squeezeblocks)(uint8_t *out[8],
+                              size_t nblocks,
+                              keccakx8_state *state);
+
+void FIPS202X8_NAMESPACE(shake256x8_absorb_once)(keccakx8_state *state,
+                            const uint8_t *const in[8],
+                            size_t inlen);
+
+void FIPS202X8_NAMESPACE(shake256x8_squeezeblocks)(uint8_t *out[8],
+                              size_t nblocks,
+                              keccakx8_state *state);
+
+void FIPS202X8_NAMESPACE(shake128x8)(uint8_t *const out[8],
+                size_t outlen,
+                const uint8_t *const in[8],
+                size_t inlen);
+
+void FIPS202X8_NAMESPACE(shake256x8)(uint8_t *const out[8],
+                size_t outlen,
+                const uint8_t *const in[8],
+                size_t inlen);
+
+#endif
@@ -0,0 +1,189 @@
+#ifndef MLDSA_HPP
+#define MLDSA_HPP
+
+/* Interface C++20 para os três conjuntos de parâmetros em um único
+ * processo: ML-DSA-44, ML-DSA-65 e ML-DSA-87 são tipos distintos
+ * (mldsa::ml_dsa_44, ml_dsa_65, ml_dsa_87) sobre a biblioteca
+ * libpqcrystals_dilithium_ref (make shared), que contém os três modos
+ * compilados com -DDILITHIUM_MODE=2/3/5 e prefixos distintos.
+ *
+ * Os tamanhos são constexpr derivados de <K, L, ETA, TAU, GAMMA1, GAMMA2,
+ * OMEGA> como em params.h, e a escolha do núcleo é feita com if constexpr
+ * sobre o tipo exato do conjunto de parâmetros.
+ * Cada núcleo é compilado com K e L como constantes, de modo que os laços
+ * de polyvec.c e sign.c continuam com limites conhecidos na compilação. */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+extern "C" {
+#include "api.h"
+
+#define MLDSA_DECLARE(ns)                                                      \
+  int ns##_keypair(uint8_t *pk, uint8_t *sk);                                  \
+  int ns##_signature(uint8_t *sig, size_t *siglen,                             \
+                     const uint8_t *m, size_t mlen,                            \
+                     const uint8_t *ctx, size_t ctxlen,                        \
+                     const uint8_t *sk);                                       \
+  int ns##_verify(const uint8_t *sig, size_t siglen,                           \
+                  const uint8_t *m, size_t mlen,                               \
+                  const uint8_t *ctx, size_t ctxlen,                           \
+                  const uint8_t *pk);
+
+MLDSA_DECLARE(dilithium2_everaldo)
+MLDSA_DECLARE(dilithium3_everaldo)
+MLDSA_DECLARE(dilithium5_everaldo)
+
+#undef MLDSA_DECLARE
+}
+
+namespace mldsa {
+
+inline constexpr std::int32_t Q = 8380417;
+inline constexpr std::size_t SEEDBYTES = 32;
+inline constexpr std::size_t TRBYTES = 64;
+
+/*************************************************
+* Name:        params
+*
+* Description: Compile-time parameter set, with the packed sizes of
+*              params.h derived from the FIPS 204 parameters.
+**************************************************/
+template <unsigned K_, unsigned L_, unsigned ETA_, unsigned TAU_,
+          std::int32_t GAMMA1_, std::int32_t GAMMA2_, unsigned OMEGA_>
+struct params {
+  static constexpr unsigned K = K_;
+  static constexpr unsigned L = L_;
+  static constexpr unsigned ETA = ETA_;
+  static constexpr unsigned TAU = TAU_;
+  static constexpr std::int32_t GAMMA1 = GAMMA1_;
+  static constexpr std::int32_t GAMMA2 = GAMMA2_;
+  static constexpr unsigned OMEGA = OMEGA_;
+
+  static_assert(ETA == 2 || ETA == 4);
+  static_assert(GAMMA1 == (1 << 17) || GAMMA1 == (1 << 19));
+  static_assert(GAMMA2 == (Q - 1)/88 || GAMMA2 == (Q - 1)/32);
+
+  // lambda/4 bytes: 128, 192 ou 256 bits de segurança para K = 4, 6, 8
+  static constexpr std::size_t CTILDEBYTES = 8*K;
+  static constexpr std::size_t POLYT1_PACKEDBYTES = 320;
+  static constexpr std::size_t POLYT0_PACKEDBYTES = 416;
+  static constexpr std::size_t POLYZ_PACKEDBYTES = GAMMA1 == (1 << 17) ? 576 : 640;
+  static constexpr std::size_t POLYW1_PACKEDBYTES = GAMMA2 == (Q - 1)/88 ? 192 : 128;
+  static constexpr std::size_t POLYETA_PACKEDBYTES = ETA == 2 ? 96 : 128;
+  static constexpr std::size_t POLYVECH_PACKEDBYTES = OMEGA + K;
+
+  static constexpr std::size_t PUBLICKEYBYTES = SEEDBYTES + K*POLYT1_PACKEDBYTES;
+  static constexpr std::size_t SECRETKEYBYTES = 2*SEEDBYTES + TRBYTES
+                                              + L*POLYETA_PACKEDBYTES
+                                              + K*POLYETA_PACKEDBYTES
+                                              + K*POLYT0_PACKEDBYTES;
+  static constexpr std::size_t BYTES = CTILDEBYTES + L*POLYZ_PACKEDBYTES
+                                     + POLYVECH_PACKEDBYTES;
+};
+
+using params_44 = params<4, 4, 2, 39, (1 << 17), (Q - 1)/88, 80>;
+using params_65 = params<6, 5, 4, 49, (1 << 19), (Q - 1)/32, 55>;
+using params_87 = params<8, 7, 2, 60, (1 << 19), (Q - 1)/32, 75>;
+
+static_assert(params_44::PUBLICKEYBYTES == pqcrystals_dilithium2_PUBLICKEYBYTES);
+static_assert(params_44::SECRETKEYBYTES == pqcrystals_dilithium2_SECRETKEYBYTES);
+static_assert(params_44::BYTES == pqcrystals_dilithium2_BYTES);
+static_assert(params_65::PUBLICKEYBYTES == pqcrystals_dilithium3_PUBLICKEYBYTES);
+static_assert(params_65::SECRETKEYBYTES == pqcrystals_dilithium3_SECRETKEYBYTES);
+static_assert(params_65::BYTES == pqcrystals_dilithium3_BYTES);
+static_assert(params_87::PUBLICKEYBYTES == pqcrystals_dilithium5_PUBLICKEYBYTES);
+static_assert(params_87::SECRETKEYBYTES == pqcrystals_dilithium5_SECRETKEYBYTES);
+static_assert(params_87::BYTES == pqcrystals_dilithium5_BYTES);
+
+// Falso dependente de P, para que o static_assert do último ramo só seja
+// avaliado quando o ramo é instanciado
+template <class>
+inline constexpr bool dependent_false = false;
+
+/*************************************************
+* Name:        ml_dsa
+*
+* Description: Key generation, signing and verification for parameter
+*              set P. Keys and signatures are fixed-size spans, so a
+*              buffer of the wrong level does not compile. Only the
+*              three FIPS 204 parameter sets are accepted. The return
+*              values follow sign.h: 0 on success, -1 on failure
+*              (context string longer than 255 bytes, invalid signature).
+**************************************************/
+template <class P>
+class ml_dsa {
+  static_assert(std::is_same_v<P, params_44> || std::is_same_v<P, params_65> ||
+                std::is_same_v<P, params_87>,
+                "ml_dsa: P must be params_44, params_65 or params_87");
+
+public:
+  using params_type = P;
+
+  static constexpr std::size_t public_key_bytes = P::PUBLICKEYBYTES;
+  static constexpr std::size_t secret_key_bytes = P::SECRETKEYBYTES;
+  static constexpr std::size_t signature_bytes = P::BYTES;
+
+  using public_key = std::array<std::uint8_t, public_key_bytes>;
+  using secret_key = std::array<std::uint8_t, secret_key_bytes>;
+  using signature = std::array<std::uint8_t, signature_bytes>;
+
+  [[nodiscard]] static int keypair(std::span<std::uint8_t, public_key_bytes> pk,
+                                   std::span<std::uint8_t, secret_key_bytes> sk) {
+    if constexpr (std::is_same_v<P, params_44>)
+      return dilithium2_everaldo_keypair(pk.data(), sk.data());
+    else if constexpr (std::is_same_v<P, params_65>)
+      return dilithium3_everaldo_keypair(pk.data(), sk.data());
+    else if constexpr (std::is_same_v<P, params_87>)
+      return dilithium5_everaldo_keypair(pk.data(), sk.data());
+    else
+      static_assert(dependent_false<P>, "ml_dsa: unsupported parameter set");
+  }
+
+  [[nodiscard]] static int sign(std::span<std::uint8_t, signature_bytes> sig,
+                                std::span<const std::uint8_t> m,
+                                std::span<const std::uint8_t> ctx,
+                                std::span<const std::uint8_t, secret_key_bytes> sk) {
+    std::size_t siglen;
+
+    if constexpr (std::is_same_v<P, params_44>)
+      return dilithium2_everaldo_signature(sig.data(), &siglen, m.data(), m.size(),
+                                           ctx.data(), ctx.size(), sk.data());
+    else if constexpr (std::is_same_v<P, params_65>)
+      return dilithium3_everaldo_signature(sig.data(), &siglen, m.data(), m.size(),
+                                           ctx.data(), ctx.size(), sk.data());
+    else if constexpr (std::is_same_v<P, params_87>)
+      return dilithium5_everaldo_signature(sig.data(), &siglen, m.data(), m.size(),
+                                           ctx.data(), ctx.size(), sk.data());
+    else
+      static_assert(dependent_false<P>, "ml_dsa: unsupported parameter set");
+  }
+
+  [[nodiscard]] static bool verify(std::span<const std::uint8_t, signature_bytes> sig,
+                                   std::span<const std::uint8_t> m,
+                                   std::span<const std::uint8_t> ctx,
+                                   std::span<const std::uint8_t, public_key_bytes> pk) {
+    if constexpr (std::is_same_v<P, params_44>)
+      return dilithium2_everaldo_verify(sig.data(), sig.size(), m.data(), m.size(),
+                                        ctx.data(), ctx.size(), pk.data()) == 0;
+    else if constexpr (std::is_same_v<P, params_65>)
+      return dilithium3_everaldo_verify(sig.data(), sig.size(), m.data(), m.size(),
+                                        ctx.data(), ctx.size(), pk.data()) == 0;
+    else if constexpr (std::is_same_v<P, params_87>)
+      return dilithium5_everaldo_verify(sig.data(), sig.size(), m.data(), m.size(),
+                                        ctx.data(), ctx.size(), pk.data()) == 0;
+    else
+      static_assert(dependent_false<P>, "ml_dsa: unsupported parameter set");
+  }
+};
+
+using ml_dsa_44 = ml_dsa<params_44>;
+using ml_dsa_65 = ml_dsa<params_65>;
+using ml_dsa_87 = ml_dsa<params_87>;
+
+} // namespace mldsa
+
+#endif
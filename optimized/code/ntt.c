@@ -94,7 +94,7 @@ void ntt(int32_t a[N]) {
 }
 */
 
-void ntt(int32_t a[N]) {
+static void ntt_neon(int32_t a[N]) {
     unsigned int len, start, j, k;
     int32_t zeta;
     k = 0;
@@ -127,12 +127,6 @@ void ntt(int32_t a[N]) {
 
                 vst1q_s32(&a[j + len + 4], vsubq_s32(a_vec2, t_vec2));
                 vst1q_s32(&a[j + 4], vaddq_s32(a_vec2, t_vec2));
-
-                // Máscara para garantir o ajuste dos coeficientes (Butterfly 2)
-                int64_t w9 = (int64_t)a[j + len] * zeta;
-                int64_t t = montgomery_reduce(w9);
-                a[j + len] = a[j] - t;
-                a[j] = a[j] + t;
             }
         }
     }
@@ -153,7 +147,7 @@ void ntt(int32_t a[N]) {
 
 
 // Função de INTT radix-2 otimizada com NEON
-void invntt_tomont(int32_t a[N]) {
+static void invntt_tomont_neon(int32_t a[N]) {
     unsigned int len, start, j, k;
     int32_t zeta;
     const int32_t f = 41978;  // mont^2 / 256
@@ -224,3 +218,50 @@ void invntt_tomont(int32_t a[N]) {
         vst1q_s32(&a[j + 4], reduced_vec.val[1]);
     }
 }
+
+#if defined(POLY_SVE_DISPATCH)
+static void (*ntt_impl)(int32_t a[N]) = ntt_neon;
+static void (*invntt_tomont_impl)(int32_t a[N]) = invntt_tomont_neon;
+
+// Escolhe a NTT uma única vez, ao carregar o binário/biblioteca
+__attribute__((constructor))
+static void ntt_dispatch(void) {
+    if(dilithium_cpu_features() & CPU_FEATURE_SVE) {
+        ntt_impl = ntt_sve;
+        invntt_tomont_impl = invntt_tomont_sve;
+    }
+}
+#endif
+
+/*************************************************
+* Name:        ntt
+*
+* Description: Forward NTT, in-place. Uses the SVE version of ntt_sve.c
+*              when, with DILITHIUM_RUNTIME_DISPATCH, the running core
+*              supports it; both give bit-identical output.
+*
+* Arguments:   - int32_t a[N]: input/output coefficient array
+**************************************************/
+void ntt(int32_t a[N]) {
+#if defined(POLY_SVE_DISPATCH)
+    ntt_impl(a);
+#else
+    ntt_neon(a);
+#endif
+}
+
+/*************************************************
+* Name:        invntt_tomont
+*
+* Description: Inverse NTT and multiplication by Montgomery factor 2^32,
+*              in-place. Dispatched like ntt.
+*
+* Arguments:   - int32_t a[N]: input/output coefficient array
+**************************************************/
+void invntt_tomont(int32_t a[N]) {
+#if defined(POLY_SVE_DISPATCH)
+    invntt_tomont_impl(a);
+#else
+    invntt_tomont_neon(a);
+#endif
+}
@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 #include "params.h"
+#include "cpu.h"
 
 #define ntt DILITHIUM_NAMESPACE(ntt)
 void ntt(int32_t a[N]);
@@ -10,4 +11,12 @@ void ntt(int32_t a[N]);
 #define invntt_tomont DILITHIUM_NAMESPACE(invntt_tomont)
 void invntt_tomont(int32_t a[N]);
 
+#if defined(POLY_SVE_STATIC) || defined(POLY_SVE_DISPATCH)
+#define ntt_sve DILITHIUM_NAMESPACE(ntt_sve)
+void ntt_sve(int32_t a[N]);
+
+#define invntt_tomont_sve DILITHIUM_NAMESPACE(invntt_tomont_sve)
+void invntt_tomont_sve(int32_t a[N]);
+#endif
+
 #endif
@@ -0,0 +1,299 @@
+#include <stdint.h>
+#include <immintrin.h>
+#include "params.h"
+#include "ntt.h"
+#include "reduce.h"
+#include "reduce_avx2.h"
+
+static const int32_t zetas[N] = {
+         0,    25847, -2608894,  -518909,   237124,  -777960,  -876248,   466468,
+   1826347,  2353451,  -359251, -2091905,  3119733, -2884855,  3111497,  2680103,
+   2725464,  1024112, -1079900,  3585928,  -549488, -1119584,  2619752, -2108549,
+  -2118186, -3859737, -1399561, -3277672,  1757237,   -19422,  4010497,   280005,
+   2706023,    95776,  3077325,  3530437, -1661693, -3592148, -2537516,  3915439,
+  -3861115, -3043716,  3574422, -2867647,  3539968,  -300467,  2348700,  -539299,
+  -1699267, -1643818,  3505694, -3821735,  3507263, -2140649, -1600420,  3699596,
+    811944,   531354,   954230,  3881043,  3900724, -2556880,  2071892, -2797779,
+  -3930395, -1528703, -3677745, -3041255, -1452451,  3475950,  2176455, -1585221,
+  -1257611,  1939314, -4083598, -1000202, -3190144, -3157330, -3632928,   126922,
+   3412210,  -983419,  2147896,  2715295, -2967645, -3693493,  -411027, -2477047,
+   -671102, -1228525,   -22981, -1308169,  -381987,  1349076,  1852771, -1430430,
+  -3343383,   264944,   508951,  3097992,    44288, -1100098,   904516,  3958618,
+  -3724342,    -8578,  1653064, -3249728,  2389356,  -210977,   759969, -1316856,
+    189548, -3553272,  3159746, -1851402, -2409325,  -177440,  1315589,  1341330,
+   1285669, -1584928,  -812732, -1439742, -3019102, -3881060, -3628969,  3839961,
+   2091667,  3407706,  2316500,  3817976, -3342478,  2244091, -2446433, -3562462,
+    266997,  2434439, -1235728,  3513181, -3520352, -3759364, -1197226, -3193378,
+    900702,  1859098,   909542,   819034,   495491, -1613174,   -43260,  -522500,
+   -655327, -3122442,  2031748,  3207046, -3556995,  -525098,  -768622, -3595838,
+    342297,   286988, -2437823,  4108315,  3437287, -3342277,  1735879,   203044,
+   2842341,  2691481, -2590150,  1265009,  4055324,  1247620,  2486353,  1595974,
+  -3767016,  1250494,  2635921, -3548272, -2994039,  1869119,  1903435, -1050970,
+  -1333058,  1237275, -3318210, -1430225,  -451100,  1312455,  3306115, -1962642,
+  -1279661,  1917081, -2546312, -1374803,  1500165,   777191,  2235880,  3406031,
+   -542412, -2831860, -1671176, -1846953, -2584293, -3724270,   594136, -3776993,
+  -2013608,  2432395,  2454455,  -164721,  1957272,  3369112,   185531, -1207385,
+  -3183426,   162844,  1616392,  3014001,   810149,  1652634, -3694233, -1799107,
+  -3038916,  3523897,  3866901,   269760,  2213111,  -975884,  1717735,   472078,
+   -426683,  1723600, -1803090,  1910376, -1667432, -1104333,  -260646, -3833893,
+  -2939036, -2235985,  -420899, -2286327,   183443,  -976891,  1612842, -3545687,
+   -554416,  3919660,   -48306, -1362209,  3937738,  1400424,  -846154,  1976782
+};
+
+
+/* Raízes das três últimas camadas (len = 4, 2, 1) da NTT direta, já na
+ * ordem em que os coeficientes ficam nos registradores após a
+ * transposição de cada bloco de 16 coeficientes: 24 valores por bloco. */
+static const int32_t zetas_low[3*N/2] = {
+   2706023,  2706023,  2706023,  2706023,    95776,    95776,    95776,    95776,
+  -3930395, -3930395, -3677745, -3677745, -1528703, -1528703, -3041255, -3041255,
+   2091667,  3407706, -3342478,  2244091,  2316500,  3817976, -2446433, -3562462,
+   3077325,  3077325,  3077325,  3077325,  3530437,  3530437,  3530437,  3530437,
+  -1452451, -1452451,  2176455,  2176455,  3475950,  3475950, -1585221, -1585221,
+    266997,  2434439, -3520352, -3759364, -1235728,  3513181, -1197226, -3193378,
+  -1661693, -1661693, -1661693, -1661693, -3592148, -3592148, -3592148, -3592148,
+  -1257611, -1257611, -4083598, -4083598,  1939314,  1939314, -1000202, -1000202,
+    900702,  1859098,   495491, -1613174,   909542,   819034,   -43260,  -522500,
+  -2537516, -2537516, -2537516, -2537516,  3915439,  3915439,  3915439,  3915439,
+  -3190144, -3190144, -3632928, -3632928, -3157330, -3157330,   126922,   126922,
+   -655327, -3122442, -3556995,  -525098,  2031748,  3207046,  -768622, -3595838,
+  -3861115, -3861115, -3861115, -3861115, -3043716, -3043716, -3043716, -3043716,
+   3412210,  3412210,  2147896,  2147896,  -983419,  -983419,  2715295,  2715295,
+    342297,   286988,  3437287, -3342277, -2437823,  4108315,  1735879,   203044,
+   3574422,  3574422,  3574422,  3574422, -2867647, -2867647, -2867647, -2867647,
+  -2967645, -2967645,  -411027,  -411027, -3693493, -3693493, -2477047, -2477047,
+   2842341,  2691481,  4055324,  1247620, -2590150,  1265009,  2486353,  1595974,
+   3539968,  3539968,  3539968,  3539968,  -300467,  -300467,  -300467,  -300467,
+   -671102,  -671102,   -22981,   -22981, -1228525, -1228525, -1308169, -1308169,
+  -3767016,  1250494, -2994039,  1869119,  2635921, -3548272,  1903435, -1050970,
+   2348700,  2348700,  2348700,  2348700,  -539299,  -539299,  -539299,  -539299,
+   -381987,  -381987,  1852771,  1852771,  1349076,  1349076, -1430430, -1430430,
+  -1333058,  1237275,  -451100,  1312455, -3318210, -1430225,  3306115, -1962642,
+  -1699267, -1699267, -1699267, -1699267, -1643818, -1643818, -1643818, -1643818,
+  -3343383, -3343383,   508951,   508951,   264944,   264944,  3097992,  3097992,
+  -1279661,  1917081,  1500165,   777191, -2546312, -1374803,  2235880,  3406031,
+   3505694,  3505694,  3505694,  3505694, -3821735, -3821735, -3821735, -3821735,
+     44288,    44288,   904516,   904516, -1100098, -1100098,  3958618,  3958618,
+   -542412, -2831860, -2584293, -3724270, -1671176, -1846953,   594136, -3776993,
+   3507263,  3507263,  3507263,  3507263, -2140649, -2140649, -2140649, -2140649,
+  -3724342, -3724342,  1653064,  1653064,    -8578,    -8578, -3249728, -3249728,
+  -2013608,  2432395,  1957272,  3369112,  2454455,  -164721,   185531, -1207385,
+  -1600420, -1600420, -1600420, -1600420,  3699596,  3699596,  3699596,  3699596,
+   2389356,  2389356,   759969,   759969,  -210977,  -210977, -1316856, -1316856,
+  -3183426,   162844,   810149,  1652634,  1616392,  3014001, -3694233, -1799107,
+    811944,   811944,   811944,   811944,   531354,   531354,   531354,   531354,
+    189548,   189548,  3159746,  3159746, -3553272, -3553272, -1851402, -1851402,
+  -3038916,  3523897,  2213111,  -975884,  3866901,   269760,  1717735,   472078,
+    954230,   954230,   954230,   954230,  3881043,  3881043,  3881043,  3881043,
+  -2409325, -2409325,  1315589,  1315589,  -177440,  -177440,  1341330,  1341330,
+   -426683,  1723600, -1667432, -1104333, -1803090,  1910376,  -260646, -3833893,
+   3900724,  3900724,  3900724,  3900724, -2556880, -2556880, -2556880, -2556880,
+   1285669,  1285669,  -812732,  -812732, -1584928, -1584928, -1439742, -1439742,
+  -2939036, -2235985,   183443,  -976891,  -420899, -2286327,  1612842, -3545687,
+   2071892,  2071892,  2071892,  2071892, -2797779, -2797779, -2797779, -2797779,
+  -3019102, -3019102, -3628969, -3628969, -3881060, -3881060,  3839961,  3839961,
+   -554416,  3919660,  3937738,  1400424,   -48306, -1362209,  -846154,  1976782
+};
+
+/* O mesmo para as três primeiras camadas (len = 1, 2, 4) da inversa,
+ * com os sinais já trocados (-zetas). */
+static const int32_t zetas_inv_low[3*N/2] = {
+  -1976782,   846154,  1362209,    48306, -1400424, -3937738, -3919660,   554416,
+  -3839961, -3839961,  3881060,  3881060,  3628969,  3628969,  3019102,  3019102,
+   2797779,  2797779,  2797779,  2797779, -2071892, -2071892, -2071892, -2071892,
+   3545687, -1612842,  2286327,   420899,   976891,  -183443,  2235985,  2939036,
+   1439742,  1439742,  1584928,  1584928,   812732,   812732, -1285669, -1285669,
+   2556880,  2556880,  2556880,  2556880, -3900724, -3900724, -3900724, -3900724,
+   3833893,   260646, -1910376,  1803090,  1104333,  1667432, -1723600,   426683,
+  -1341330, -1341330,   177440,   177440, -1315589, -1315589,  2409325,  2409325,
+  -3881043, -3881043, -3881043, -3881043,  -954230,  -954230,  -954230,  -954230,
+   -472078, -1717735,  -269760, -3866901,   975884, -2213111, -3523897,  3038916,
+   1851402,  1851402,  3553272,  3553272, -3159746, -3159746,  -189548,  -189548,
+   -531354,  -531354,  -531354,  -531354,  -811944,  -811944,  -811944,  -811944,
+   1799107,  3694233, -3014001, -1616392, -1652634,  -810149,  -162844,  3183426,
+   1316856,  1316856,   210977,   210977,  -759969,  -759969, -2389356, -2389356,
+  -3699596, -3699596, -3699596, -3699596,  1600420,  1600420,  1600420,  1600420,
+   1207385,  -185531,   164721, -2454455, -3369112, -1957272, -2432395,  2013608,
+   3249728,  3249728,     8578,     8578, -1653064, -1653064,  3724342,  3724342,
+   2140649,  2140649,  2140649,  2140649, -3507263, -3507263, -3507263, -3507263,
+   3776993,  -594136,  1846953,  1671176,  3724270,  2584293,  2831860,   542412,
+  -3958618, -3958618,  1100098,  1100098,  -904516,  -904516,   -44288,   -44288,
+   3821735,  3821735,  3821735,  3821735, -3505694, -3505694, -3505694, -3505694,
+  -3406031, -2235880,  1374803,  2546312,  -777191, -1500165, -1917081,  1279661,
+  -3097992, -3097992,  -264944,  -264944,  -508951,  -508951,  3343383,  3343383,
+   1643818,  1643818,  1643818,  1643818,  1699267,  1699267,  1699267,  1699267,
+   1962642, -3306115,  1430225,  3318210, -1312455,   451100, -1237275,  1333058,
+   1430430,  1430430, -1349076, -1349076, -1852771, -1852771,   381987,   381987,
+    539299,   539299,   539299,   539299, -2348700, -2348700, -2348700, -2348700,
+   1050970, -1903435,  3548272, -2635921, -1869119,  2994039, -1250494,  3767016,
+   1308169,  1308169,  1228525,  1228525,    22981,    22981,   671102,   671102,
+    300467,   300467,   300467,   300467, -3539968, -3539968, -3539968, -3539968,
+  -1595974, -2486353, -1265009,  2590150, -1247620, -4055324, -2691481, -2842341,
+   2477047,  2477047,  3693493,  3693493,   411027,   411027,  2967645,  2967645,
+   2867647,  2867647,  2867647,  2867647, -3574422, -3574422, -3574422, -3574422,
+   -203044, -1735879, -4108315,  2437823,  3342277, -3437287,  -286988,  -342297,
+  -2715295, -2715295,   983419,   983419, -2147896, -2147896, -3412210, -3412210,
+   3043716,  3043716,  3043716,  3043716,  3861115,  3861115,  3861115,  3861115,
+   3595838,   768622, -3207046, -2031748,   525098,  3556995,  3122442,   655327,
+   -126922,  -126922,  3157330,  3157330,  3632928,  3632928,  3190144,  3190144,
+  -3915439, -3915439, -3915439, -3915439,  2537516,  2537516,  2537516,  2537516,
+    522500,    43260,  -819034,  -909542,  1613174,  -495491, -1859098,  -900702,
+   1000202,  1000202, -1939314, -1939314,  4083598,  4083598,  1257611,  1257611,
+   3592148,  3592148,  3592148,  3592148,  1661693,  1661693,  1661693,  1661693,
+   3193378,  1197226, -3513181,  1235728,  3759364,  3520352, -2434439,  -266997,
+   1585221,  1585221, -3475950, -3475950, -2176455, -2176455,  1452451,  1452451,
+  -3530437, -3530437, -3530437, -3530437, -3077325, -3077325, -3077325, -3077325,
+   3562462,  2446433, -3817976, -2316500, -2244091,  3342478, -3407706, -2091667,
+   3041255,  3041255,  1528703,  1528703,  3677745,  3677745,  3930395,  3930395,
+    -95776,   -95776,   -95776,   -95776, -2706023, -2706023, -2706023, -2706023
+};
+
+// Borboleta Cooley-Tukey: t = zeta*b*2^-32; (a, b) <- (a + t, a - t)
+#define CT_BUTTERFLY(a, b, zeta) do {          \
+    __m256i t_ = montgomery_mul_avx2(zeta, b); \
+    b = _mm256_sub_epi32(a, t_);               \
+    a = _mm256_add_epi32(a, t_);               \
+  } while(0)
+
+// Borboleta Gentleman-Sande: (a, b) <- (a + b, zeta*(a - b)*2^-32)
+#define GS_BUTTERFLY(a, b, zeta) do {          \
+    __m256i t_ = a;                            \
+    a = _mm256_add_epi32(t_, b);               \
+    b = _mm256_sub_epi32(t_, b);               \
+    b = montgomery_mul_avx2(zeta, b);          \
+  } while(0)
+
+/*************************************************
+* Name:        ntt
+*
+* Description: Forward NTT, in-place. No modular reduction is performed
+*              after additions or subtractions. Output vector is in
+*              bitreversed order. Same butterflies and roots as the NEON
+*              version, so the output is bit-identical.
+*
+* Arguments:   - int32_t a[N]: input/output coefficient array
+**************************************************/
+void ntt(int32_t a[N]) {
+    unsigned int len, start, j, k, i;
+    __m256i zeta, x, y, lo, hi;
+    k = 0;
+
+    // Camadas len >= 8: 8 coeficientes por registrador, zeta replicado
+    for (len = 128; len >= 8; len >>= 1) {
+        for (start = 0; start < N; start += 2 * len) {
+            zeta = _mm256_set1_epi32(zetas[++k]);
+
+            for (j = start; j < start + len; j += 8) {
+                x = _mm256_loadu_si256((const __m256i *)&a[j]);
+                y = _mm256_loadu_si256((const __m256i *)&a[j + len]);
+                CT_BUTTERFLY(x, y, zeta);
+                _mm256_storeu_si256((__m256i *)&a[j], x);
+                _mm256_storeu_si256((__m256i *)&a[j + len], y);
+            }
+        }
+    }
+
+    // Camadas len = 4, 2, 1: cada bloco de 16 coeficientes é transposto
+    // para que os pares da borboleta fiquem em registradores distintos
+    for (i = 0; i < N / 16; ++i) {
+        const int32_t *zl = &zetas_low[24 * i];
+
+        x = _mm256_loadu_si256((const __m256i *)&a[16 * i]);
+        y = _mm256_loadu_si256((const __m256i *)&a[16 * i + 8]);
+
+        // len = 4: lo = (a0..a3, a8..a11), hi = (a4..a7, a12..a15)
+        lo = _mm256_permute2x128_si256(x, y, 0x20);
+        hi = _mm256_permute2x128_si256(x, y, 0x31);
+        CT_BUTTERFLY(lo, hi, _mm256_loadu_si256((const __m256i *)&zl[0]));
+        x = _mm256_permute2x128_si256(lo, hi, 0x20);
+        y = _mm256_permute2x128_si256(lo, hi, 0x31);
+
+        // len = 2: pares de 64 bits
+        lo = _mm256_unpacklo_epi64(x, y);
+        hi = _mm256_unpackhi_epi64(x, y);
+        CT_BUTTERFLY(lo, hi, _mm256_loadu_si256((const __m256i *)&zl[8]));
+        x = _mm256_unpacklo_epi64(lo, hi);
+        y = _mm256_unpackhi_epi64(lo, hi);
+
+        // len = 1: posições pares em lo, ímpares em hi
+        lo = _mm256_castps_si256(_mm256_shuffle_ps(_mm256_castsi256_ps(x), _mm256_castsi256_ps(y), 0x88));
+        hi = _mm256_castps_si256(_mm256_shuffle_ps(_mm256_castsi256_ps(x), _mm256_castsi256_ps(y), 0xDD));
+        CT_BUTTERFLY(lo, hi, _mm256_loadu_si256((const __m256i *)&zl[16]));
+        x = _mm256_unpacklo_epi32(lo, hi);
+        y = _mm256_unpackhi_epi32(lo, hi);
+
+        _mm256_storeu_si256((__m256i *)&a[16 * i], x);
+        _mm256_storeu_si256((__m256i *)&a[16 * i + 8], y);
+    }
+}
+
+/*************************************************
+* Name:        invntt_tomont
+*
+* Description: Inverse NTT and multiplication by Montgomery factor 2^32.
+*              In-place. No modular reductions after additions or
+*              subtractions; input coefficients need to be smaller than
+*              Q in absolute value. Output coefficient are smaller than Q in
+*              absolute value. Bit-identical to the NEON version.
+*
+* Arguments:   - int32_t a[N]: input/output coefficient array
+**************************************************/
+void invntt_tomont(int32_t a[N]) {
+    unsigned int len, start, j, k, i;
+    __m256i zeta, x, y, lo, hi;
+    const __m256i f = _mm256_set1_epi32(41978);  // mont^2 / 256
+
+    // Camadas len = 1, 2, 4 em blocos de 16 coeficientes
+    for (i = 0; i < N / 16; ++i) {
+        const int32_t *zl = &zetas_inv_low[24 * i];
+
+        x = _mm256_loadu_si256((const __m256i *)&a[16 * i]);
+        y = _mm256_loadu_si256((const __m256i *)&a[16 * i + 8]);
+
+        // len = 1
+        lo = _mm256_castps_si256(_mm256_shuffle_ps(_mm256_castsi256_ps(x), _mm256_castsi256_ps(y), 0x88));
+        hi = _mm256_castps_si256(_mm256_shuffle_ps(_mm256_castsi256_ps(x), _mm256_castsi256_ps(y), 0xDD));
+        GS_BUTTERFLY(lo, hi, _mm256_loadu_si256((const __m256i *)&zl[0]));
+        x = _mm256_unpacklo_epi32(lo, hi);
+        y = _mm256_unpackhi_epi32(lo, hi);
+
+        // len = 2
+        lo = _mm256_unpacklo_epi64(x, y);
+        hi = _mm256_unpackhi_epi64(x, y);
+        GS_BUTTERFLY(lo, hi, _mm256_loadu_si256((const __m256i *)&zl[8]));
+        x = _mm256_unpacklo_epi64(lo, hi);
+        y = _mm256_unpackhi_epi64(lo, hi);
+
+        // len = 4
+        lo = _mm256_permute2x128_si256(x, y, 0x20);
+        hi = _mm256_permute2x128_si256(x, y, 0x31);
+        GS_BUTTERFLY(lo, hi, _mm256_loadu_si256((const __m256i *)&zl[16]));
+        x = _mm256_permute2x128_si256(lo, hi, 0x20);
+        y = _mm256_permute2x128_si256(lo, hi, 0x31);
+
+        _mm256_storeu_si256((__m256i *)&a[16 * i], x);
+        _mm256_storeu_si256((__m256i *)&a[16 * i + 8], y);
+    }
+
+    // Camadas len >= 8
+    k = 32;
+    for (len = 8; len <= 128; len <<= 1) {
+        for (start = 0; start < N; start += 2 * len) {
+            zeta = _mm256_set1_epi32(-zetas[--k]);
+
+            for (j = start; j < start + len; j += 8) {
+                x = _mm256_loadu_si256((const __m256i *)&a[j]);
+                y = _mm256_loadu_si256((const __m256i *)&a[j + len]);
+                GS_BUTTERFLY(x, y, zeta);
+                _mm256_storeu_si256((__m256i *)&a[j], x);
+                _mm256_storeu_si256((__m256i *)&a[j + len], y);
+            }
+        }
+    }
+
+    // Multiplicação final por mont^2 / 256
+    for (j = 0; j < N; j += 8) {
+        x = _mm256_loadu_si256((const __m256i *)&a[j]);
+        _mm256_storeu_si256((__m256i *)&a[j], montgomery_mul_avx2(f, x));
+    }
+}
@@ -0,0 +1,340 @@
+#include <stdint.h>
+#include <immintrin.h>
+#include "params.h"
+#include "ntt.h"
+#include "reduce.h"
+#include "reduce_avx512.h"
+
+static const int32_t zetas[N] = {
+         0,    25847, -2608894,  -518909,   237124,  -777960,  -876248,   466468,
+   1826347,  2353451,  -359251, -2091905,  3119733, -2884855,  3111497,  2680103,
+   2725464,  1024112, -1079900,  3585928,  -549488, -1119584,  2619752, -2108549,
+  -2118186, -3859737, -1399561, -3277672,  1757237,   -19422,  4010497,   280005,
+   2706023,    95776,  3077325,  3530437, -1661693, -3592148, -2537516,  3915439,
+  -3861115, -3043716,  3574422, -2867647,  3539968,  -300467,  2348700,  -539299,
+  -1699267, -1643818,  3505694, -3821735,  3507263, -2140649, -1600420,  3699596,
+    811944,   531354,   954230,  3881043,  3900724, -2556880,  2071892, -2797779,
+  -3930395, -1528703, -3677745, -3041255, -1452451,  3475950,  2176455, -1585221,
+  -1257611,  1939314, -4083598, -1000202, -3190144, -3157330, -3632928,   126922,
+   3412210,  -983419,  2147896,  2715295, -2967645, -3693493,  -411027, -2477047,
+   -671102, -1228525,   -22981, -1308169,  -381987,  1349076,  1852771, -1430430,
+  -3343383,   264944,   508951,  3097992,    44288, -1100098,   904516,  3958618,
+  -3724342,    -8578,  1653064, -3249728,  2389356,  -210977,   759969, -1316856,
+    189548, -3553272,  3159746, -1851402, -2409325,  -177440,  1315589,  1341330,
+   1285669, -1584928,  -812732, -1439742, -3019102, -3881060, -3628969,  3839961,
+   2091667,  3407706,  2316500,  3817976, -3342478,  2244091, -2446433, -3562462,
+    266997,  2434439, -1235728,  3513181, -3520352, -3759364, -1197226, -3193378,
+    900702,  1859098,   909542,   819034,   495491, -1613174,   -43260,  -522500,
+   -655327, -3122442,  2031748,  3207046, -3556995,  -525098,  -768622, -3595838,
+    342297,   286988, -2437823,  4108315,  3437287, -3342277,  1735879,   203044,
+   2842341,  2691481, -2590150,  1265009,  4055324,  1247620,  2486353,  1595974,
+  -3767016,  1250494,  2635921, -3548272, -2994039,  1869119,  1903435, -1050970,
+  -1333058,  1237275, -3318210, -1430225,  -451100,  1312455,  3306115, -1962642,
+  -1279661,  1917081, -2546312, -1374803,  1500165,   777191,  2235880,  3406031,
+   -542412, -2831860, -1671176, -1846953, -2584293, -3724270,   594136, -3776993,
+  -2013608,  2432395,  2454455,  -164721,  1957272,  3369112,   185531, -1207385,
+  -3183426,   162844,  1616392,  3014001,   810149,  1652634, -3694233, -1799107,
+  -3038916,  3523897,  3866901,   269760,  2213111,  -975884,  1717735,   472078,
+   -426683,  1723600, -1803090,  1910376, -1667432, -1104333,  -260646, -3833893,
+  -2939036, -2235985,  -420899, -2286327,   183443,  -976891,  1612842, -3545687,
+   -554416,  3919660,   -48306, -1362209,  3937738,  1400424,  -846154,  1976782
+};
+
+
+/* Raízes das camadas len = 8, 4, 2, 1 da NTT direta na ordem dos
+ * registradores (lo, hi) de cada bloco de 32 coeficientes: 64 por bloco.
+ * A camada len = 16 usa um único zeta por bloco, replicado. */
+static const int32_t zetas_low[2*N] = {
+   2725464,  2725464,  2725464,  2725464,  2725464,  2725464,  2725464,  2725464,
+   1024112,  1024112,  1024112,  1024112,  1024112,  1024112,  1024112,  1024112,
+   2706023,  2706023,  2706023,  2706023,    95776,    95776,    95776,    95776,
+   3077325,  3077325,  3077325,  3077325,  3530437,  3530437,  3530437,  3530437,
+  -3930395, -3930395, -1528703, -1528703, -3677745, -3677745, -3041255, -3041255,
+  -1452451, -1452451,  3475950,  3475950,  2176455,  2176455, -1585221, -1585221,
+   2091667,  3407706,  2316500,  3817976, -3342478,  2244091, -2446433, -3562462,
+    266997,  2434439, -1235728,  3513181, -3520352, -3759364, -1197226, -3193378,
+  -1079900, -1079900, -1079900, -1079900, -1079900, -1079900, -1079900, -1079900,
+   3585928,  3585928,  3585928,  3585928,  3585928,  3585928,  3585928,  3585928,
+  -1661693, -1661693, -1661693, -1661693, -3592148, -3592148, -3592148, -3592148,
+  -2537516, -2537516, -2537516, -2537516,  3915439,  3915439,  3915439,  3915439,
+  -1257611, -1257611,  1939314,  1939314, -4083598, -4083598, -1000202, -1000202,
+  -3190144, -3190144, -3157330, -3157330, -3632928, -3632928,   126922,   126922,
+    900702,  1859098,   909542,   819034,   495491, -1613174,   -43260,  -522500,
+   -655327, -3122442,  2031748,  3207046, -3556995,  -525098,  -768622, -3595838,
+   -549488,  -549488,  -549488,  -549488,  -549488,  -549488,  -549488,  -549488,
+  -1119584, -1119584, -1119584, -1119584, -1119584, -1119584, -1119584, -1119584,
+  -3861115, -3861115, -3861115, -3861115, -3043716, -3043716, -3043716, -3043716,
+   3574422,  3574422,  3574422,  3574422, -2867647, -2867647, -2867647, -2867647,
+   3412210,  3412210,  -983419,  -983419,  2147896,  2147896,  2715295,  2715295,
+  -2967645, -2967645, -3693493, -3693493,  -411027,  -411027, -2477047, -2477047,
+    342297,   286988, -2437823,  4108315,  3437287, -3342277,  1735879,   203044,
+   2842341,  2691481, -2590150,  1265009,  4055324,  1247620,  2486353,  1595974,
+   2619752,  2619752,  2619752,  2619752,  2619752,  2619752,  2619752,  2619752,
+  -2108549, -2108549, -2108549, -2108549, -2108549, -2108549, -2108549, -2108549,
+   3539968,  3539968,  3539968,  3539968,  -300467,  -300467,  -300467,  -300467,
+   2348700,  2348700,  2348700,  2348700,  -539299,  -539299,  -539299,  -539299,
+   -671102,  -671102, -1228525, -1228525,   -22981,   -22981, -1308169, -1308169,
+   -381987,  -381987,  1349076,  1349076,  1852771,  1852771, -1430430, -1430430,
+  -3767016,  1250494,  2635921, -3548272, -2994039,  1869119,  1903435, -1050970,
+  -1333058,  1237275, -3318210, -1430225,  -451100,  1312455,  3306115, -1962642,
+  -2118186, -2118186, -2118186, -2118186, -2118186, -2118186, -2118186, -2118186,
+  -3859737, -3859737, -3859737, -3859737, -3859737, -3859737, -3859737, -3859737,
+  -1699267, -1699267, -1699267, -1699267, -1643818, -1643818, -1643818, -1643818,
+   3505694,  3505694,  3505694,  3505694, -3821735, -3821735, -3821735, -3821735,
+  -3343383, -3343383,   264944,   264944,   508951,   508951,  3097992,  3097992,
+     44288,    44288, -1100098, -1100098,   904516,   904516,  3958618,  3958618,
+  -1279661,  1917081, -2546312, -1374803,  1500165,   777191,  2235880,  3406031,
+   -542412, -2831860, -1671176, -1846953, -2584293, -3724270,   594136, -3776993,
+  -1399561, -1399561, -1399561, -1399561, -1399561, -1399561, -1399561, -1399561,
+  -3277672, -3277672, -3277672, -3277672, -3277672, -3277672, -3277672, -3277672,
+   3507263,  3507263,  3507263,  3507263, -2140649, -2140649, -2140649, -2140649,
+  -1600420, -1600420, -1600420, -1600420,  3699596,  3699596,  3699596,  3699596,
+  -3724342, -3724342,    -8578,    -8578,  1653064,  1653064, -3249728, -3249728,
+   2389356,  2389356,  -210977,  -210977,   759969,   759969, -1316856, -1316856,
+  -2013608,  2432395,  2454455,  -164721,  1957272,  3369112,   185531, -1207385,
+  -3183426,   162844,  1616392,  3014001,   810149,  1652634, -3694233, -1799107,
+   1757237,  1757237,  1757237,  1757237,  1757237,  1757237,  1757237,  1757237,
+    -19422,   -19422,   -19422,   -19422,   -19422,   -19422,   -19422,   -19422,
+    811944,   811944,   811944,   811944,   531354,   531354,   531354,   531354,
+    954230,   954230,   954230,   954230,  3881043,  3881043,  3881043,  3881043,
+    189548,   189548, -3553272, -3553272,  3159746,  3159746, -1851402, -1851402,
+  -2409325, -2409325,  -177440,  -177440,  1315589,  1315589,  1341330,  1341330,
+  -3038916,  3523897,  3866901,   269760,  2213111,  -975884,  1717735,   472078,
+   -426683,  1723600, -1803090,  1910376, -1667432, -1104333,  -260646, -3833893,
+   4010497,  4010497,  4010497,  4010497,  4010497,  4010497,  4010497,  4010497,
+    280005,   280005,   280005,   280005,   280005,   280005,   280005,   280005,
+   3900724,  3900724,  3900724,  3900724, -2556880, -2556880, -2556880, -2556880,
+   2071892,  2071892,  2071892,  2071892, -2797779, -2797779, -2797779, -2797779,
+   1285669,  1285669, -1584928, -1584928,  -812732,  -812732, -1439742, -1439742,
+  -3019102, -3019102, -3881060, -3881060, -3628969, -3628969,  3839961,  3839961,
+  -2939036, -2235985,  -420899, -2286327,   183443,  -976891,  1612842, -3545687,
+   -554416,  3919660,   -48306, -1362209,  3937738,  1400424,  -846154,  1976782
+};
+
+/* O mesmo para as camadas len = 1, 2, 4, 8 da inversa, com os sinais já
+ * trocados (-zetas). */
+static const int32_t zetas_inv_low[2*N] = {
+  -1976782,   846154, -1400424, -3937738,  1362209,    48306, -3919660,   554416,
+   3545687, -1612842,   976891,  -183443,  2286327,   420899,  2235985,  2939036,
+  -3839961, -3839961,  3628969,  3628969,  3881060,  3881060,  3019102,  3019102,
+   1439742,  1439742,   812732,   812732,  1584928,  1584928, -1285669, -1285669,
+   2797779,  2797779,  2797779,  2797779, -2071892, -2071892, -2071892, -2071892,
+   2556880,  2556880,  2556880,  2556880, -3900724, -3900724, -3900724, -3900724,
+   -280005,  -280005,  -280005,  -280005,  -280005,  -280005,  -280005,  -280005,
+  -4010497, -4010497, -4010497, -4010497, -4010497, -4010497, -4010497, -4010497,
+   3833893,   260646,  1104333,  1667432, -1910376,  1803090, -1723600,   426683,
+   -472078, -1717735,   975884, -2213111,  -269760, -3866901, -3523897,  3038916,
+  -1341330, -1341330, -1315589, -1315589,   177440,   177440,  2409325,  2409325,
+   1851402,  1851402, -3159746, -3159746,  3553272,  3553272,  -189548,  -189548,
+  -3881043, -3881043, -3881043, -3881043,  -954230,  -954230,  -954230,  -954230,
+   -531354,  -531354,  -531354,  -531354,  -811944,  -811944,  -811944,  -811944,
+     19422,    19422,    19422,    19422,    19422,    19422,    19422,    19422,
+  -1757237, -1757237, -1757237, -1757237, -1757237, -1757237, -1757237, -1757237,
+   1799107,  3694233, -1652634,  -810149, -3014001, -1616392,  -162844,  3183426,
+   1207385,  -185531, -3369112, -1957272,   164721, -2454455, -2432395,  2013608,
+   1316856,  1316856,  -759969,  -759969,   210977,   210977, -2389356, -2389356,
+   3249728,  3249728, -1653064, -1653064,     8578,     8578,  3724342,  3724342,
+  -3699596, -3699596, -3699596, -3699596,  1600420,  1600420,  1600420,  1600420,
+   2140649,  2140649,  2140649,  2140649, -3507263, -3507263, -3507263, -3507263,
+   3277672,  3277672,  3277672,  3277672,  3277672,  3277672,  3277672,  3277672,
+   1399561,  1399561,  1399561,  1399561,  1399561,  1399561,  1399561,  1399561,
+   3776993,  -594136,  3724270,  2584293,  1846953,  1671176,  2831860,   542412,
+  -3406031, -2235880,  -777191, -1500165,  1374803,  2546312, -1917081,  1279661,
+  -3958618, -3958618,  -904516,  -904516,  1100098,  1100098,   -44288,   -44288,
+  -3097992, -3097992,  -508951,  -508951,  -264944,  -264944,  3343383,  3343383,
+   3821735,  3821735,  3821735,  3821735, -3505694, -3505694, -3505694, -3505694,
+   1643818,  1643818,  1643818,  1643818,  1699267,  1699267,  1699267,  1699267,
+   3859737,  3859737,  3859737,  3859737,  3859737,  3859737,  3859737,  3859737,
+   2118186,  2118186,  2118186,  2118186,  2118186,  2118186,  2118186,  2118186,
+   1962642, -3306115, -1312455,   451100,  1430225,  3318210, -1237275,  1333058,
+   1050970, -1903435, -1869119,  2994039,  3548272, -2635921, -1250494,  3767016,
+   1430430,  1430430, -1852771, -1852771, -1349076, -1349076,   381987,   381987,
+   1308169,  1308169,    22981,    22981,  1228525,  1228525,   671102,   671102,
+    539299,   539299,   539299,   539299, -2348700, -2348700, -2348700, -2348700,
+    300467,   300467,   300467,   300467, -3539968, -3539968, -3539968, -3539968,
+   2108549,  2108549,  2108549,  2108549,  2108549,  2108549,  2108549,  2108549,
+  -2619752, -2619752, -2619752, -2619752, -2619752, -2619752, -2619752, -2619752,
+  -1595974, -2486353, -1247620, -4055324, -1265009,  2590150, -2691481, -2842341,
+   -203044, -1735879,  3342277, -3437287, -4108315,  2437823,  -286988,  -342297,
+   2477047,  2477047,   411027,   411027,  3693493,  3693493,  2967645,  2967645,
+  -2715295, -2715295, -2147896, -2147896,   983419,   983419, -3412210, -3412210,
+   2867647,  2867647,  2867647,  2867647, -3574422, -3574422, -3574422, -3574422,
+   3043716,  3043716,  3043716,  3043716,  3861115,  3861115,  3861115,  3861115,
+   1119584,  1119584,  1119584,  1119584,  1119584,  1119584,  1119584,  1119584,
+    549488,   549488,   549488,   549488,   549488,   549488,   549488,   549488,
+   3595838,   768622,   525098,  3556995, -3207046, -2031748,  3122442,   655327,
+    522500,    43260,  1613174,  -495491,  -819034,  -909542, -1859098,  -900702,
+   -126922,  -126922,  3632928,  3632928,  3157330,  3157330,  3190144,  3190144,
+   1000202,  1000202,  4083598,  4083598, -1939314, -1939314,  1257611,  1257611,
+  -3915439, -3915439, -3915439, -3915439,  2537516,  2537516,  2537516,  2537516,
+   3592148,  3592148,  3592148,  3592148,  1661693,  1661693,  1661693,  1661693,
+  -3585928, -3585928, -3585928, -3585928, -3585928, -3585928, -3585928, -3585928,
+   1079900,  1079900,  1079900,  1079900,  1079900,  1079900,  1079900,  1079900,
+   3193378,  1197226,  3759364,  3520352, -3513181,  1235728, -2434439,  -266997,
+   3562462,  2446433, -2244091,  3342478, -3817976, -2316500, -3407706, -2091667,
+   1585221,  1585221, -2176455, -2176455, -3475950, -3475950,  1452451,  1452451,
+   3041255,  3041255,  3677745,  3677745,  1528703,  1528703,  3930395,  3930395,
+  -3530437, -3530437, -3530437, -3530437, -3077325, -3077325, -3077325, -3077325,
+    -95776,   -95776,   -95776,   -95776, -2706023, -2706023, -2706023, -2706023,
+  -1024112, -1024112, -1024112, -1024112, -1024112, -1024112, -1024112, -1024112,
+  -2725464, -2725464, -2725464, -2725464, -2725464, -2725464, -2725464, -2725464
+};
+
+/* Índices de _mm512_permutex2var_epi32 sobre (lo, hi) de um bloco de 32
+ * coeficientes. Na camada len, lo guarda as posições p com (p & len) == 0
+ * e hi as posições p + len; a ordem natural é a da camada len = 16. */
+static const int32_t perm_idx[6][2][16] = {
+  // len 16 <-> len 8
+  {{0, 1, 2, 3, 4, 5, 6, 7, 16, 17, 18, 19, 20, 21, 22, 23},
+   {8, 9, 10, 11, 12, 13, 14, 15, 24, 25, 26, 27, 28, 29, 30, 31}},
+  // len 8 <-> len 4
+  {{0, 1, 2, 3, 16, 17, 18, 19, 8, 9, 10, 11, 24, 25, 26, 27},
+   {4, 5, 6, 7, 20, 21, 22, 23, 12, 13, 14, 15, 28, 29, 30, 31}},
+  // len 4 <-> len 2
+  {{0, 1, 16, 17, 4, 5, 20, 21, 8, 9, 24, 25, 12, 13, 28, 29},
+   {2, 3, 18, 19, 6, 7, 22, 23, 10, 11, 26, 27, 14, 15, 30, 31}},
+  // len 2 <-> len 1
+  {{0, 16, 2, 18, 4, 20, 6, 22, 8, 24, 10, 26, 12, 28, 14, 30},
+   {1, 17, 3, 19, 5, 21, 7, 23, 9, 25, 11, 27, 13, 29, 15, 31}},
+  // len 1 -> ordem natural
+  {{0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23},
+   {8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31}},
+  // ordem natural -> len 1
+  {{0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30},
+   {1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31}}
+};
+
+#define PERMUTE(lo, hi, p) do {                                               \
+    __m512i l_ = lo;                                                          \
+    lo = _mm512_permutex2var_epi32(l_, _mm512_loadu_si512(perm_idx[p][0]), hi); \
+    hi = _mm512_permutex2var_epi32(l_, _mm512_loadu_si512(perm_idx[p][1]), hi); \
+  } while(0)
+
+// Borboleta Cooley-Tukey: t = zeta*b*2^-32; (a, b) <- (a + t, a - t)
+#define CT_BUTTERFLY(a, b, zeta) do {            \
+    __m512i t_ = montgomery_mul_avx512(zeta, b); \
+    b = _mm512_sub_epi32(a, t_);                 \
+    a = _mm512_add_epi32(a, t_);                 \
+  } while(0)
+
+// Borboleta Gentleman-Sande: (a, b) <- (a + b, zeta*(a - b)*2^-32)
+#define GS_BUTTERFLY(a, b, zeta) do {            \
+    __m512i t_ = a;                              \
+    a = _mm512_add_epi32(t_, b);                 \
+    b = _mm512_sub_epi32(t_, b);                 \
+    b = montgomery_mul_avx512(zeta, b);          \
+  } while(0)
+
+/*************************************************
+* Name:        ntt
+*
+* Description: Forward NTT, in-place. No modular reduction is performed
+*              after additions or subtractions. Output vector is in
+*              bitreversed order. Same butterflies and roots as the NEON
+*              and AVX2 versions, so the output is bit-identical.
+*
+* Arguments:   - int32_t a[N]: input/output coefficient array
+**************************************************/
+void ntt(int32_t a[N]) {
+    unsigned int len, start, j, k, c;
+    __m512i zeta, lo, hi;
+    k = 0;
+
+    // Camadas len >= 32: 16 coeficientes por registrador, zeta replicado
+    for (len = 128; len >= 32; len >>= 1) {
+        for (start = 0; start < N; start += 2 * len) {
+            zeta = _mm512_set1_epi32(zetas[++k]);
+
+            for (j = start; j < start + len; j += 16) {
+                lo = _mm512_loadu_si512(&a[j]);
+                hi = _mm512_loadu_si512(&a[j + len]);
+                CT_BUTTERFLY(lo, hi, zeta);
+                _mm512_storeu_si512(&a[j], lo);
+                _mm512_storeu_si512(&a[j + len], hi);
+            }
+        }
+    }
+
+    // Camadas len = 16, 8, 4, 2, 1 dentro de cada bloco de 32 coeficientes
+    for (c = 0; c < N / 32; ++c) {
+        const int32_t *zl = &zetas_low[64 * c];
+
+        lo = _mm512_loadu_si512(&a[32 * c]);
+        hi = _mm512_loadu_si512(&a[32 * c + 16]);
+
+        CT_BUTTERFLY(lo, hi, _mm512_set1_epi32(zetas[8 + c]));
+        PERMUTE(lo, hi, 0);
+        CT_BUTTERFLY(lo, hi, _mm512_loadu_si512(&zl[0]));
+        PERMUTE(lo, hi, 1);
+        CT_BUTTERFLY(lo, hi, _mm512_loadu_si512(&zl[16]));
+        PERMUTE(lo, hi, 2);
+        CT_BUTTERFLY(lo, hi, _mm512_loadu_si512(&zl[32]));
+        PERMUTE(lo, hi, 3);
+        CT_BUTTERFLY(lo, hi, _mm512_loadu_si512(&zl[48]));
+        PERMUTE(lo, hi, 4);
+
+        _mm512_storeu_si512(&a[32 * c], lo);
+        _mm512_storeu_si512(&a[32 * c + 16], hi);
+    }
+}
+
+/*************************************************
+* Name:        invntt_tomont
+*
+* Description: Inverse NTT and multiplication by Montgomery factor 2^32.
+*              In-place. No modular reductions after additions or
+*              subtractions; input coefficients need to be smaller than
+*              Q in absolute value. Output coefficient are smaller than Q in
+*              absolute value. Bit-identical to the NEON and AVX2 versions.
+*
+* Arguments:   - int32_t a[N]: input/output coefficient array
+**************************************************/
+void invntt_tomont(int32_t a[N]) {
+    unsigned int len, start, j, k, c;
+    __m512i zeta, lo, hi;
+    const __m512i f = _mm512_set1_epi32(41978);  // mont^2 / 256
+
+    // Camadas len = 1, 2, 4, 8, 16 dentro de cada bloco de 32 coeficientes
+    for (c = 0; c < N / 32; ++c) {
+        const int32_t *zl = &zetas_inv_low[64 * c];
+
+        lo = _mm512_loadu_si512(&a[32 * c]);
+        hi = _mm512_loadu_si512(&a[32 * c + 16]);
+
+        PERMUTE(lo, hi, 5);
+        GS_BUTTERFLY(lo, hi, _mm512_loadu_si512(&zl[0]));
+        PERMUTE(lo, hi, 3);
+        GS_BUTTERFLY(lo, hi, _mm512_loadu_si512(&zl[16]));
+        PERMUTE(lo, hi, 2);
+        GS_BUTTERFLY(lo, hi, _mm512_loadu_si512(&zl[32]));
+        PERMUTE(lo, hi, 1);
+        GS_BUTTERFLY(lo, hi, _mm512_loadu_si512(&zl[48]));
+        PERMUTE(lo, hi, 0);
+        GS_BUTTERFLY(lo, hi, _mm512_set1_epi32(-zetas[15 - c]));
+
+        _mm512_storeu_si512(&a[32 * c], lo);
+        _mm512_storeu_si512(&a[32 * c + 16], hi);
+    }
+
+    // Camadas len >= 32
+    k = 8;
+    for (len = 32; len <= 128; len <<= 1) {
+        for (start = 0; start < N; start += 2 * len) {
+            zeta = _mm512_set1_epi32(-zetas[--k]);
+
+            for (j = start; j < start + len; j += 16) {
+                lo = _mm512_loadu_si512(&a[j]);
+                hi = _mm512_loadu_si512(&a[j + len]);
+                GS_BUTTERFLY(lo, hi, zeta);
+                _mm512_storeu_si512(&a[j], lo);
+                _mm512_storeu_si512(&a[j + len], hi);
+            }
+        }
+    }
+
+    // Multiplicação final por mont^2 / 256
+    for (j = 0; j < N; j += 16) {
+        lo = _mm512_loadu_si512(&a[j]);
+        _mm512_storeu_si512(&a[j], montgomery_mul_avx512(f, lo));
+    }
+}
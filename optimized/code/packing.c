@@ -96,6 +96,72 @@ void pack_sk(uint8_t sk[CRYPTO_SECRETKEYBYTES],
     polyt0_pack(sk + i*POLYT0_PACKEDBYTES, &t0->vec[i]);
 }
 
+/*************************************************
+* Name:        pack_keys
+*
+* Description: Bit-pack public key pk = (rho, t1) and secret key
+*              sk = (rho, key, tr, s1, s2, t0) from t = A*s1 + s2 before
+*              power2round. Each polynomial of t is split and written to
+*              pk and sk in a single pass. Field tr is left untouched since
+*              it depends on pk; write it afterwards with pack_sk_tr.
+*
+* Arguments:   - uint8_t pk[]: output byte array for public key
+*              - uint8_t sk[]: output byte array for secret key
+*              - const uint8_t rho[]: byte array containing rho
+*              - const uint8_t key[]: byte array containing key
+*              - const polyveck *as1: pointer to vector A*s1 (normal domain)
+*              - const polyvecl *s1: pointer to vector s1
+*              - const polyveck *s2: pointer to vector s2
+**************************************************/
+void pack_keys(uint8_t pk[CRYPTO_PUBLICKEYBYTES],
+               uint8_t sk[CRYPTO_SECRETKEYBYTES],
+               const uint8_t rho[SEEDBYTES],
+               const uint8_t key[SEEDBYTES],
+               const polyveck *as1,
+               const polyvecl *s1,
+               const polyveck *s2)
+{
+  unsigned int i;
+
+  for(i = 0; i < SEEDBYTES; ++i)
+    pk[i] = sk[i] = rho[i];
+  pk += SEEDBYTES;
+  sk += SEEDBYTES;
+
+  for(i = 0; i < SEEDBYTES; ++i)
+    sk[i] = key[i];
+  sk += SEEDBYTES + TRBYTES;
+
+  for(i = 0; i < L; ++i)
+    polyeta_pack(sk + i*POLYETA_PACKEDBYTES, &s1->vec[i]);
+  sk += L*POLYETA_PACKEDBYTES;
+
+  for(i = 0; i < K; ++i)
+    polyeta_pack(sk + i*POLYETA_PACKEDBYTES, &s2->vec[i]);
+  sk += K*POLYETA_PACKEDBYTES;
+
+  for(i = 0; i < K; ++i)
+    poly_power2round_pack(pk + i*POLYT1_PACKEDBYTES, sk + i*POLYT0_PACKEDBYTES,
+                          &as1->vec[i], &s2->vec[i]);
+}
+
+/*************************************************
+* Name:        pack_sk_tr
+*
+* Description: Write tr into a secret key produced by pack_keys.
+*
+* Arguments:   - uint8_t sk[]: secret key byte array
+*              - const uint8_t tr[]: byte array containing tr
+**************************************************/
+void pack_sk_tr(uint8_t sk[CRYPTO_SECRETKEYBYTES], const uint8_t tr[TRBYTES])
+{
+  unsigned int i;
+
+  sk += 2*SEEDBYTES;
+  for(i = 0; i < TRBYTES; ++i)
+    sk[i] = tr[i];
+}
+
 /*************************************************
 * Name:        unpack_sk
 *
@@ -151,14 +217,15 @@ void unpack_sk(uint8_t rho[SEEDBYTES],
 * Arguments:   - uint8_t sig[]: output byte array
 *              - const uint8_t *c: pointer to challenge hash length SEEDBYTES
 *              - const polyvecl *z: pointer to vector z
-*              - const polyveck *h: pointer to hint vector h
+*              - const bitset_hint *h: pointer to hint h
 **************************************************/
 void pack_sig(uint8_t sig[CRYPTO_BYTES],
               const uint8_t c[CTILDEBYTES],
               const polyvecl *z,
-              const polyveck *h)
+              const bitset_hint *h)
 {
   unsigned int i, j, k;
+  uint64_t x;
 
   for(i=0; i < CTILDEBYTES; ++i)
     sig[i] = c[i];
@@ -168,37 +235,38 @@ void pack_sig(uint8_t sig[CRYPTO_BYTES],
     polyz_pack(sig + i*POLYZ_PACKEDBYTES, &z->vec[i]);
   sig += L*POLYZ_PACKEDBYTES;
 
-  /* Encode h */
-  for(i = 0; i < OMEGA + K; ++i)
-    sig[i] = 0;
-
+  /* Encode h: one index per set bit, lowest first */
   k = 0;
   for(i = 0; i < K; ++i) {
-    for(j = 0; j < N; ++j)
-      if(h->vec[i].coeffs[j] != 0)
-        sig[k++] = j;
+    for(j = 0; j < N/64; ++j)
+      for(x = h->bits[i][j]; x; x &= x - 1)
+        sig[k++] = 64*j + __builtin_ctzll(x);
 
     sig[OMEGA + i] = k;
   }
+
+  for(j = k; j < OMEGA; ++j)
+    sig[j] = 0;
 }
 
 /*************************************************
-* Name:        unpack_sig
+* Name:        unpack_sig_sparse
 *
-* Description: Unpack signature sig = (c, z, h).
+* Description: Unpack signature sig = (c, z, h), keeping the hint h as the
+*              index lists of the signature instead of a dense polyveck.
 *
 * Arguments:   - uint8_t *c: pointer to output challenge hash
 *              - polyvecl *z: pointer to output vector z
-*              - polyveck *h: pointer to output hint vector h
+*              - sparse_hint *h: pointer to output sparse hint
 *              - const uint8_t sig[]: byte array containing
 *                bit-packed signature
 *
 * Returns 1 in case of malformed signature; otherwise 0.
 **************************************************/
-int unpack_sig(uint8_t c[CTILDEBYTES],
-               polyvecl *z,
-               polyveck *h,
-               const uint8_t sig[CRYPTO_BYTES])
+int unpack_sig_sparse(uint8_t c[CTILDEBYTES],
+                      polyvecl *z,
+                      sparse_hint *h,
+                      const uint8_t sig[CRYPTO_BYTES])
 {
   unsigned int i, j, k;
 
@@ -213,19 +281,17 @@ int unpack_sig(uint8_t c[CTILDEBYTES],
   /* Decode h */
   k = 0;
   for(i = 0; i < K; ++i) {
-    for(j = 0; j < N; ++j)
-      h->vec[i].coeffs[j] = 0;
-
     if(sig[OMEGA + i] < k || sig[OMEGA + i] > OMEGA)
       return 1;
 
     for(j = k; j < sig[OMEGA + i]; ++j) {
       /* Coefficients are ordered for strong unforgeability */
       if(j > k && sig[j] <= sig[j-1]) return 1;
-      h->vec[i].coeffs[sig[j]] = 1;
+      h->idx[j] = sig[j];
     }
 
     k = sig[OMEGA + i];
+    h->cut[i] = k;
   }
 
   /* Extra indices are zero for strong unforgeability */
@@ -235,3 +301,43 @@ int unpack_sig(uint8_t c[CTILDEBYTES],
 
   return 0;
 }
+
+/*************************************************
+* Name:        unpack_sig
+*
+* Description: Unpack signature sig = (c, z, h), expanding the hint h
+*              decoded by unpack_sig_sparse into a dense polyveck.
+*
+* Arguments:   - uint8_t *c: pointer to output challenge hash
+*              - polyvecl *z: pointer to output vector z
+*              - polyveck *h: pointer to output hint vector h
+*              - const uint8_t sig[]: byte array containing
+*                bit-packed signature
+*
+* Returns 1 in case of malformed signature; otherwise 0.
+**************************************************/
+int unpack_sig(uint8_t c[CTILDEBYTES],
+               polyvecl *z,
+               polyveck *h,
+               const uint8_t sig[CRYPTO_BYTES])
+{
+  unsigned int i, j, k;
+  sparse_hint hs;
+
+  // A validação de h fica só em unpack_sig_sparse; aqui apenas expande
+  if(unpack_sig_sparse(c, z, &hs, sig))
+    return 1;
+
+  k = 0;
+  for(i = 0; i < K; ++i) {
+    for(j = 0; j < N; ++j)
+      h->vec[i].coeffs[j] = 0;
+
+    for(j = k; j < hs.cut[i]; ++j)
+      h->vec[i].coeffs[hs.idx[j]] = 1;
+
+    k = hs.cut[i];
+  }
+
+  return 0;
+}
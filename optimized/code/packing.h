@@ -17,8 +17,20 @@ void pack_sk(uint8_t sk[CRYPTO_SECRETKEYBYTES],
              const polyvecl *s1,
              const polyveck *s2);
 
+#define pack_keys DILITHIUM_NAMESPACE(pack_keys)
+void pack_keys(uint8_t pk[CRYPTO_PUBLICKEYBYTES],
+               uint8_t sk[CRYPTO_SECRETKEYBYTES],
+               const uint8_t rho[SEEDBYTES],
+               const uint8_t key[SEEDBYTES],
+               const polyveck *as1,
+               const polyvecl *s1,
+               const polyveck *s2);
+
+#define pack_sk_tr DILITHIUM_NAMESPACE(pack_sk_tr)
+void pack_sk_tr(uint8_t sk[CRYPTO_SECRETKEYBYTES], const uint8_t tr[TRBYTES]);
+
 #define pack_sig DILITHIUM_NAMESPACE(pack_sig)
-void pack_sig(uint8_t sig[CRYPTO_BYTES], const uint8_t c[CTILDEBYTES], const polyvecl *z, const polyveck *h);
+void pack_sig(uint8_t sig[CRYPTO_BYTES], const uint8_t c[CTILDEBYTES], const polyvecl *z, const bitset_hint *h);
 
 #define unpack_pk DILITHIUM_NAMESPACE(unpack_pk)
 void unpack_pk(uint8_t rho[SEEDBYTES], polyveck *t1, const uint8_t pk[CRYPTO_PUBLICKEYBYTES]);
@@ -35,4 +47,7 @@ void unpack_sk(uint8_t rho[SEEDBYTES],
 #define unpack_sig DILITHIUM_NAMESPACE(unpack_sig)
 int unpack_sig(uint8_t c[CTILDEBYTES], polyvecl *z, polyveck *h, const uint8_t sig[CRYPTO_BYTES]);
 
+#define unpack_sig_sparse DILITHIUM_NAMESPACE(unpack_sig_sparse)
+int unpack_sig_sparse(uint8_t c[CTILDEBYTES], polyvecl *z, sparse_hint *h, const uint8_t sig[CRYPTO_BYTES]);
+
 #endif
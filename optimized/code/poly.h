@@ -3,11 +3,19 @@
 
 #include <stdint.h>
 #include "params.h"
+#include "cpu.h"
 
 typedef struct {
   int32_t coeffs[N];
 } poly;
 
+/* Challenge c in sparse form: positions of the TAU nonzero coefficients
+ * and a bitmask whose bit k is set when coefficient pos[k] equals -1. */
+typedef struct {
+  uint8_t pos[TAU];
+  uint64_t signs;
+} sparse_challenge;
+
 
 #define poly_reduce DILITHIUM_NAMESPACE(poly_reduce)
 void poly_reduce(poly *a);
@@ -27,15 +35,37 @@ void poly_ntt(poly *a);
 void poly_invntt_tomont(poly *a);
 #define poly_pointwise_montgomery DILITHIUM_NAMESPACE(poly_pointwise_montgomery)
 void poly_pointwise_montgomery(poly *c, const poly *a, const poly *b);
+#if defined(__AVX512F__)
+#define poly_pointwise_acc_montgomery DILITHIUM_NAMESPACE(poly_pointwise_acc_montgomery)
+void poly_pointwise_acc_montgomery(poly *w, const poly *u, const poly *v, unsigned int len);
+#endif
+#define poly_sparse_mul DILITHIUM_NAMESPACE(poly_sparse_mul)
+void poly_sparse_mul(poly *r, const sparse_challenge *c, const poly *a);
 
 #define poly_power2round DILITHIUM_NAMESPACE(poly_power2round)
 void poly_power2round(poly *a1, poly *a0, const poly *a);
 #define poly_decompose DILITHIUM_NAMESPACE(poly_decompose)
 void poly_decompose(poly *a1, poly *a0, const poly *a);
+#define poly_decompose_w1 DILITHIUM_NAMESPACE(poly_decompose_w1)
+void poly_decompose_w1(uint8_t *r, poly *a1, poly *a0, const poly *a);
 #define poly_make_hint DILITHIUM_NAMESPACE(poly_make_hint)
 unsigned int poly_make_hint(poly *h, const poly *a0, const poly *a1);
 #define poly_use_hint DILITHIUM_NAMESPACE(poly_use_hint)
 void poly_use_hint(poly *b, const poly *a, const poly *h);
+#define poly_make_hint_bits DILITHIUM_NAMESPACE(poly_make_hint_bits)
+unsigned int poly_make_hint_bits(uint64_t h[N/64], const poly *a0, const poly *a1);
+#if !defined(__riscv_vector)
+#define poly_power2round_n DILITHIUM_NAMESPACE(poly_power2round_n)
+void poly_power2round_n(poly *a1, poly *a0, const poly *a, unsigned int len);
+#define poly_decompose_n DILITHIUM_NAMESPACE(poly_decompose_n)
+void poly_decompose_n(poly *a1, poly *a0, const poly *a, unsigned int len);
+#define poly_make_hint_n DILITHIUM_NAMESPACE(poly_make_hint_n)
+unsigned int poly_make_hint_n(poly *h, const poly *a0, const poly *a1, unsigned int len);
+#define poly_use_hint_n DILITHIUM_NAMESPACE(poly_use_hint_n)
+void poly_use_hint_n(poly *b, const poly *a, const poly *h, unsigned int len);
+#define poly_highbits_n DILITHIUM_NAMESPACE(poly_highbits_n)
+void poly_highbits_n(poly *a1, const poly *a, unsigned int len);
+#endif
 
 #define poly_chknorm DILITHIUM_NAMESPACE(poly_chknorm)
 int poly_chknorm(const poly *a, int32_t B);
@@ -44,6 +74,28 @@ int poly_chknorm(const poly *a, int32_t B);
 void poly_uniform(poly *a[], const uint8_t seed[SEEDBYTES], uint16_t nonce[], int batch_size); 
 #define poly_uniform_2x DILITHIUM_NAMESPACE(poly_uniform_2x)
 void poly_uniform_2x(poly *a0, poly *a1, const uint8_t seed[SEEDBYTES], uint16_t nonce0,uint16_t nonce1);
+#define poly_uniform_3x DILITHIUM_NAMESPACE(poly_uniform_3x)
+void poly_uniform_3x(poly *a0, poly *a1, poly *a2, const uint8_t seed[SEEDBYTES],
+                     uint16_t nonce0, uint16_t nonce1, uint16_t nonce2);
+#if defined(__AVX2__) || defined(__riscv_vector)
+#define poly_uniform_4x DILITHIUM_NAMESPACE(poly_uniform_4x)
+void poly_uniform_4x(poly *a0, poly *a1, poly *a2, poly *a3, const uint8_t seed[SEEDBYTES],
+                     uint16_t nonce0, uint16_t nonce1, uint16_t nonce2, uint16_t nonce3);
+#endif
+#if defined(__AVX512F__)
+#define poly_uniform_8x DILITHIUM_NAMESPACE(poly_uniform_8x)
+void poly_uniform_8x(poly *const a[8], const uint8_t seed[SEEDBYTES], const uint16_t nonce[8]);
+#endif
+#if defined(POLY_SVE_STATIC) || defined(POLY_SVE_DISPATCH)
+#define rej_uniform_sve DILITHIUM_NAMESPACE(rej_uniform_sve)
+unsigned int rej_uniform_sve(int32_t *a, unsigned int len, const uint8_t *buf, unsigned int buflen);
+#define rej_eta_sve DILITHIUM_NAMESPACE(rej_eta_sve)
+unsigned int rej_eta_sve(int32_t *a, unsigned int len, const uint8_t *buf, unsigned int buflen);
+#endif
+#if !defined(POLY_SVE_STATIC) && !defined(__riscv_vector)
+#define rej_uniform_simd DILITHIUM_NAMESPACE(rej_uniform_simd)
+unsigned int rej_uniform_simd(int32_t *a, unsigned int len, const uint8_t *buf, unsigned int buflen);
+#endif
 #define poly_uniform_eta DILITHIUM_NAMESPACE(poly_uniform_eta)
 void poly_uniform_eta(poly *a,
                       const uint8_t seed[CRHBYTES],
@@ -55,8 +107,18 @@ void poly_uniform_gamma1(poly *a,
 #define poly_uniform_gamma1_2x DILITHIUM_NAMESPACE(poly_uniform_gamma1_2x)
 void poly_uniform_gamma1_2x(poly *a0, poly *a1, const uint8_t seed[64], 
                             uint16_t nonce0, uint16_t nonce1); 
+#define poly_uniform_gamma1_3x DILITHIUM_NAMESPACE(poly_uniform_gamma1_3x)
+void poly_uniform_gamma1_3x(poly *a0, poly *a1, poly *a2, const uint8_t seed[64],
+                            uint16_t nonce0, uint16_t nonce1, uint16_t nonce2);
+#if defined(__AVX2__) || defined(__riscv_vector)
+#define poly_uniform_gamma1_4x DILITHIUM_NAMESPACE(poly_uniform_gamma1_4x)
+void poly_uniform_gamma1_4x(poly *a0, poly *a1, poly *a2, poly *a3, const uint8_t seed[64],
+                            uint16_t nonce0, uint16_t nonce1, uint16_t nonce2, uint16_t nonce3);
+#endif
 #define poly_challenge DILITHIUM_NAMESPACE(poly_challenge)
 void poly_challenge(poly *c, const uint8_t seed[CTILDEBYTES]);
+#define poly_challenge_sparse DILITHIUM_NAMESPACE(poly_challenge_sparse)
+void poly_challenge_sparse(sparse_challenge *c, const uint8_t seed[CTILDEBYTES]);
 
 #define polyeta_pack DILITHIUM_NAMESPACE(polyeta_pack)
 void polyeta_pack(uint8_t *r, const poly *a);
@@ -72,6 +134,8 @@ void polyt1_unpack(poly *r, const uint8_t *a);
 void polyt0_pack(uint8_t *r, const poly *a);
 #define polyt0_unpack DILITHIUM_NAMESPACE(polyt0_unpack)
 void polyt0_unpack(poly *r, const uint8_t *a);
+#define poly_power2round_pack DILITHIUM_NAMESPACE(poly_power2round_pack)
+void poly_power2round_pack(uint8_t *t1, uint8_t *t0, const poly *a, const poly *b);
 
 #define polyz_pack DILITHIUM_NAMESPACE(polyz_pack)
 void polyz_pack(uint8_t *r, const poly *a);
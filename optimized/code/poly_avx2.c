@@ -0,0 +1,415 @@
+#include <stdint.h>
+#include <string.h>
+#include <immintrin.h>
+#include "params.h"
+#include "poly.h"
+#include "reduce.h"
+#include "symmetric.h"
+#include "fips202x4.h"
+#if defined(__AVX512F__)
+#include "reduce_avx512.h"
+#include "fips202x8.h"
+#endif
+
+/* Amostragem AVX2 de poly.h para x86-64: as mesmas funções de
+ * poly_neon.c, com o Keccak x4 (e o x8 com AVX-512). A aritmética e
+ * rej_uniform vêm de poly_simd.c. As saídas são idênticas bit a bit às
+ * da versão NEON. */
+
+#ifdef DBENCH
+#include "test/cpucycles.h"
+extern const uint64_t timing_overhead;
+extern uint64_t *tred, *tadd, *tmul, *tround, *tsample, *tpack;
+#define DBENCH_START() uint64_t time = cpucycles()
+#define DBENCH_STOP(t) t += cpucycles() - time - timing_overhead
+#else
+#define DBENCH_START()
+#define DBENCH_STOP(t)
+#endif
+
+#if defined(__AVX512F__)
+/*************************************************
+* Name:        poly_pointwise_acc_montgomery
+*
+* Description: Fused pointwise multiply-accumulate of len pairs of
+*              polynomials in NTT domain representation:
+*              w = sum_i u[i]*v[i]*2^{-32}. Same result as
+*              poly_pointwise_montgomery followed by poly_add, but the
+*              accumulator stays in registers.
+*
+* Arguments:   - poly *w: pointer to output polynomial
+*              - const poly *u: pointer to first array of len polynomials
+*              - const poly *v: pointer to second array of len polynomials
+*              - unsigned int len: number of products
+**************************************************/
+void poly_pointwise_acc_montgomery(poly *w, const poly *u, const poly *v, unsigned int len) {
+    unsigned int i, j;
+    __m512i acc0, acc1;
+    DBENCH_START();
+
+    // Dois acumuladores de 16 coeficientes por iteração
+    for (i = 0; i < N; i += 32) {
+        acc0 = montgomery_mul_avx512(_mm512_loadu_si512(&u[0].coeffs[i]), _mm512_loadu_si512(&v[0].coeffs[i]));
+        acc1 = montgomery_mul_avx512(_mm512_loadu_si512(&u[0].coeffs[i + 16]), _mm512_loadu_si512(&v[0].coeffs[i + 16]));
+
+        for (j = 1; j < len; ++j) {
+            acc0 = _mm512_add_epi32(acc0, montgomery_mul_avx512(_mm512_loadu_si512(&u[j].coeffs[i]),
+                                                                _mm512_loadu_si512(&v[j].coeffs[i])));
+            acc1 = _mm512_add_epi32(acc1, montgomery_mul_avx512(_mm512_loadu_si512(&u[j].coeffs[i + 16]),
+                                                                _mm512_loadu_si512(&v[j].coeffs[i + 16])));
+        }
+
+        _mm512_storeu_si512(&w->coeffs[i], acc0);
+        _mm512_storeu_si512(&w->coeffs[i + 16], acc1);
+    }
+    DBENCH_STOP(*tmul);
+}
+#endif
+
+#define rej_uniform rej_uniform_simd
+
+/*************************************************
+* Name:        poly_uniform
+*
+* Description: Sample polynomial with uniformly random coefficients
+*              in [0,Q-1] by performing rejection sampling on the
+*              output stream of SHAKE128(seed|nonce)
+*
+* Arguments:   - poly *a: pointer to output polynomial
+*              - const uint8_t seed[]: byte array with seed of length SEEDBYTES
+*              - uint16_t nonce: 2-byte nonce
+**************************************************/
+#define POLY_UNIFORM_NBLOCKS ((768 + STREAM128_BLOCKBYTES - 1)/STREAM128_BLOCKBYTES)
+#define POLY_UNIFORM_BUFLEN (POLY_UNIFORM_NBLOCKS*STREAM128_BLOCKBYTES)
+
+// Amostra um único polinômio, com estado e buffer de tamanho fixo (sem VLAs)
+static void poly_uniform_single(poly *a, const uint8_t seed[SEEDBYTES], uint16_t nonce) {
+    unsigned int i, ctr, off;
+    unsigned int buflen = POLY_UNIFORM_BUFLEN;
+    uint8_t buf[POLY_UNIFORM_BUFLEN + 2];
+    stream128_state state;
+
+    stream128_init(&state, seed, nonce);
+    stream128_squeezeblocks(buf, POLY_UNIFORM_NBLOCKS, &state);
+
+    ctr = rej_uniform(a->coeffs, N, buf, buflen);
+
+    // Se não preencheu todos os coeficientes, squeeze mais blocos
+    while (ctr < N) {
+        off = buflen % 3;
+        for (i = 0; i < off; ++i)
+            buf[i] = buf[buflen - off + i];
+
+        stream128_squeezeblocks(buf + off, 1, &state);
+        buflen = STREAM128_BLOCKBYTES + off;
+        ctr += rej_uniform(a->coeffs + ctr, N - ctr, buf, buflen);
+    }
+}
+
+// Processa o lote em grupos de oito (Keccak x8, com AVX-512) e de quatro
+// (Keccak x4), e o resto com as variantes de três, dois ou um polinômio
+void poly_uniform(poly *a[], const uint8_t seed[SEEDBYTES], uint16_t nonce[], int batch_size) {
+    int idx = 0;
+
+#if defined(__AVX512F__)
+    for (; idx + 8 <= batch_size; idx += 8)
+        poly_uniform_8x(&a[idx], seed, &nonce[idx]);
+#endif
+    for (; idx + 4 <= batch_size; idx += 4)
+        poly_uniform_4x(a[idx], a[idx + 1], a[idx + 2], a[idx + 3], seed,
+                        nonce[idx], nonce[idx + 1], nonce[idx + 2], nonce[idx + 3]);
+
+    if (batch_size - idx == 3)
+        poly_uniform_3x(a[idx], a[idx + 1], a[idx + 2], seed, nonce[idx], nonce[idx + 1], nonce[idx + 2]);
+    else if (batch_size - idx == 2)
+        poly_uniform_2x(a[idx], a[idx + 1], seed, nonce[idx], nonce[idx + 1]);
+    else if (batch_size - idx == 1)
+        poly_uniform_single(a[idx], seed, nonce[idx]);
+}
+
+/******************************************************************************
+ * Name:        poly_uniform_4x
+ *
+ * Description: Sample four polynomials with uniformly random coefficients
+ *             in [0,Q-1] by performing rejection sampling on the
+ *            output stream of SHAKE128x4(seed|nonce0, ..., nonce3)
+ *
+ * Arguments:   - poly *a0..a3: pointers to output polynomials
+ *            - const uint8_t seed[]: byte array with seed of length SEEDBYTES
+ *           - uint16_t nonce0..nonce3: 2-byte nonces
+ * *******************************************************************************/
+void poly_uniform_4x(poly *a0, poly *a1, poly *a2, poly *a3, const uint8_t seed[SEEDBYTES],
+                     uint16_t nonce0, uint16_t nonce1, uint16_t nonce2, uint16_t nonce3) {
+    unsigned int ctr0, ctr1, ctr2, ctr3;
+    uint8_t buf[4][SEEDBYTES + 2];
+    uint8_t outbuf[4][POLY_UNIFORM_BUFLEN];
+    keccakx4_state state;
+
+    memcpy(buf[0], seed, SEEDBYTES);
+    memcpy(buf[1], seed, SEEDBYTES);
+    memcpy(buf[2], seed, SEEDBYTES);
+    memcpy(buf[3], seed, SEEDBYTES);
+
+    buf[0][SEEDBYTES + 0] = (uint8_t)(nonce0 & 0xFF);
+    buf[0][SEEDBYTES + 1] = (uint8_t)(nonce0 >> 8);
+    buf[1][SEEDBYTES + 0] = (uint8_t)(nonce1 & 0xFF);
+    buf[1][SEEDBYTES + 1] = (uint8_t)(nonce1 >> 8);
+    buf[2][SEEDBYTES + 0] = (uint8_t)(nonce2 & 0xFF);
+    buf[2][SEEDBYTES + 1] = (uint8_t)(nonce2 >> 8);
+    buf[3][SEEDBYTES + 0] = (uint8_t)(nonce3 & 0xFF);
+    buf[3][SEEDBYTES + 1] = (uint8_t)(nonce3 >> 8);
+
+    FIPS202X4_NAMESPACE(shake128x4_absorb_once)(&state, buf[0], buf[1], buf[2], buf[3], SEEDBYTES + 2);
+    FIPS202X4_NAMESPACE(shake128x4_squeezeblocks)(outbuf[0], outbuf[1], outbuf[2], outbuf[3],
+                                                  POLY_UNIFORM_NBLOCKS, &state);
+
+    ctr0 = rej_uniform(a0->coeffs, N, outbuf[0], POLY_UNIFORM_BUFLEN);
+    ctr1 = rej_uniform(a1->coeffs, N, outbuf[1], POLY_UNIFORM_BUFLEN);
+    ctr2 = rej_uniform(a2->coeffs, N, outbuf[2], POLY_UNIFORM_BUFLEN);
+    ctr3 = rej_uniform(a3->coeffs, N, outbuf[3], POLY_UNIFORM_BUFLEN);
+
+    // POLY_UNIFORM_BUFLEN é múltiplo de 3: os blocos seguintes começam em
+    // fronteira de candidato, como nas versões x2/x3
+    while (ctr0 < N || ctr1 < N || ctr2 < N || ctr3 < N) {
+        FIPS202X4_NAMESPACE(shake128x4_squeezeblocks)(outbuf[0], outbuf[1], outbuf[2], outbuf[3], 1, &state);
+
+        ctr0 += rej_uniform(a0->coeffs + ctr0, N - ctr0, outbuf[0], SHAKE128_RATE);
+        ctr1 += rej_uniform(a1->coeffs + ctr1, N - ctr1, outbuf[1], SHAKE128_RATE);
+        ctr2 += rej_uniform(a2->coeffs + ctr2, N - ctr2, outbuf[2], SHAKE128_RATE);
+        ctr3 += rej_uniform(a3->coeffs + ctr3, N - ctr3, outbuf[3], SHAKE128_RATE);
+    }
+}
+
+#if defined(__AVX512F__)
+/******************************************************************************
+ * Name:        poly_uniform_8x
+ *
+ * Description: Sample eight polynomials with uniformly random coefficients
+ *             in [0,Q-1] by performing rejection sampling on the
+ *            output stream of SHAKE128x8(seed|nonce[0], ..., nonce[7])
+ *
+ * Arguments:   - poly *a[8]: pointers to output polynomials
+ *            - const uint8_t seed[]: byte array with seed of length SEEDBYTES
+ *           - const uint16_t nonce[8]: 2-byte nonces
+ * *******************************************************************************/
+void poly_uniform_8x(poly *const a[8], const uint8_t seed[SEEDBYTES], const uint16_t nonce[8]) {
+    unsigned int j, pending;
+    unsigned int ctr[8];
+    uint8_t buf[8][SEEDBYTES + 2];
+    uint8_t outbuf[8][POLY_UNIFORM_BUFLEN];
+    const uint8_t *in[8];
+    uint8_t *out[8];
+    keccakx8_state state;
+
+    for (j = 0; j < 8; ++j) {
+        memcpy(buf[j], seed, SEEDBYTES);
+        buf[j][SEEDBYTES + 0] = (uint8_t)(nonce[j] & 0xFF);
+        buf[j][SEEDBYTES + 1] = (uint8_t)(nonce[j] >> 8);
+        in[j] = buf[j];
+        out[j] = outbuf[j];
+    }
+
+    FIPS202X8_NAMESPACE(shake128x8_absorb_once)(&state, in, SEEDBYTES + 2);
+    FIPS202X8_NAMESPACE(shake128x8_squeezeblocks)(out, POLY_UNIFORM_NBLOCKS, &state);
+
+    pending = 0;
+    for (j = 0; j < 8; ++j) {
+        ctr[j] = rej_uniform(a[j]->coeffs, N, outbuf[j], POLY_UNIFORM_BUFLEN);
+        pending |= ctr[j] < N;
+    }
+
+    // Como na versão x4: blocos extras começam em fronteira de candidato
+    while (pending) {
+        for (j = 0; j < 8; ++j)
+            out[j] = outbuf[j];
+        FIPS202X8_NAMESPACE(shake128x8_squeezeblocks)(out, 1, &state);
+
+        pending = 0;
+        for (j = 0; j < 8; ++j) {
+            ctr[j] += rej_uniform(a[j]->coeffs + ctr[j], N - ctr[j], outbuf[j], SHAKE128_RATE);
+            pending |= ctr[j] < N;
+        }
+    }
+}
+#endif
+
+/******************************************************************************
+ * Name:        poly_uniform_2x / poly_uniform_3x
+ *
+ * Description: Same as in poly_neon.c; the unused lanes of the x4 Keccak
+ *              sample a throwaway polynomial.
+ * *******************************************************************************/
+void poly_uniform_2x(poly *a0, poly *a1, const uint8_t seed[SEEDBYTES], uint16_t nonce0, uint16_t nonce1) {
+    poly tmp0, tmp1;
+
+    poly_uniform_4x(a0, a1, &tmp0, &tmp1, seed, nonce0, nonce1, 0, 0);
+}
+
+void poly_uniform_3x(poly *a0, poly *a1, poly *a2, const uint8_t seed[SEEDBYTES],
+                     uint16_t nonce0, uint16_t nonce1, uint16_t nonce2) {
+    poly tmp;
+
+    poly_uniform_4x(a0, a1, a2, &tmp, seed, nonce0, nonce1, nonce2, 0);
+}
+
+/*************************************************
+* Name:        rej_eta
+*
+* Description: Sample uniformly random coefficients in [-ETA, ETA] by
+*              performing rejection sampling on array of random bytes.
+*
+* Arguments:   - int32_t *a: pointer to output array (allocated)
+*              - unsigned int len: number of coefficients to be sampled
+*              - const uint8_t *buf: array of random bytes
+*              - unsigned int buflen: length of array of random bytes
+*
+* Returns number of sampled coefficients. Can be smaller than len if not enough
+* random bytes were given.
+**************************************************/
+static unsigned int rej_eta(int32_t *a, unsigned int len, const uint8_t *buf, unsigned int buflen) {
+  unsigned int ctr = 0, pos = 0;
+  uint32_t w, good;
+  uint64_t nib, vals, spread;
+  __m128i t, v;
+
+  // 4 bytes -> 8 nibbles, já na ordem da amostragem (baixo, alto, ...)
+  while (ctr + 8 <= len && pos + 4 <= buflen) {
+    memcpy(&w, &buf[pos], 4);
+    pos += 4;
+
+    nib = _pdep_u64(w, 0x0F0F0F0F0F0F0F0FULL);
+    t = _mm_cvtsi64_si128((long long)nib);
+
+#if ETA == 2
+    // t mod 5 para t < 15, sem divisão
+    good = (uint32_t)_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(15), t)) & 0xFF;
+    v = _mm_sub_epi8(t, _mm_and_si128(_mm_cmpgt_epi8(t, _mm_set1_epi8(4)), _mm_set1_epi8(5)));
+    v = _mm_sub_epi8(v, _mm_and_si128(_mm_cmpgt_epi8(t, _mm_set1_epi8(9)), _mm_set1_epi8(5)));
+    v = _mm_sub_epi8(_mm_set1_epi8(2), v);
+#elif ETA == 4
+    good = (uint32_t)_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(9), t)) & 0xFF;
+    v = _mm_sub_epi8(_mm_set1_epi8(4), t);
+#endif
+
+    // Compacta os bytes aceitos com pext e estende para 32 bits com sinal
+    spread = _pdep_u64(good, 0x0101010101010101ULL) * 0xFF;
+    vals = _pext_u64((uint64_t)_mm_cvtsi128_si64(v), spread);
+    _mm256_storeu_si256((__m256i *)&a[ctr], _mm256_cvtepi8_epi32(_mm_cvtsi64_si128((long long)vals)));
+    ctr += (unsigned int)_mm_popcnt_u32(good);
+  }
+
+  while (ctr < len && pos < buflen) {
+    uint32_t t0 = buf[pos] & 0x0F;
+    uint32_t t1 = buf[pos++] >> 4;
+
+#if ETA == 2
+    if (t0 < 15) {
+      t0 = t0 - (205 * t0 >> 10) * 5;
+      a[ctr++] = 2 - t0;
+    }
+    if (t1 < 15 && ctr < len) {
+      t1 = t1 - (205 * t1 >> 10) * 5;
+      a[ctr++] = 2 - t1;
+    }
+#elif ETA == 4
+    if (t0 < 9)
+      a[ctr++] = 4 - t0;
+    if (t1 < 9 && ctr < len)
+      a[ctr++] = 4 - t1;
+#endif
+  }
+
+  return ctr;
+}
+
+/*************************************************
+* Name:        poly_uniform_eta
+*
+* Description: Sample polynomial with uniformly random coefficients
+*              in [-ETA,ETA] by performing rejection sampling on the
+*              output stream from SHAKE256(seed|nonce)
+*
+* Arguments:   - poly *a: pointer to output polynomial
+*              - const uint8_t seed[]: byte array with seed of length CRHBYTES
+*              - uint16_t nonce: 2-byte nonce
+**************************************************/
+#if ETA == 2
+#define POLY_UNIFORM_ETA_NBLOCKS ((136 + STREAM256_BLOCKBYTES - 1)/STREAM256_BLOCKBYTES)
+#elif ETA == 4
+#define POLY_UNIFORM_ETA_NBLOCKS ((227 + STREAM256_BLOCKBYTES - 1)/STREAM256_BLOCKBYTES)
+#endif
+void poly_uniform_eta(poly *a,
+                      const uint8_t seed[CRHBYTES],
+                      uint16_t nonce)
+{
+  unsigned int ctr;
+  unsigned int buflen = POLY_UNIFORM_ETA_NBLOCKS*STREAM256_BLOCKBYTES;
+  uint8_t buf[POLY_UNIFORM_ETA_NBLOCKS*STREAM256_BLOCKBYTES];
+  stream256_state state;
+
+  stream256_init(&state, seed, nonce);
+  stream256_squeezeblocks(buf, POLY_UNIFORM_ETA_NBLOCKS, &state);
+
+  ctr = rej_eta(a->coeffs, N, buf, buflen);
+
+  while(ctr < N) {
+    stream256_squeezeblocks(buf, 1, &state);
+    ctr += rej_eta(a->coeffs + ctr, N - ctr, buf, STREAM256_BLOCKBYTES);
+  }
+}
+
+/*************************************************
+* Name:        poly_uniform_gamma1_4x
+*
+* Description: Sample four polynomials with coefficients in
+*              [-(GAMMA1 - 1), GAMMA1] from SHAKE256x4(seed|nonce_i);
+*              same output as four calls to poly_uniform_gamma1.
+*
+* Arguments:   - poly *a0..a3: pointers to output polynomials
+*              - const uint8_t seed[]: byte array with seed of length CRHBYTES
+*              - uint16_t nonce0..nonce3: 16-bit nonces
+**************************************************/
+#define POLY_UNIFORM_GAMMA1_NBLOCKS ((POLYZ_PACKEDBYTES + STREAM256_BLOCKBYTES - 1)/STREAM256_BLOCKBYTES)
+
+void poly_uniform_gamma1_4x(poly *a0, poly *a1, poly *a2, poly *a3, const uint8_t seed[64],
+                            uint16_t nonce0, uint16_t nonce1, uint16_t nonce2, uint16_t nonce3) {
+  uint8_t buf[4][POLY_UNIFORM_GAMMA1_NBLOCKS * STREAM256_BLOCKBYTES + 14];
+  keccakx4_state state;
+
+  memcpy(buf[0], seed, 64);
+  memcpy(buf[1], seed, 64);
+  memcpy(buf[2], seed, 64);
+  memcpy(buf[3], seed, 64);
+
+  buf[0][64] = nonce0 & 0xFF;
+  buf[0][65] = (nonce0 >> 8) & 0xFF;
+  buf[1][64] = nonce1 & 0xFF;
+  buf[1][65] = (nonce1 >> 8) & 0xFF;
+  buf[2][64] = nonce2 & 0xFF;
+  buf[2][65] = (nonce2 >> 8) & 0xFF;
+  buf[3][64] = nonce3 & 0xFF;
+  buf[3][65] = (nonce3 >> 8) & 0xFF;
+
+  FIPS202X4_NAMESPACE(shake256x4_absorb_once)(&state, buf[0], buf[1], buf[2], buf[3], 66);
+  FIPS202X4_NAMESPACE(shake256x4_squeezeblocks)(buf[0], buf[1], buf[2], buf[3],
+                                                POLY_UNIFORM_GAMMA1_NBLOCKS, &state);
+
+  polyz_unpack(a0, buf[0]);
+  polyz_unpack(a1, buf[1]);
+  polyz_unpack(a2, buf[2]);
+  polyz_unpack(a3, buf[3]);
+}
+
+void poly_uniform_gamma1_2x(poly *a0, poly *a1, const uint8_t seed[64],
+                            uint16_t nonce0, uint16_t nonce1) {
+  poly tmp0, tmp1;
+
+  poly_uniform_gamma1_4x(a0, a1, &tmp0, &tmp1, seed, nonce0, nonce1, 0, 0);
+}
+
+void poly_uniform_gamma1_3x(poly *a0, poly *a1, poly *a2, const uint8_t seed[64],
+                            uint16_t nonce0, uint16_t nonce1, uint16_t nonce2) {
+  poly tmp;
+
+  poly_uniform_gamma1_4x(a0, a1, a2, &tmp, seed, nonce0, nonce1, nonce2, 0);
+}
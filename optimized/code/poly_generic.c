@@ -0,0 +1,275 @@
+#include <stdint.h>
+#include "params.h"
+#include "poly.h"
+#include "symmetric.h"
+#if defined(__wasm_simd128__)
+#include <string.h>
+#include "fips202x2.h"
+#endif
+
+/* Amostragem portátil de poly.h (ARCH=generic): usa apenas o Keccak de
+ * fips202.c, um polinômio por vez. Em ARCH=wasm os pares de polinômios
+ * usam o Keccak de 2 vias de fips202x2_wasm.c. A aritmética e rej_uniform
+ * vêm de poly_simd.c; o restante de poly.h fica em poly.c. */
+
+#define rej_uniform rej_uniform_simd
+
+/*************************************************
+* Name:        poly_uniform
+*
+* Description: Sample polynomial with uniformly random coefficients
+*              in [0,Q-1] by performing rejection sampling on the
+*              output stream of SHAKE128(seed|nonce)
+*
+* Arguments:   - poly *a: pointer to output polynomial
+*              - const uint8_t seed[]: byte array with seed of length SEEDBYTES
+*              - uint16_t nonce: 2-byte nonce
+**************************************************/
+#define POLY_UNIFORM_NBLOCKS ((768 + STREAM128_BLOCKBYTES - 1)/STREAM128_BLOCKBYTES)
+#define POLY_UNIFORM_BUFLEN (POLY_UNIFORM_NBLOCKS*STREAM128_BLOCKBYTES)
+
+static void poly_uniform_single(poly *a, const uint8_t seed[SEEDBYTES], uint16_t nonce) {
+  unsigned int i, ctr, off;
+  unsigned int buflen = POLY_UNIFORM_BUFLEN;
+  uint8_t buf[POLY_UNIFORM_BUFLEN + 2];
+  stream128_state state;
+
+  stream128_init(&state, seed, nonce);
+  stream128_squeezeblocks(buf, POLY_UNIFORM_NBLOCKS, &state);
+
+  ctr = rej_uniform(a->coeffs, N, buf, buflen);
+
+  while (ctr < N) {
+    off = buflen % 3;
+    for (i = 0; i < off; ++i)
+      buf[i] = buf[buflen - off + i];
+
+    stream128_squeezeblocks(buf + off, 1, &state);
+    buflen = STREAM128_BLOCKBYTES + off;
+    ctr += rej_uniform(a->coeffs + ctr, N - ctr, buf, buflen);
+  }
+}
+
+#if defined(__wasm_simd128__)
+// Pares com o Keccak x2 e, se o lote for ímpar, um polinômio isolado
+void poly_uniform(poly *a[], const uint8_t seed[SEEDBYTES], uint16_t nonce[], int batch_size) {
+  int idx = 0;
+
+  for (; idx + 2 <= batch_size; idx += 2)
+    poly_uniform_2x(a[idx], a[idx + 1], seed, nonce[idx], nonce[idx + 1]);
+
+  if (idx < batch_size)
+    poly_uniform_single(a[idx], seed, nonce[idx]);
+}
+
+/******************************************************************************
+ * Name:        poly_uniform_2x
+ *
+ * Description: Sample two polynomials with uniformly random coefficients
+ *              in [0,Q-1] by performing rejection sampling on the
+ *              output stream of SHAKE128x2(seed|nonce0, seed|nonce1)
+ *
+ * Arguments:   - poly *a0, *a1: pointers to output polynomials
+ *              - const uint8_t seed[]: byte array with seed of length SEEDBYTES
+ *              - uint16_t nonce0, nonce1: 2-byte nonces
+ * *******************************************************************************/
+void poly_uniform_2x(poly *a0, poly *a1, const uint8_t seed[SEEDBYTES], uint16_t nonce0, uint16_t nonce1) {
+  unsigned int ctr0, ctr1;
+  uint8_t buf[2][SEEDBYTES + 2];
+  uint8_t outbuf[2][REJ_UNIFORM_BUFLEN];
+  keccakx2_state state;
+
+  memcpy(buf[0], seed, SEEDBYTES);
+  memcpy(buf[1], seed, SEEDBYTES);
+  buf[0][SEEDBYTES + 0] = (uint8_t)(nonce0 & 0xFF);
+  buf[0][SEEDBYTES + 1] = (uint8_t)(nonce0 >> 8);
+  buf[1][SEEDBYTES + 0] = (uint8_t)(nonce1 & 0xFF);
+  buf[1][SEEDBYTES + 1] = (uint8_t)(nonce1 >> 8);
+
+  FIPS202X2_NAMESPACE(shake128x2_absorb_once)(&state, buf[0], buf[1], SEEDBYTES + 2);
+  FIPS202X2_NAMESPACE(shake128x2_squeezeblocks)(outbuf[0], outbuf[1], REJ_UNIFORM_NBLOCKS, &state);
+
+  ctr0 = rej_uniform(a0->coeffs, N, outbuf[0], REJ_UNIFORM_BUFLEN);
+  ctr1 = rej_uniform(a1->coeffs, N, outbuf[1], REJ_UNIFORM_BUFLEN);
+
+  // REJ_UNIFORM_BUFLEN é múltiplo de 3: nenhum byte sobra entre os blocos
+  while (ctr0 < N || ctr1 < N) {
+    FIPS202X2_NAMESPACE(shake128x2_squeezeblocks)(outbuf[0], outbuf[1], 1, &state);
+
+    ctr0 += rej_uniform(a0->coeffs + ctr0, N - ctr0, outbuf[0], SHAKE128_RATE);
+    ctr1 += rej_uniform(a1->coeffs + ctr1, N - ctr1, outbuf[1], SHAKE128_RATE);
+  }
+}
+
+/******************************************************************************
+ * Name:        poly_uniform_3x
+ *
+ * Description: Same as in poly_neon.c: a pair with SHAKE128x2 and the
+ *              third polynomial on its own.
+ * *******************************************************************************/
+void poly_uniform_3x(poly *a0, poly *a1, poly *a2, const uint8_t seed[SEEDBYTES],
+                     uint16_t nonce0, uint16_t nonce1, uint16_t nonce2) {
+  poly_uniform_2x(a0, a1, seed, nonce0, nonce1);
+  poly_uniform_single(a2, seed, nonce2);
+}
+#else
+void poly_uniform(poly *a[], const uint8_t seed[SEEDBYTES], uint16_t nonce[], int batch_size) {
+  int idx;
+
+  for (idx = 0; idx < batch_size; ++idx)
+    poly_uniform_single(a[idx], seed, nonce[idx]);
+}
+
+/******************************************************************************
+ * Name:        poly_uniform_2x / poly_uniform_3x
+ *
+ * Description: Same as in poly_neon.c, one polynomial after the other.
+ * *******************************************************************************/
+void poly_uniform_2x(poly *a0, poly *a1, const uint8_t seed[SEEDBYTES], uint16_t nonce0, uint16_t nonce1) {
+  poly_uniform_single(a0, seed, nonce0);
+  poly_uniform_single(a1, seed, nonce1);
+}
+
+void poly_uniform_3x(poly *a0, poly *a1, poly *a2, const uint8_t seed[SEEDBYTES],
+                     uint16_t nonce0, uint16_t nonce1, uint16_t nonce2) {
+  poly_uniform_single(a0, seed, nonce0);
+  poly_uniform_single(a1, seed, nonce1);
+  poly_uniform_single(a2, seed, nonce2);
+}
+#endif
+
+/*************************************************
+* Name:        rej_eta
+*
+* Description: Sample uniformly random coefficients in [-ETA, ETA] by
+*              performing rejection sampling on array of random bytes.
+*
+* Arguments:   - int32_t *a: pointer to output array (allocated)
+*              - unsigned int len: number of coefficients to be sampled
+*              - const uint8_t *buf: array of random bytes
+*              - unsigned int buflen: length of array of random bytes
+*
+* Returns number of sampled coefficients. Can be smaller than len if not enough
+* random bytes were given.
+**************************************************/
+static unsigned int rej_eta(int32_t *a, unsigned int len, const uint8_t *buf, unsigned int buflen) {
+  unsigned int ctr = 0, pos = 0;
+  uint32_t t0, t1;
+
+  while (ctr < len && pos < buflen) {
+    t0 = buf[pos] & 0x0F;
+    t1 = buf[pos++] >> 4;
+
+#if ETA == 2
+    if (t0 < 15) {
+      t0 = t0 - (205*t0 >> 10)*5;
+      a[ctr++] = 2 - t0;
+    }
+    if (t1 < 15 && ctr < len) {
+      t1 = t1 - (205*t1 >> 10)*5;
+      a[ctr++] = 2 - t1;
+    }
+#elif ETA == 4
+    if (t0 < 9)
+      a[ctr++] = 4 - t0;
+    if (t1 < 9 && ctr < len)
+      a[ctr++] = 4 - t1;
+#endif
+  }
+
+  return ctr;
+}
+
+/*************************************************
+* Name:        poly_uniform_eta
+*
+* Description: Sample polynomial with uniformly random coefficients
+*              in [-ETA,ETA] by performing rejection sampling on the
+*              output stream from SHAKE256(seed|nonce)
+*
+* Arguments:   - poly *a: pointer to output polynomial
+*              - const uint8_t seed[]: byte array with seed of length CRHBYTES
+*              - uint16_t nonce: 2-byte nonce
+**************************************************/
+#if ETA == 2
+#define POLY_UNIFORM_ETA_NBLOCKS ((136 + STREAM256_BLOCKBYTES - 1)/STREAM256_BLOCKBYTES)
+#elif ETA == 4
+#define POLY_UNIFORM_ETA_NBLOCKS ((227 + STREAM256_BLOCKBYTES - 1)/STREAM256_BLOCKBYTES)
+#endif
+void poly_uniform_eta(poly *a,
+                      const uint8_t seed[CRHBYTES],
+                      uint16_t nonce)
+{
+  unsigned int ctr;
+  unsigned int buflen = POLY_UNIFORM_ETA_NBLOCKS*STREAM256_BLOCKBYTES;
+  uint8_t buf[POLY_UNIFORM_ETA_NBLOCKS*STREAM256_BLOCKBYTES];
+  stream256_state state;
+
+  stream256_init(&state, seed, nonce);
+  stream256_squeezeblocks(buf, POLY_UNIFORM_ETA_NBLOCKS, &state);
+
+  ctr = rej_eta(a->coeffs, N, buf, buflen);
+
+  while(ctr < N) {
+    stream256_squeezeblocks(buf, 1, &state);
+    ctr += rej_eta(a->coeffs + ctr, N - ctr, buf, STREAM256_BLOCKBYTES);
+  }
+}
+
+#if defined(__wasm_simd128__)
+#define POLY_UNIFORM_GAMMA1_NBLOCKS ((POLYZ_PACKEDBYTES + STREAM256_BLOCKBYTES - 1)/STREAM256_BLOCKBYTES)
+
+/******************************************************************************
+ * Name:        poly_uniform_gamma1_2x
+ *
+ * Description: Sample two polynomials with uniformly random coefficients
+ *              in [-(GAMMA1 - 1), GAMMA1] from SHAKE256x2(seed|nonce0,
+ *              seed|nonce1)
+ *
+ * Arguments:   - poly *a0, *a1: pointers to output polynomials
+ *              - const uint8_t seed[]: byte array with seed of length CRHBYTES
+ *              - uint16_t nonce0, nonce1: 16-bit nonces
+ * *******************************************************************************/
+void poly_uniform_gamma1_2x(poly *a0, poly *a1, const uint8_t seed[64],
+                            uint16_t nonce0, uint16_t nonce1) {
+  uint8_t buf[2][POLY_UNIFORM_GAMMA1_NBLOCKS * STREAM256_BLOCKBYTES];
+  keccakx2_state state;
+
+  memcpy(buf[0], seed, 64);
+  memcpy(buf[1], seed, 64);
+  buf[0][64] = nonce0 & 0xFF;
+  buf[0][65] = (nonce0 >> 8) & 0xFF;
+  buf[1][64] = nonce1 & 0xFF;
+  buf[1][65] = (nonce1 >> 8) & 0xFF;
+
+  FIPS202X2_NAMESPACE(shake256x2_absorb)(&state, buf[0], buf[1], 66);
+  FIPS202X2_NAMESPACE(shake256x2_squeezeblocks)(buf[0], buf[1], POLY_UNIFORM_GAMMA1_NBLOCKS, &state);
+
+  polyz_unpack(a0, buf[0]);
+  polyz_unpack(a1, buf[1]);
+}
+
+void poly_uniform_gamma1_3x(poly *a0, poly *a1, poly *a2, const uint8_t seed[64],
+                            uint16_t nonce0, uint16_t nonce1, uint16_t nonce2) {
+  poly_uniform_gamma1_2x(a0, a1, seed, nonce0, nonce1);
+  poly_uniform_gamma1(a2, seed, nonce2);
+}
+#else
+/******************************************************************************
+ * Name:        poly_uniform_gamma1_2x / poly_uniform_gamma1_3x
+ *
+ * Description: Same as in poly_neon.c, one polynomial after the other.
+ * *******************************************************************************/
+void poly_uniform_gamma1_2x(poly *a0, poly *a1, const uint8_t seed[64],
+                            uint16_t nonce0, uint16_t nonce1) {
+  poly_uniform_gamma1(a0, seed, nonce0);
+  poly_uniform_gamma1(a1, seed, nonce1);
+}
+
+void poly_uniform_gamma1_3x(poly *a0, poly *a1, poly *a2, const uint8_t seed[64],
+                            uint16_t nonce0, uint16_t nonce1, uint16_t nonce2) {
+  poly_uniform_gamma1(a0, seed, nonce0);
+  poly_uniform_gamma1(a1, seed, nonce1);
+  poly_uniform_gamma1(a2, seed, nonce2);
+}
+#endif
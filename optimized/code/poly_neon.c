@@ -0,0 +1,900 @@
+#include <stdint.h>
+#include <string.h>
+#include <arm_neon.h>
+#include "params.h"
+#include "poly.h"
+#include "reduce.h"
+#include "symmetric.h"
+#include "fips202x2.h"
+#include "fips202x3.h"
+
+/* Amostragem NEON de poly.h com os Keccak x2/x3 e rej_eta, e o
+ * empacotamento de eta, t1, t0, z e w1. A aritmética coeficiente a
+ * coeficiente e rej_uniform vêm de poly_simd.c; a versão AVX2 da
+ * amostragem está em poly_avx2.c e o restante de poly.h fica em poly.c.
+ * Com SVE (ARCH=sve/sve2), a aritmética e a rejeição vêm de poly_sve.c;
+ * num binário NEON com DILITHIUM_RUNTIME_DISPATCH, só a rejeição, se o
+ * núcleo em execução tiver SVE. */
+
+#ifdef DBENCH
+#include "test/cpucycles.h"
+extern const uint64_t timing_overhead;
+extern uint64_t *tred, *tadd, *tmul, *tround, *tsample, *tpack;
+#define DBENCH_START() uint64_t time = cpucycles()
+#define DBENCH_STOP(t) t += cpucycles() - time - timing_overhead
+#else
+#define DBENCH_START()
+#define DBENCH_STOP(t)
+#endif
+
+#if defined(__ARM_FEATURE_SVE)
+// Com SVE, a rejeição (svcompact) vem de poly_sve.c
+#define rej_uniform rej_uniform_sve
+#define rej_eta rej_eta_sve
+#elif defined(POLY_SVE_DISPATCH)
+// SVE opcional: as versões de poly_sve.c são escolhidas em rej_dispatch
+static unsigned int rej_eta_neon(int32_t *a, unsigned int len, const uint8_t *buf, unsigned int buflen);
+static unsigned int (*rej_uniform_impl)(int32_t *a, unsigned int len, const uint8_t *buf,
+                                        unsigned int buflen) = rej_uniform_simd;
+static unsigned int (*rej_eta_impl)(int32_t *a, unsigned int len, const uint8_t *buf,
+                                    unsigned int buflen) = rej_eta_neon;
+#define rej_uniform rej_uniform_impl
+#define rej_eta rej_eta_impl
+#else
+#define rej_uniform rej_uniform_simd
+#define rej_eta rej_eta_neon
+#endif
+
+/*************************************************
+* Name:        poly_uniform
+*
+* Description: Sample polynomial with uniformly random coefficients
+*              in [0,Q-1] by performing rejection sampling on the
+*              output stream of SHAKE128(seed|nonce)
+*
+* Arguments:   - poly *a: pointer to output polynomial
+*              - const uint8_t seed[]: byte array with seed of length SEEDBYTES
+*              - uint16_t nonce: 2-byte nonce
+**************************************************/
+#define POLY_UNIFORM_NBLOCKS ((768 + STREAM128_BLOCKBYTES - 1)/STREAM128_BLOCKBYTES)
+
+// Amostra um único polinômio, com estado e buffer de tamanho fixo (sem VLAs)
+static void poly_uniform_single(poly *a, const uint8_t seed[SEEDBYTES], uint16_t nonce) {
+    unsigned int i, ctr, off;
+    unsigned int buflen = POLY_UNIFORM_NBLOCKS * STREAM128_BLOCKBYTES;
+    uint8_t buf[POLY_UNIFORM_NBLOCKS * STREAM128_BLOCKBYTES + 2];
+    stream128_state state;
+
+    stream128_init(&state, seed, nonce);
+    stream128_squeezeblocks(buf, POLY_UNIFORM_NBLOCKS, &state);
+
+    // Executa a rejeição utilizando a versão otimizada
+    ctr = rej_uniform(a->coeffs, N, buf, buflen);
+
+    // Se não preencheu todos os coeficientes, squeeze mais blocos
+    while (ctr < N) {
+        off = buflen % 3;
+        // Ajusta o buffer
+        for (i = 0; i < off; ++i)
+            buf[i] = buf[buflen - off + i];
+
+        stream128_squeezeblocks(buf + off, 1, &state);
+        buflen = STREAM128_BLOCKBYTES + off;
+        ctr += rej_uniform(a->coeffs + ctr, N - ctr, buf, buflen);
+    }
+}
+
+// Processa o lote em grupos de três (Keccak híbrido NEON + escalar), depois
+// pares (Keccak x2) e por fim um polinômio isolado
+void poly_uniform(poly *a[], const uint8_t seed[SEEDBYTES], uint16_t nonce[], int batch_size) {
+    // 'a' é um array de ponteiros para polinômios
+    // 'seed' é a semente
+    // 'nonce' é um array de nonces
+    // 'batch_size' é o número de polinômios a serem processados
+    int idx = 0;
+
+    for (; idx + 3 <= batch_size; idx += 3)
+        poly_uniform_3x(a[idx], a[idx + 1], a[idx + 2], seed, nonce[idx], nonce[idx + 1], nonce[idx + 2]);
+
+    if (batch_size - idx == 2)
+        poly_uniform_2x(a[idx], a[idx + 1], seed, nonce[idx], nonce[idx + 1]);
+    else if (batch_size - idx == 1)
+        poly_uniform_single(a[idx], seed, nonce[idx]);
+}
+
+
+
+/******************************************************************************
+ * Name:        poly_uniform_2x
+ *  
+ * Description: Sample two polynomials with uniformly random coefficients
+ *             in [0,Q-1] by performing rejection sampling on the
+ *            output stream of SHAKE128(seed|nonce0, nonce1)
+ *      
+ * Arguments:   - poly *a0: pointer to output polynomial
+ *             - poly *a1: pointer to output polynomial
+ *            - const uint8_t seed[]: byte array with seed of length SEEDBYTES
+ *           - uint16_t nonce0: 2-byte nonce
+ *         - uint16_t nonce1: 2-byte nonce
+ * *******************************************************************************/
+
+void poly_uniform_2x(poly *a0, poly *a1, const uint8_t seed[SEEDBYTES], uint16_t nonce0, uint16_t nonce1) {
+    unsigned int ctr0 = 0, ctr1 = 0;
+    uint8_t buf0[SEEDBYTES + 2];
+    uint8_t buf1[SEEDBYTES + 2];
+    keccakx2_state state;
+
+    // Preparação dos Buffers
+    memcpy(buf0, seed, SEEDBYTES);
+    memcpy(buf1, seed, SEEDBYTES);
+
+    buf0[SEEDBYTES + 0] = (uint8_t)(nonce0 & 0xFF);
+    buf0[SEEDBYTES + 1] = (uint8_t)(nonce0 >> 8);
+    buf1[SEEDBYTES + 0] = (uint8_t)(nonce1 & 0xFF);
+    buf1[SEEDBYTES + 1] = (uint8_t)(nonce1 >> 8);
+
+    // Absorção com SHAKE128x2
+    FIPS202X2_NAMESPACE(shake128x2_absorb_once)(&state, buf0, buf1, SEEDBYTES + 2);
+
+    // Squeeze Inicial (buffers locais: a função precisa ser reentrante)
+    uint8_t outbuf0[REJ_UNIFORM_BUFLEN];
+    uint8_t outbuf1[REJ_UNIFORM_BUFLEN];
+    FIPS202X2_NAMESPACE(shake128x2_squeezeblocks)(outbuf0, outbuf1, REJ_UNIFORM_NBLOCKS, &state);
+
+    // Rejeição Uniforme Otimizada
+    ctr0 = rej_uniform(a0->coeffs, N, outbuf0, REJ_UNIFORM_BUFLEN);
+    ctr1 = rej_uniform(a1->coeffs, N, outbuf1, REJ_UNIFORM_BUFLEN);
+
+    // Loop de Rejeição Adicional
+    while (ctr0 < N || ctr1 < N) {
+        FIPS202X2_NAMESPACE(shake128x2_squeezeblocks)(outbuf0, outbuf1, 1, &state);
+
+        ctr0 += rej_uniform(a0->coeffs + ctr0, N - ctr0, outbuf0, SHAKE128_RATE);
+        ctr1 += rej_uniform(a1->coeffs + ctr1, N - ctr1, outbuf1, SHAKE128_RATE);
+    }
+}
+
+
+/******************************************************************************
+ * Name:        poly_uniform_3x
+ *
+ * Description: Sample three polynomials with uniformly random coefficients
+ *             in [0,Q-1] by performing rejection sampling on the
+ *            output stream of SHAKE128x3(seed|nonce0, nonce1, nonce2)
+ *
+ * Arguments:   - poly *a0: pointer to output polynomial
+ *             - poly *a1: pointer to output polynomial
+ *             - poly *a2: pointer to output polynomial
+ *            - const uint8_t seed[]: byte array with seed of length SEEDBYTES
+ *           - uint16_t nonce0: 2-byte nonce
+ *           - uint16_t nonce1: 2-byte nonce
+ *         - uint16_t nonce2: 2-byte nonce
+ * *******************************************************************************/
+void poly_uniform_3x(poly *a0, poly *a1, poly *a2, const uint8_t seed[SEEDBYTES],
+                     uint16_t nonce0, uint16_t nonce1, uint16_t nonce2) {
+    unsigned int ctr0, ctr1, ctr2;
+    uint8_t buf[3][SEEDBYTES + 2];
+    uint8_t outbuf[3][REJ_UNIFORM_BUFLEN];
+    keccakx3_state state;
+
+    // Preparação dos Buffers
+    memcpy(buf[0], seed, SEEDBYTES);
+    memcpy(buf[1], seed, SEEDBYTES);
+    memcpy(buf[2], seed, SEEDBYTES);
+
+    buf[0][SEEDBYTES + 0] = (uint8_t)(nonce0 & 0xFF);
+    buf[0][SEEDBYTES + 1] = (uint8_t)(nonce0 >> 8);
+    buf[1][SEEDBYTES + 0] = (uint8_t)(nonce1 & 0xFF);
+    buf[1][SEEDBYTES + 1] = (uint8_t)(nonce1 >> 8);
+    buf[2][SEEDBYTES + 0] = (uint8_t)(nonce2 & 0xFF);
+    buf[2][SEEDBYTES + 1] = (uint8_t)(nonce2 >> 8);
+
+    // Absorção com SHAKE128x3
+    FIPS202X3_NAMESPACE(shake128x3_absorb)(&state, buf[0], buf[1], buf[2], SEEDBYTES + 2);
+
+    // Squeeze Inicial
+    FIPS202X3_NAMESPACE(shake128x3_squeezeblocks)(outbuf[0], outbuf[1], outbuf[2], REJ_UNIFORM_NBLOCKS, &state);
+
+    ctr0 = rej_uniform(a0->coeffs, N, outbuf[0], REJ_UNIFORM_BUFLEN);
+    ctr1 = rej_uniform(a1->coeffs, N, outbuf[1], REJ_UNIFORM_BUFLEN);
+    ctr2 = rej_uniform(a2->coeffs, N, outbuf[2], REJ_UNIFORM_BUFLEN);
+
+    // Loop de Rejeição Adicional
+    while (ctr0 < N || ctr1 < N || ctr2 < N) {
+        FIPS202X3_NAMESPACE(shake128x3_squeezeblocks)(outbuf[0], outbuf[1], outbuf[2], 1, &state);
+
+        ctr0 += rej_uniform(a0->coeffs + ctr0, N - ctr0, outbuf[0], SHAKE128_RATE);
+        ctr1 += rej_uniform(a1->coeffs + ctr1, N - ctr1, outbuf[1], SHAKE128_RATE);
+        ctr2 += rej_uniform(a2->coeffs + ctr2, N - ctr2, outbuf[2], SHAKE128_RATE);
+    }
+}
+
+
+
+#if !defined(__ARM_FEATURE_SVE)
+/*************************************************
+* Name:        rej_eta_neon
+*
+* Description: Sample uniformly random coefficients in [-ETA, ETA] by
+*              performing rejection sampling on array of random bytes.
+*
+* Arguments:   - int32_t *a: pointer to output array (allocated)
+*              - unsigned int len: number of coefficients to be sampled
+*              - const uint8_t *buf: array of random bytes
+*              - unsigned int buflen: length of array of random bytes
+*
+* Returns number of sampled coefficients. Can be smaller than len if not enough
+* random bytes were given.
+**************************************************/
+// Tabela de lookup somente para ETA = 4
+#if ETA == 4
+static const int8_t eta4_lookup[16] = {4, 3, 2, 1, 0, -1, -2, -3, -4, -1, -1, -1, -1, -1, -1, -1};
+#endif
+
+static unsigned int rej_eta_neon(int32_t *a, unsigned int len, const uint8_t *buf, unsigned int buflen) {
+  unsigned int ctr = 0, pos = 0;
+
+#if ETA == 2
+  // Para ETA = 2, o ajuste precisa ser feito em todos os valores
+  while (ctr < len && pos < buflen) {
+    uint32_t t0 = buf[pos] & 0x0F;
+    uint32_t t1 = buf[pos++] >> 4;
+
+    if (t0 < 15) {
+      t0 = t0 - (205 * t0 >> 10) * 5;
+      a[ctr++] = 2 - t0;
+    }
+
+    if (t1 < 15 && ctr < len) {
+      t1 = t1 - (205 * t1 >> 10) * 5;
+      a[ctr++] = 2 - t1;
+    }
+  }
+#elif ETA == 4
+  // Para ETA = 4: 8 bytes -> 16 nibbles na ordem da amostragem
+  // (baixo, alto, baixo, alto, ...), mapeados por 4 - t com a tabela
+  int8x16_t lookup = vld1q_s8(eta4_lookup);
+  uint8x16_t bound = vdupq_n_u8(9);
+
+  while (ctr + 16 <= len && pos + 8 <= buflen) {
+    uint8x16_t vec = vcombine_u8(vld1_u8(&buf[pos]), vdup_n_u8(0));
+    pos += 8;
+
+    uint8x16_t lo = vandq_u8(vec, vdupq_n_u8(0x0F));
+    uint8x16_t hi = vshrq_n_u8(vec, 4);
+    uint8x16_t t = vzip1q_u8(lo, hi);
+
+    int8_t vals[16];
+    uint8_t ok[16];
+    vst1q_s8(vals, vqtbl1q_s8(lookup, t));
+    vst1q_u8(ok, vcltq_u8(t, bound));
+
+    // Aceita apenas t < 9, na ordem original
+    for (int i = 0; i < 16; ++i) {
+      if (ok[i])
+        a[ctr++] = vals[i];
+    }
+  }
+
+  // Processar quaisquer bytes restantes
+  while (ctr < len && pos < buflen) {
+    uint32_t t0 = buf[pos] & 0x0F;
+    uint32_t t1 = buf[pos++] >> 4;
+
+    if (t0 < 9)
+      a[ctr++] = eta4_lookup[t0];
+    if (t1 < 9 && ctr < len)
+      a[ctr++] = eta4_lookup[t1];
+  }
+#endif
+
+  return ctr;
+}
+#endif
+
+#if defined(POLY_SVE_DISPATCH)
+// Escolhe a rejeição uma única vez, ao carregar o binário/biblioteca
+__attribute__((constructor))
+static void rej_dispatch(void) {
+  if(dilithium_cpu_features() & CPU_FEATURE_SVE) {
+    rej_uniform_impl = rej_uniform_sve;
+    rej_eta_impl = rej_eta_sve;
+  }
+}
+#endif
+
+/*************************************************
+* Name:        poly_uniform_eta
+*
+* Description: Sample polynomial with uniformly random coefficients
+*              in [-ETA,ETA] by performing rejection sampling on the
+*              output stream from SHAKE256(seed|nonce)
+*
+* Arguments:   - poly *a: pointer to output polynomial
+*              - const uint8_t seed[]: byte array with seed of length CRHBYTES
+*              - uint16_t nonce: 2-byte nonce
+**************************************************/
+#if ETA == 2
+#define POLY_UNIFORM_ETA_NBLOCKS ((136 + STREAM256_BLOCKBYTES - 1)/STREAM256_BLOCKBYTES)
+#elif ETA == 4
+#define POLY_UNIFORM_ETA_NBLOCKS ((227 + STREAM256_BLOCKBYTES - 1)/STREAM256_BLOCKBYTES)
+#endif
+void poly_uniform_eta(poly *a,
+                      const uint8_t seed[CRHBYTES],
+                      uint16_t nonce)
+{
+  unsigned int ctr;
+  unsigned int buflen = POLY_UNIFORM_ETA_NBLOCKS*STREAM256_BLOCKBYTES;
+  uint8_t buf[POLY_UNIFORM_ETA_NBLOCKS*STREAM256_BLOCKBYTES];
+  stream256_state state;
+
+  stream256_init(&state, seed, nonce);
+  stream256_squeezeblocks(buf, POLY_UNIFORM_ETA_NBLOCKS, &state);
+
+  ctr = rej_eta(a->coeffs, N, buf, buflen);
+
+  while(ctr < N) {
+    stream256_squeezeblocks(buf, 1, &state);
+    ctr += rej_eta(a->coeffs + ctr, N - ctr, buf, STREAM256_BLOCKBYTES);
+  }
+}
+
+#define POLY_UNIFORM_GAMMA1_NBLOCKS ((POLYZ_PACKEDBYTES + STREAM256_BLOCKBYTES - 1)/STREAM256_BLOCKBYTES)
+
+void poly_uniform_gamma1_2x(poly *a0, poly *a1, const uint8_t seed[64], 
+                            uint16_t nonce0, uint16_t nonce1) {
+  uint8_t buf[2][POLY_UNIFORM_GAMMA1_NBLOCKS * STREAM256_BLOCKBYTES + 14];
+  uint64x2x4_t f;
+  keccakx2_state state;
+
+  // Copiar os 64 bytes do seed para os dois buffers usando registradores NEON
+  f = vld1q_u64_x4((const uint64_t *)&seed[0]);
+  vst1q_u64_x4((uint64_t *)&buf[0][0], f);
+  vst1q_u64_x4((uint64_t *)&buf[1][0], f);
+
+  // Definir os nonces nos buffers
+  buf[0][64] = nonce0 & 0xFF;
+  buf[0][65] = (nonce0 >> 8) & 0xFF;
+  buf[1][64] = nonce1 & 0xFF;
+  buf[1][65] = (nonce1 >> 8) & 0xFF;
+
+  // Absorver os dados para os 2 polinômios simultaneamente
+  FIPS202X2_NAMESPACE(shake256x2_absorb)(&state, buf[0], buf[1], 66);
+
+  // Realizar squeezeblocks para obter os coeficientes
+  FIPS202X2_NAMESPACE(shake256x2_squeezeblocks)(buf[0], buf[1], POLY_UNIFORM_GAMMA1_NBLOCKS, &state);
+
+  // Descompactar os coeficientes em polinômios
+  polyz_unpack(a0, buf[0]);
+  polyz_unpack(a1, buf[1]);
+}
+
+void poly_uniform_gamma1_3x(poly *a0, poly *a1, poly *a2, const uint8_t seed[64],
+                            uint16_t nonce0, uint16_t nonce1, uint16_t nonce2) {
+  uint8_t buf[3][POLY_UNIFORM_GAMMA1_NBLOCKS * STREAM256_BLOCKBYTES + 14];
+  uint64x2x4_t f;
+  keccakx3_state state;
+
+  // Copiar os 64 bytes do seed para os três buffers usando registradores NEON
+  f = vld1q_u64_x4((const uint64_t *)&seed[0]);
+  vst1q_u64_x4((uint64_t *)&buf[0][0], f);
+  vst1q_u64_x4((uint64_t *)&buf[1][0], f);
+  vst1q_u64_x4((uint64_t *)&buf[2][0], f);
+
+  // Definir os nonces nos buffers
+  buf[0][64] = nonce0 & 0xFF;
+  buf[0][65] = (nonce0 >> 8) & 0xFF;
+  buf[1][64] = nonce1 & 0xFF;
+  buf[1][65] = (nonce1 >> 8) & 0xFF;
+  buf[2][64] = nonce2 & 0xFF;
+  buf[2][65] = (nonce2 >> 8) & 0xFF;
+
+  // Absorver os dados para os 3 polinômios simultaneamente
+  FIPS202X3_NAMESPACE(shake256x3_absorb)(&state, buf[0], buf[1], buf[2], 66);
+
+  // Realizar squeezeblocks para obter os coeficientes
+  FIPS202X3_NAMESPACE(shake256x3_squeezeblocks)(buf[0], buf[1], buf[2], POLY_UNIFORM_GAMMA1_NBLOCKS, &state);
+
+  // Descompactar os coeficientes em polinômios
+  polyz_unpack(a0, buf[0]);
+  polyz_unpack(a1, buf[1]);
+  polyz_unpack(a2, buf[2]);
+}
+
+/* Empacotamento. Os coeficientes de um grupo são unidos dois a dois com
+ * vsli em lanes cada vez mais largas até que o grupo inteiro ocupe os bytes
+ * iniciais de um registrador: 8 coeficientes de t1 (10 bytes) ou de t0
+ * (13 bytes), 4 de z (9 ou 10 bytes). No desempacotamento, vqtbl leva os
+ * bytes de cada coeficiente à sua lane e vshl os alinha com deslocamentos
+ * por lane. Os grupos são gravados e lidos com 16 bytes, sobrepostos; só o
+ * último grupo de cada polinômio passa por um buffer, para não acessar
+ * além do fim do polinômio empacotado. */
+
+// [A, B] com A e B de n bits (32 < n < 64): A | B << n nos bytes iniciais
+#define join_u64(x, n) \
+  vcopyq_laneq_u64(vsliq_n_u64(x, vdupq_laneq_u64(x, 1), n), 1, vshrq_n_u64(x, 64 - (n)), 1)
+
+// Metades baixas de 8 coeficientes consecutivos (a, b) em ordem
+static inline uint16x8_t narrow_s32_u16(int32x4_t a, int32x4_t b) {
+  return vuzp1q_u16(vreinterpretq_u16_s32(a), vreinterpretq_u16_s32(b));
+}
+
+// Bytes baixos de 16 coeficientes consecutivos (a, b, c, d) em ordem
+static inline uint8x16_t narrow_s32_u8(int32x4_t a, int32x4_t b, int32x4_t c, int32x4_t d) {
+  return vuzp1q_u8(vreinterpretq_u8_u16(narrow_s32_u16(a, b)),
+                   vreinterpretq_u8_u16(narrow_s32_u16(c, d)));
+}
+
+static inline uint8x16_t load_u8_16(const int32_t *a) {
+  return narrow_s32_u8(vld1q_s32(&a[0]), vld1q_s32(&a[4]), vld1q_s32(&a[8]), vld1q_s32(&a[12]));
+}
+
+// 8 coeficientes de 16 bits com sinal em a[0..7]
+static inline void store_s16(int32_t *a, int16x8_t x) {
+  vst1q_s32(&a[0], vmovl_s16(vget_low_s16(x)));
+  vst1q_s32(&a[4], vmovl_high_s16(x));
+}
+
+#if ETA == 2
+// Bytes dos grupos de 3 bytes nas lanes de 64 bits de dois registradores
+static const uint8_t polyeta_pack_idx[16] = {0, 1, 2, 8, 9, 10, 16, 17, 18, 24, 25, 26, 255, 255, 255, 255};
+// Pares de bytes e deslocamentos dos 8 coeficientes de um grupo de 3 bytes
+static const uint8_t polyeta_unpack_idx[16] = {0, 1, 0, 1, 0, 1, 1, 2, 1, 2, 1, 2, 2, 3, 2, 3};
+static const int16_t polyeta_unpack_shift[8] = {0, -3, -6, -1, -4, -7, -2, -5};
+
+// ETA - a de 32 coeficientes em 12 bytes
+static inline uint8x16_t polyeta_pack32(const int32_t *a) {
+  const uint8x16_t eta = vdupq_n_u8(ETA);
+  uint8x16x2_t t;
+  uint16x8_t h;
+  uint32x4_t w;
+  uint64x2_t d;
+  unsigned int k;
+
+  for(k = 0; k < 2; ++k) {
+    // 3 -> 6 -> 12 -> 24 bits: 8 coeficientes em cada lane de 64 bits
+    h = vreinterpretq_u16_u8(vsubq_u8(eta, load_u8_16(&a[16*k])));
+    h = vsliq_n_u16(h, vshrq_n_u16(h, 8), 3);
+    w = vreinterpretq_u32_u16(h);
+    w = vsliq_n_u32(w, vshrq_n_u32(w, 16), 6);
+    d = vreinterpretq_u64_u32(w);
+    t.val[k] = vreinterpretq_u8_u64(vsliq_n_u64(d, vshrq_n_u64(d, 32), 12));
+  }
+
+  return vqtbl2q_u8(t, vld1q_u8(polyeta_pack_idx));
+}
+
+// 32 coeficientes a partir de 12 bytes
+static inline void polyeta_unpack32(int32_t *r, uint8x16_t a) {
+  const uint8x16_t idx = vld1q_u8(polyeta_unpack_idx);
+  const int16x8_t shift = vld1q_s16(polyeta_unpack_shift);
+  uint16x8_t t;
+  unsigned int k;
+
+  for(k = 0; k < 4; ++k) {
+    t = vreinterpretq_u16_u8(vqtbl1q_u8(a, vaddq_u8(idx, vdupq_n_u8(3*k))));
+    t = vandq_u16(vshlq_u16(t, shift), vdupq_n_u16(7));
+    store_s16(&r[8*k], vreinterpretq_s16_u16(vsubq_u16(vdupq_n_u16(ETA), t)));
+  }
+}
+#endif
+
+/*************************************************
+* Name:        polyeta_pack
+*
+* Description: Bit-pack polynomial with coefficients in [-ETA,ETA].
+*
+* Arguments:   - uint8_t *r: pointer to output byte array with at least
+*                            POLYETA_PACKEDBYTES bytes
+*              - const poly *a: pointer to input polynomial
+**************************************************/
+void polyeta_pack(uint8_t *r, const poly *a) {
+  unsigned int i;
+  DBENCH_START();
+
+#if ETA == 2
+  uint8_t buf[16];
+
+  for(i = 0; i < N/32 - 1; ++i)
+    vst1q_u8(&r[12*i], polyeta_pack32(&a->coeffs[32*i]));
+
+  vst1q_u8(buf, polyeta_pack32(&a->coeffs[N - 32]));
+  memcpy(&r[POLYETA_PACKEDBYTES - 12], buf, 12);
+#elif ETA == 4
+  const uint8x16_t eta = vdupq_n_u8(ETA);
+  int32x4x2_t t0, t1, t2, t3;
+  uint8x16_t c0, c1;
+
+  for(i = 0; i < N/32; ++i) {
+    // vld2 separa os coeficientes pares e ímpares
+    t0 = vld2q_s32(&a->coeffs[32*i]);
+    t1 = vld2q_s32(&a->coeffs[32*i + 8]);
+    t2 = vld2q_s32(&a->coeffs[32*i + 16]);
+    t3 = vld2q_s32(&a->coeffs[32*i + 24]);
+    c0 = vsubq_u8(eta, narrow_s32_u8(t0.val[0], t1.val[0], t2.val[0], t3.val[0]));
+    c1 = vsubq_u8(eta, narrow_s32_u8(t0.val[1], t1.val[1], t2.val[1], t3.val[1]));
+    vst1q_u8(&r[16*i], vsliq_n_u8(c0, c1, 4));
+  }
+#endif
+
+  DBENCH_STOP(*tpack);
+}
+
+/*************************************************
+* Name:        polyeta_unpack
+*
+* Description: Unpack polynomial with coefficients in [-ETA,ETA].
+*
+* Arguments:   - poly *r: pointer to output polynomial
+*              - const uint8_t *a: byte array with bit-packed polynomial
+**************************************************/
+void polyeta_unpack(poly *r, const uint8_t *a) {
+  unsigned int i;
+  DBENCH_START();
+
+#if ETA == 2
+  uint8_t buf[16] = {0};
+
+  for(i = 0; i < N/32 - 1; ++i)
+    polyeta_unpack32(&r->coeffs[32*i], vld1q_u8(&a[12*i]));
+
+  memcpy(buf, &a[POLYETA_PACKEDBYTES - 12], 12);
+  polyeta_unpack32(&r->coeffs[N - 32], vld1q_u8(buf));
+#elif ETA == 4
+  const int8x16_t eta = vdupq_n_s8(ETA);
+  uint8x16_t b, lo, hi;
+  int8x16_t t;
+
+  for(i = 0; i < N/32; ++i) {
+    b = vld1q_u8(&a[16*i]);
+    lo = vandq_u8(b, vdupq_n_u8(0x0F));
+    hi = vshrq_n_u8(b, 4);
+    // Nibbles baixo e alto intercalados: 32 coeficientes em ordem
+    t = vsubq_s8(eta, vreinterpretq_s8_u8(vzip1q_u8(lo, hi)));
+    store_s16(&r->coeffs[32*i], vmovl_s8(vget_low_s8(t)));
+    store_s16(&r->coeffs[32*i + 8], vmovl_high_s8(t));
+    t = vsubq_s8(eta, vreinterpretq_s8_u8(vzip2q_u8(lo, hi)));
+    store_s16(&r->coeffs[32*i + 16], vmovl_s8(vget_low_s8(t)));
+    store_s16(&r->coeffs[32*i + 24], vmovl_high_s8(t));
+  }
+#endif
+
+  DBENCH_STOP(*tpack);
+}
+
+// Pares de bytes e deslocamentos dos 8 coeficientes de um grupo de 10 bytes
+static const uint8_t polyt1_unpack_idx[16] = {0, 1, 1, 2, 2, 3, 3, 4, 5, 6, 6, 7, 7, 8, 8, 9};
+static const int16_t polyt1_unpack_shift[8] = {0, -2, -4, -6, 0, -2, -4, -6};
+
+static inline uint8x16_t polyt1_pack8(int32x4_t a, int32x4_t b) {
+  uint32x4_t w;
+  uint64x2_t d;
+
+  // 10 -> 20 -> 40 bits e os dois grupos de 40 bits em 10 bytes
+  w = vreinterpretq_u32_u16(narrow_s32_u16(a, b));
+  w = vsliq_n_u32(w, vshrq_n_u32(w, 16), 10);
+  d = vreinterpretq_u64_u32(w);
+  d = vsliq_n_u64(d, vshrq_n_u64(d, 32), 20);
+  return vreinterpretq_u8_u64(join_u64(d, 40));
+}
+
+static inline void polyt1_unpack8(int32_t *r, uint8x16_t a, uint8x16_t idx, int16x8_t shift) {
+  uint16x8_t t;
+
+  t = vreinterpretq_u16_u8(vqtbl1q_u8(a, idx));
+  t = vandq_u16(vshlq_u16(t, shift), vdupq_n_u16(0x3FF));
+  vst1q_s32(&r[0], vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(t))));
+  vst1q_s32(&r[4], vreinterpretq_s32_u32(vmovl_high_u16(t)));
+}
+
+/*************************************************
+* Name:        polyt1_pack
+*
+* Description: Bit-pack polynomial t1 with coefficients fitting in 10 bits.
+*              Input coefficients are assumed to be standard representatives.
+*
+* Arguments:   - uint8_t *r: pointer to output byte array with at least
+*                            POLYT1_PACKEDBYTES bytes
+*              - const poly *a: pointer to input polynomial
+**************************************************/
+void polyt1_pack(uint8_t *r, const poly *a) {
+  unsigned int i;
+  uint8_t buf[16];
+  DBENCH_START();
+
+  for(i = 0; i < N/8 - 1; ++i)
+    vst1q_u8(&r[10*i], polyt1_pack8(vld1q_s32(&a->coeffs[8*i]), vld1q_s32(&a->coeffs[8*i + 4])));
+
+  vst1q_u8(buf, polyt1_pack8(vld1q_s32(&a->coeffs[N - 8]), vld1q_s32(&a->coeffs[N - 4])));
+  memcpy(&r[POLYT1_PACKEDBYTES - 10], buf, 10);
+
+  DBENCH_STOP(*tpack);
+}
+
+/*************************************************
+* Name:        polyt1_unpack
+*
+* Description: Unpack polynomial t1 with 10-bit coefficients.
+*              Output coefficients are standard representatives.
+*
+* Arguments:   - poly *r: pointer to output polynomial
+*              - const uint8_t *a: byte array with bit-packed polynomial
+**************************************************/
+void polyt1_unpack(poly *r, const uint8_t *a) {
+  unsigned int i;
+  uint8_t buf[16] = {0};
+  const uint8x16_t idx = vld1q_u8(polyt1_unpack_idx);
+  const int16x8_t shift = vld1q_s16(polyt1_unpack_shift);
+  DBENCH_START();
+
+  for(i = 0; i < N/8 - 1; ++i)
+    polyt1_unpack8(&r->coeffs[8*i], vld1q_u8(&a[10*i]), idx, shift);
+
+  memcpy(buf, &a[POLYT1_PACKEDBYTES - 10], 10);
+  polyt1_unpack8(&r->coeffs[N - 8], vld1q_u8(buf), idx, shift);
+
+  DBENCH_STOP(*tpack);
+}
+
+// Bytes e deslocamentos dos coeficientes 0..3 e 4..7 de um grupo de 13 bytes
+static const uint8_t polyt0_unpack_idx[2][16] = {
+  {0, 1, 2, 255, 1, 2, 3, 255, 3, 4, 5, 255, 4, 5, 6, 255},
+  {6, 7, 8, 255, 8, 9, 10, 255, 9, 10, 11, 255, 11, 12, 255, 255}
+};
+static const int32_t polyt0_unpack_shift[2][4] = {{0, -5, -2, -7}, {-4, -1, -6, -3}};
+
+static inline uint8x16_t polyt0_pack8(int32x4_t a, int32x4_t b) {
+  const int32x4_t h = vdupq_n_s32(1 << (D-1));
+  uint32x4_t w;
+  uint64x2_t d;
+
+  // 13 -> 26 -> 52 bits e os dois grupos de 52 bits em 13 bytes
+  w = vreinterpretq_u32_u16(narrow_s32_u16(vsubq_s32(h, a), vsubq_s32(h, b)));
+  w = vsliq_n_u32(w, vshrq_n_u32(w, 16), 13);
+  d = vreinterpretq_u64_u32(w);
+  d = vsliq_n_u64(d, vshrq_n_u64(d, 32), 26);
+  return vreinterpretq_u8_u64(join_u64(d, 52));
+}
+
+static inline void polyt0_unpack8(int32_t *r, uint8x16_t a) {
+  uint32x4_t t;
+  unsigned int k;
+
+  for(k = 0; k < 2; ++k) {
+    t = vreinterpretq_u32_u8(vqtbl1q_u8(a, vld1q_u8(polyt0_unpack_idx[k])));
+    t = vandq_u32(vshlq_u32(t, vld1q_s32(polyt0_unpack_shift[k])), vdupq_n_u32(0x1FFF));
+    vst1q_s32(&r[4*k], vsubq_s32(vdupq_n_s32(1 << (D-1)), vreinterpretq_s32_u32(t)));
+  }
+}
+
+/*************************************************
+* Name:        polyt0_pack
+*
+* Description: Bit-pack polynomial t0 with coefficients in ]-2^{D-1}, 2^{D-1}].
+*
+* Arguments:   - uint8_t *r: pointer to output byte array with at least
+*                            POLYT0_PACKEDBYTES bytes
+*              - const poly *a: pointer to input polynomial
+**************************************************/
+void polyt0_pack(uint8_t *r, const poly *a) {
+  unsigned int i;
+  uint8_t buf[16];
+  DBENCH_START();
+
+  for(i = 0; i < N/8 - 1; ++i)
+    vst1q_u8(&r[13*i], polyt0_pack8(vld1q_s32(&a->coeffs[8*i]), vld1q_s32(&a->coeffs[8*i + 4])));
+
+  vst1q_u8(buf, polyt0_pack8(vld1q_s32(&a->coeffs[N - 8]), vld1q_s32(&a->coeffs[N - 4])));
+  memcpy(&r[POLYT0_PACKEDBYTES - 13], buf, 13);
+
+  DBENCH_STOP(*tpack);
+}
+
+/*************************************************
+* Name:        polyt0_unpack
+*
+* Description: Unpack polynomial t0 with coefficients in ]-2^{D-1}, 2^{D-1}].
+*
+* Arguments:   - poly *r: pointer to output polynomial
+*              - const uint8_t *a: byte array with bit-packed polynomial
+**************************************************/
+void polyt0_unpack(poly *r, const uint8_t *a) {
+  unsigned int i;
+  uint8_t buf[16] = {0};
+  DBENCH_START();
+
+  for(i = 0; i < N/8 - 1; ++i)
+    polyt0_unpack8(&r->coeffs[8*i], vld1q_u8(&a[13*i]));
+
+  memcpy(buf, &a[POLYT0_PACKEDBYTES - 13], 13);
+  polyt0_unpack8(&r->coeffs[N - 8], vld1q_u8(buf));
+
+  DBENCH_STOP(*tpack);
+}
+
+// c = a + b em representante padrão, separado em c1 e c0 por power2round
+static inline void power2round4(int32x4_t *c1, int32x4_t *c0, const int32_t *a, const int32_t *b) {
+  int32x4_t c;
+
+  c = vaddq_s32(vld1q_s32(a), vld1q_s32(b));
+  c = vaddq_s32(c, vandq_s32(vshrq_n_s32(c, 31), vdupq_n_s32(Q)));
+  *c1 = vshrq_n_s32(vaddq_s32(c, vdupq_n_s32((1 << (D-1)) - 1)), D);
+  *c0 = vsubq_s32(c, vshlq_n_s32(*c1, D));
+}
+
+/*************************************************
+* Name:        poly_power2round_pack
+*
+* Description: Final step of key generation in a single pass: for
+*              c = a + b, compute the standard representative, split it
+*              with power2round and bit-pack c1 as t1 and c0 as t0.
+*              Output is identical to poly_add, poly_caddq,
+*              poly_power2round, polyt1_pack and polyt0_pack in sequence.
+*
+* Arguments:   - uint8_t *t1: pointer to output byte array with at least
+*                             POLYT1_PACKEDBYTES bytes
+*              - uint8_t *t0: pointer to output byte array with at least
+*                             POLYT0_PACKEDBYTES bytes
+*              - const poly *a: pointer to first summand (A*s1)
+*              - const poly *b: pointer to second summand (s2)
+**************************************************/
+void poly_power2round_pack(uint8_t *t1, uint8_t *t0, const poly *a, const poly *b) {
+  unsigned int i;
+  int32x4_t c1[2], c0[2];
+  uint8_t buf1[16], buf0[16];
+  DBENCH_START();
+
+  // c1 e c0 vão dos registradores direto para os bytes empacotados
+  for(i = 0; i < N/8 - 1; ++i) {
+    power2round4(&c1[0], &c0[0], &a->coeffs[8*i], &b->coeffs[8*i]);
+    power2round4(&c1[1], &c0[1], &a->coeffs[8*i + 4], &b->coeffs[8*i + 4]);
+    vst1q_u8(&t1[10*i], polyt1_pack8(c1[0], c1[1]));
+    vst1q_u8(&t0[13*i], polyt0_pack8(c0[0], c0[1]));
+  }
+
+  power2round4(&c1[0], &c0[0], &a->coeffs[N - 8], &b->coeffs[N - 8]);
+  power2round4(&c1[1], &c0[1], &a->coeffs[N - 4], &b->coeffs[N - 4]);
+  vst1q_u8(buf1, polyt1_pack8(c1[0], c1[1]));
+  vst1q_u8(buf0, polyt0_pack8(c0[0], c0[1]));
+  memcpy(&t1[POLYT1_PACKEDBYTES - 10], buf1, 10);
+  memcpy(&t0[POLYT0_PACKEDBYTES - 13], buf0, 13);
+
+  DBENCH_STOP(*tround);
+}
+
+#if GAMMA1 == (1 << 17)
+#define POLYZ_BITS 18
+// Bytes e deslocamentos dos 4 coeficientes de um grupo de 9 bytes
+static const uint8_t polyz_unpack_idx[16] = {0, 1, 2, 255, 2, 3, 4, 255, 4, 5, 6, 255, 6, 7, 8, 255};
+static const int32_t polyz_unpack_shift[4] = {0, -2, -4, -6};
+#elif GAMMA1 == (1 << 19)
+#define POLYZ_BITS 20
+// Bytes e deslocamentos dos 4 coeficientes de um grupo de 10 bytes
+static const uint8_t polyz_unpack_idx[16] = {0, 1, 2, 255, 2, 3, 4, 255, 5, 6, 7, 255, 7, 8, 9, 255};
+static const int32_t polyz_unpack_shift[4] = {0, -4, 0, -4};
+#endif
+#define POLYZ_GROUPBYTES (POLYZ_BITS/2)
+
+static inline uint8x16_t polyz_pack4(int32x4_t a) {
+  uint64x2_t x;
+
+  x = vreinterpretq_u64_s32(vsubq_s32(vdupq_n_s32(GAMMA1), a));
+  // Pares t0 | t1 << BITS em cada lane de 64 bits e os dois pares em
+  // 9 ou 10 bytes
+  x = vsliq_n_u64(x, vshrq_n_u64(x, 32), POLYZ_BITS);
+  return vreinterpretq_u8_u64(join_u64(x, 2*POLYZ_BITS));
+}
+
+static inline int32x4_t polyz_unpack4(uint8x16_t a, uint8x16_t idx, int32x4_t shift) {
+  uint32x4_t t;
+
+  // Os 3 bytes de cada coeficiente na sua lane, alinhados e mascarados
+  t = vreinterpretq_u32_u8(vqtbl1q_u8(a, idx));
+  t = vandq_u32(vshlq_u32(t, shift), vdupq_n_u32((1 << POLYZ_BITS) - 1));
+  return vsubq_s32(vdupq_n_s32(GAMMA1), vreinterpretq_s32_u32(t));
+}
+
+/*************************************************
+* Name:        polyz_pack
+*
+* Description: Bit-pack polynomial with coefficients
+*              in [-(GAMMA1 - 1), GAMMA1].
+*
+* Arguments:   - uint8_t *r: pointer to output byte array with at least
+*                            POLYZ_PACKEDBYTES bytes
+*              - const poly *a: pointer to input polynomial
+**************************************************/
+void polyz_pack(uint8_t *r, const poly *a) {
+  unsigned int i;
+  uint8_t buf[16];
+  DBENCH_START();
+
+  // Cada gravação sobrescreve o excedente da anterior
+  for(i = 0; i < N/4 - 1; ++i)
+    vst1q_u8(&r[POLYZ_GROUPBYTES*i], polyz_pack4(vld1q_s32(&a->coeffs[4*i])));
+
+  vst1q_u8(buf, polyz_pack4(vld1q_s32(&a->coeffs[N - 4])));
+  memcpy(&r[POLYZ_PACKEDBYTES - POLYZ_GROUPBYTES], buf, POLYZ_GROUPBYTES);
+
+  DBENCH_STOP(*tpack);
+}
+
+/*************************************************
+* Name:        polyz_unpack
+*
+* Description: Unpack polynomial z with coefficients
+*              in [-(GAMMA1 - 1), GAMMA1].
+*
+* Arguments:   - poly *r: pointer to output polynomial
+*              - const uint8_t *a: byte array with bit-packed polynomial
+**************************************************/
+void polyz_unpack(poly *r, const uint8_t *a) {
+  unsigned int i;
+  uint8_t buf[16] = {0};
+  const uint8x16_t idx = vld1q_u8(polyz_unpack_idx);
+  const int32x4_t shift = vld1q_s32(polyz_unpack_shift);
+  DBENCH_START();
+
+  for(i = 0; i < N/4 - 1; ++i)
+    vst1q_s32(&r->coeffs[4*i], polyz_unpack4(vld1q_u8(&a[POLYZ_GROUPBYTES*i]), idx, shift));
+
+  memcpy(buf, &a[POLYZ_PACKEDBYTES - POLYZ_GROUPBYTES], POLYZ_GROUPBYTES);
+  vst1q_s32(&r->coeffs[N - 4], polyz_unpack4(vld1q_u8(buf), idx, shift));
+
+  DBENCH_STOP(*tpack);
+}
+
+/*************************************************
+* Name:        polyw1_pack
+*
+* Description: Bit-pack polynomial w1 with coefficients in [0,15] or [0,43].
+*              Input coefficients are assumed to be standard representatives.
+*
+* Arguments:   - uint8_t *r: pointer to output byte array with at least
+*                            POLYW1_PACKEDBYTES bytes
+*              - const poly *a: pointer to input polynomial
+**************************************************/
+void polyw1_pack(uint8_t *r, const poly *a) {
+  unsigned int i;
+  DBENCH_START();
+
+#if GAMMA2 == (Q-1)/88
+  int32x4x4_t t0, t1, t2, t3;
+  uint8x16_t c0, c1, c2, c3;
+  uint8x16x3_t o;
+
+  for(i = 0; i < N/64; ++i) {
+    // vld4 separa os coeficientes 4j, 4j+1, 4j+2 e 4j+3 de 16 grupos
+    t0 = vld4q_s32(&a->coeffs[64*i]);
+    t1 = vld4q_s32(&a->coeffs[64*i + 16]);
+    t2 = vld4q_s32(&a->coeffs[64*i + 32]);
+    t3 = vld4q_s32(&a->coeffs[64*i + 48]);
+    c0 = narrow_s32_u8(t0.val[0], t1.val[0], t2.val[0], t3.val[0]);
+    c1 = narrow_s32_u8(t0.val[1], t1.val[1], t2.val[1], t3.val[1]);
+    c2 = narrow_s32_u8(t0.val[2], t1.val[2], t2.val[2], t3.val[2]);
+    c3 = narrow_s32_u8(t0.val[3], t1.val[3], t2.val[3], t3.val[3]);
+
+    // 3 bytes por grupo, intercalados por vst3
+    o.val[0] = vsliq_n_u8(c0, c1, 6);
+    o.val[1] = vsliq_n_u8(vshrq_n_u8(c1, 2), c2, 4);
+    o.val[2] = vsliq_n_u8(vshrq_n_u8(c2, 4), c3, 2);
+    vst3q_u8(&r[48*i], o);
+  }
+#elif GAMMA2 == (Q-1)/32
+  int32x4x2_t t0, t1, t2, t3;
+  uint8x16_t c0, c1;
+
+  for(i = 0; i < N/32; ++i) {
+    // vld2 separa os coeficientes pares e ímpares
+    t0 = vld2q_s32(&a->coeffs[32*i]);
+    t1 = vld2q_s32(&a->coeffs[32*i + 8]);
+    t2 = vld2q_s32(&a->coeffs[32*i + 16]);
+    t3 = vld2q_s32(&a->coeffs[32*i + 24]);
+    c0 = narrow_s32_u8(t0.val[0], t1.val[0], t2.val[0], t3.val[0]);
+    c1 = narrow_s32_u8(t0.val[1], t1.val[1], t2.val[1], t3.val[1]);
+    vst1q_u8(&r[16*i], vsliq_n_u8(c0, c1, 4));
+  }
+#endif
+
+  DBENCH_STOP(*tpack);
+}
@@ -0,0 +1,572 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <riscv_vector.h>
+#include "params.h"
+#include "poly.h"
+#include "reduce.h"
+#include "reduce_rvv.h"
+#include "symmetric.h"
+#include "fips202x4.h"
+
+/* Núcleos RVV 1.0 de poly.h, independentes de VLEN: cada laço usa o vl
+ * devolvido por vsetvl (strip-mining). A rejeição junta os candidatos
+ * aceitos com vcompress. A amostragem em lote usa o Keccak x4 de
+ * fips202x4_rvv.c com a mesma interface da versão AVX2. */
+
+#ifdef DBENCH
+#include "test/cpucycles.h"
+extern const uint64_t timing_overhead;
+extern uint64_t *tred, *tadd, *tmul, *tround, *tsample, *tpack;
+#define DBENCH_START() uint64_t time = cpucycles()
+#define DBENCH_STOP(t) t += cpucycles() - time - timing_overhead
+#else
+#define DBENCH_START()
+#define DBENCH_STOP(t)
+#endif
+
+/*************************************************
+* Name:        poly_reduce
+*
+* Description: Inplace reduction of all coefficients of polynomial to
+*              representative in [-6283008,6283008].
+*
+* Arguments:   - poly *a: pointer to input/output polynomial
+**************************************************/
+void poly_reduce(poly *a) {
+    unsigned int i;
+    size_t vl;
+    DBENCH_START();
+
+    for (i = 0; i < N; i += vl) {
+        vl = __riscv_vsetvl_e32m1(N - i);
+        __riscv_vse32_v_i32m1(&a->coeffs[i], reduce32_rvv(__riscv_vle32_v_i32m1(&a->coeffs[i], vl), vl), vl);
+    }
+    DBENCH_STOP(*tred);
+}
+
+/*************************************************
+* Name:        poly_caddq
+*
+* Description: For all coefficients of in/out polynomial add Q if
+*              coefficient is negative.
+*
+* Arguments:   - poly *a: pointer to input/output polynomial
+**************************************************/
+void poly_caddq(poly *a) {
+    unsigned int i;
+    size_t vl;
+    DBENCH_START();
+
+    for (i = 0; i < N; i += vl) {
+        vl = __riscv_vsetvl_e32m1(N - i);
+        __riscv_vse32_v_i32m1(&a->coeffs[i], caddq_rvv(__riscv_vle32_v_i32m1(&a->coeffs[i], vl), vl), vl);
+    }
+    DBENCH_STOP(*tred);
+}
+
+/*************************************************
+* Name:        poly_add
+*
+* Description: Add polynomials. No modular reduction is performed.
+*
+* Arguments:   - poly *c: pointer to output polynomial
+*              - const poly *a: pointer to first summand
+*              - const poly *b: pointer to second summand
+**************************************************/
+void poly_add(poly *c, const poly *a, const poly *b) {
+    unsigned int i;
+    size_t vl;
+    vint32m1_t va, vb;
+    DBENCH_START();
+
+    for (i = 0; i < N; i += vl) {
+        vl = __riscv_vsetvl_e32m1(N - i);
+        va = __riscv_vle32_v_i32m1(&a->coeffs[i], vl);
+        vb = __riscv_vle32_v_i32m1(&b->coeffs[i], vl);
+        __riscv_vse32_v_i32m1(&c->coeffs[i], __riscv_vadd_vv_i32m1(va, vb, vl), vl);
+    }
+    DBENCH_STOP(*tadd);
+}
+
+/*************************************************
+* Name:        poly_sub
+*
+* Description: Subtract polynomials. No modular reduction is
+*              performed.
+*
+* Arguments:   - poly *c: pointer to output polynomial
+*              - const poly *a: pointer to first input polynomial
+*              - const poly *b: pointer to second input polynomial to be
+*                               subtraced from first input polynomial
+**************************************************/
+void poly_sub(poly *c, const poly *a, const poly *b) {
+    unsigned int i;
+    size_t vl;
+    vint32m1_t va, vb;
+    DBENCH_START();
+
+    for (i = 0; i < N; i += vl) {
+        vl = __riscv_vsetvl_e32m1(N - i);
+        va = __riscv_vle32_v_i32m1(&a->coeffs[i], vl);
+        vb = __riscv_vle32_v_i32m1(&b->coeffs[i], vl);
+        __riscv_vse32_v_i32m1(&c->coeffs[i], __riscv_vsub_vv_i32m1(va, vb, vl), vl);
+    }
+    DBENCH_STOP(*tadd);
+}
+
+/*************************************************
+* Name:        poly_shiftl
+*
+* Description: Multiply polynomial by 2^D without modular reduction. Assumes
+*              input coefficients to be less than 2^{31-D} in absolute value.
+*
+* Arguments:   - poly *a: pointer to input/output polynomial
+**************************************************/
+void poly_shiftl(poly *a) {
+    unsigned int i;
+    size_t vl;
+    DBENCH_START();
+
+    for (i = 0; i < N; i += vl) {
+        vl = __riscv_vsetvl_e32m1(N - i);
+        __riscv_vse32_v_i32m1(&a->coeffs[i], __riscv_vsll_vx_i32m1(__riscv_vle32_v_i32m1(&a->coeffs[i], vl), D, vl), vl);
+    }
+    DBENCH_STOP(*tmul);
+}
+
+/*************************************************
+* Name:        poly_pointwise_montgomery
+*
+* Description: Pointwise multiplication of polynomials in NTT domain
+*              representation and multiplication of resulting polynomial
+*              by 2^{-32}.
+*
+* Arguments:   - poly *c: pointer to output polynomial
+*              - const poly *a: pointer to first input polynomial
+*              - const poly *b: pointer to second input polynomial
+**************************************************/
+void poly_pointwise_montgomery(poly *c, const poly *a, const poly *b) {
+    unsigned int i;
+    size_t vl;
+    vint32m1_t va, vb;
+    DBENCH_START();
+
+    for (i = 0; i < N; i += vl) {
+        vl = __riscv_vsetvl_e32m1(N - i);
+        va = __riscv_vle32_v_i32m1(&a->coeffs[i], vl);
+        vb = __riscv_vle32_v_i32m1(&b->coeffs[i], vl);
+        __riscv_vse32_v_i32m1(&c->coeffs[i], montgomery_mul_rvv(va, vb, vl), vl);
+    }
+    DBENCH_STOP(*tmul);
+}
+
+/*************************************************
+* Name:        poly_sparse_mul
+*
+* Description: Multiplication of a polynomial by the sparse challenge c in
+*              the normal domain, r = c*a mod (X^N + 1). Each of the TAU
+*              nonzero coefficients of c contributes a negacyclic rotation
+*              of a. No modular reduction is performed; the caller must
+*              make sure TAU*max|a| fits in int32_t.
+*
+* Arguments:   - poly *r: pointer to output polynomial
+*              - const sparse_challenge *c: pointer to sparse challenge
+*              - const poly *a: pointer to input polynomial
+**************************************************/
+void poly_sparse_mul(poly *r, const sparse_challenge *c, const poly *a) {
+    unsigned int i, k;
+    size_t vl;
+    int32_t ext[2*N];
+    const int32_t *w;
+    vint32m1_t v, acc;
+    DBENCH_START();
+
+    // ext = (-a, a): X^p * a corresponde à janela contígua ext[N-p .. 2N-p-1]
+    for (i = 0; i < N; i += vl) {
+        vl = __riscv_vsetvl_e32m1(N - i);
+        v = __riscv_vle32_v_i32m1(&a->coeffs[i], vl);
+        __riscv_vse32_v_i32m1(&ext[i], __riscv_vneg_v_i32m1(v, vl), vl);
+        __riscv_vse32_v_i32m1(&ext[N + i], v, vl);
+    }
+
+    // Primeiro termo inicializa r
+    w = &ext[N - c->pos[0]];
+    for (i = 0; i < N; i += vl) {
+        vl = __riscv_vsetvl_e32m1(N - i);
+        v = __riscv_vle32_v_i32m1(&w[i], vl);
+        if (c->signs & 1)
+            v = __riscv_vneg_v_i32m1(v, vl);
+        __riscv_vse32_v_i32m1(&r->coeffs[i], v, vl);
+    }
+
+    // Acumula os TAU-1 termos restantes, somando ou subtraindo a janela
+    for (k = 1; k < TAU; ++k) {
+        w = &ext[N - c->pos[k]];
+        for (i = 0; i < N; i += vl) {
+            vl = __riscv_vsetvl_e32m1(N - i);
+            acc = __riscv_vle32_v_i32m1(&r->coeffs[i], vl);
+            v = __riscv_vle32_v_i32m1(&w[i], vl);
+            if ((c->signs >> k) & 1)
+                acc = __riscv_vsub_vv_i32m1(acc, v, vl);
+            else
+                acc = __riscv_vadd_vv_i32m1(acc, v, vl);
+            __riscv_vse32_v_i32m1(&r->coeffs[i], acc, vl);
+        }
+    }
+    DBENCH_STOP(*tmul);
+}
+
+/*************************************************
+* Name:        poly_chknorm
+*
+* Description: Check infinity norm of polynomial against given bound.
+*              Assumes input coefficients were reduced by reduce32().
+*
+* Arguments:   - const poly *a: pointer to polynomial
+*              - int32_t B: norm bound
+*
+* Returns 0 if norm is strictly smaller than B <= (Q-1)/8 and 1 otherwise.
+**************************************************/
+int poly_chknorm(const poly *a, int32_t B) {
+    unsigned int i;
+    size_t vl;
+    vint32m1_t v, t;
+
+    if (B > (Q - 1) / 8)
+        return 1;
+
+    for (i = 0; i < N; i += vl) {
+        vl = __riscv_vsetvl_e32m1(N - i);
+        v = __riscv_vle32_v_i32m1(&a->coeffs[i], vl);
+
+        // |a| = (a ^ t) - t com t = a >> 31
+        t = __riscv_vsra_vx_i32m1(v, 31, vl);
+        v = __riscv_vsub_vv_i32m1(__riscv_vxor_vv_i32m1(v, t, vl), t, vl);
+        if (__riscv_vfirst_m_b32(__riscv_vmsge_vx_i32m1_b32(v, B, vl), vl) >= 0)
+            return 1;
+    }
+
+    return 0;
+}
+
+/*************************************************
+* Name:        rej_uniform
+*
+* Description: Sample uniformly random coefficients in [0, Q-1] by
+*              performing rejection sampling on array of random bytes.
+*
+* Arguments:   - int32_t *a: pointer to output array (allocated)
+*              - unsigned int len: number of coefficients to be sampled
+*              - const uint8_t *buf: array of random bytes
+*              - unsigned int buflen: length of array of random bytes
+*
+* Returns number of sampled coefficients. Can be smaller than len if not enough
+* random bytes were given.
+**************************************************/
+static unsigned int rej_uniform(int32_t *a, unsigned int len, const uint8_t *buf, unsigned int buflen) {
+    unsigned int ctr = 0, pos = 0, cnt;
+    size_t vl;
+    vuint32m1_t t, b;
+    vbool32_t ok;
+
+    while (ctr < len && pos + 3 <= buflen) {
+        vl = __riscv_vsetvl_e32m1((buflen - pos) / 3);
+
+        // Três cargas com passo 3: bytes 0, 1 e 2 de cada candidato
+        t = __riscv_vzext_vf4_u32m1(__riscv_vlse8_v_u8mf4(&buf[pos], 3, vl), vl);
+        b = __riscv_vzext_vf4_u32m1(__riscv_vlse8_v_u8mf4(&buf[pos + 1], 3, vl), vl);
+        t = __riscv_vor_vv_u32m1(t, __riscv_vsll_vx_u32m1(b, 8, vl), vl);
+        b = __riscv_vzext_vf4_u32m1(__riscv_vlse8_v_u8mf4(&buf[pos + 2], 3, vl), vl);
+        t = __riscv_vor_vv_u32m1(t, __riscv_vsll_vx_u32m1(b, 16, vl), vl);
+        t = __riscv_vand_vx_u32m1(t, 0x7FFFFF, vl);
+
+        // Aceitos (t < Q) juntados no início do vetor, na ordem original
+        ok = __riscv_vmsltu_vx_u32m1_b32(t, Q, vl);
+        cnt = (unsigned int)__riscv_vcpop_m_b32(ok, vl);
+        if (cnt > len - ctr)
+            cnt = len - ctr;
+        __riscv_vse32_v_u32m1((uint32_t *)&a[ctr], __riscv_vcompress_vm_u32m1(t, ok, vl), cnt);
+
+        ctr += cnt;
+        pos += 3 * (unsigned int)vl;
+    }
+
+    return ctr;
+}
+
+/*************************************************
+* Name:        poly_uniform
+*
+* Description: Sample polynomial with uniformly random coefficients
+*              in [0,Q-1] by performing rejection sampling on the
+*              output stream of SHAKE128(seed|nonce)
+*
+* Arguments:   - poly *a: pointer to output polynomial
+*              - const uint8_t seed[]: byte array with seed of length SEEDBYTES
+*              - uint16_t nonce: 2-byte nonce
+**************************************************/
+#define POLY_UNIFORM_NBLOCKS ((768 + STREAM128_BLOCKBYTES - 1)/STREAM128_BLOCKBYTES)
+#define POLY_UNIFORM_BUFLEN (POLY_UNIFORM_NBLOCKS*STREAM128_BLOCKBYTES)
+
+// Amostra um único polinômio, com estado e buffer de tamanho fixo (sem VLAs)
+static void poly_uniform_single(poly *a, const uint8_t seed[SEEDBYTES], uint16_t nonce) {
+    unsigned int i, ctr, off;
+    unsigned int buflen = POLY_UNIFORM_BUFLEN;
+    uint8_t buf[POLY_UNIFORM_BUFLEN + 2];
+    stream128_state state;
+
+    stream128_init(&state, seed, nonce);
+    stream128_squeezeblocks(buf, POLY_UNIFORM_NBLOCKS, &state);
+
+    ctr = rej_uniform(a->coeffs, N, buf, buflen);
+
+    // Se não preencheu todos os coeficientes, squeeze mais blocos
+    while (ctr < N) {
+        off = buflen % 3;
+        for (i = 0; i < off; ++i)
+            buf[i] = buf[buflen - off + i];
+
+        stream128_squeezeblocks(buf + off, 1, &state);
+        buflen = STREAM128_BLOCKBYTES + off;
+        ctr += rej_uniform(a->coeffs + ctr, N - ctr, buf, buflen);
+    }
+}
+
+// Processa o lote em grupos de quatro (Keccak x4), e o resto com as
+// variantes de três, dois ou um polinômio
+void poly_uniform(poly *a[], const uint8_t seed[SEEDBYTES], uint16_t nonce[], int batch_size) {
+    int idx = 0;
+
+    for (; idx + 4 <= batch_size; idx += 4)
+        poly_uniform_4x(a[idx], a[idx + 1], a[idx + 2], a[idx + 3], seed,
+                        nonce[idx], nonce[idx + 1], nonce[idx + 2], nonce[idx + 3]);
+
+    if (batch_size - idx == 3)
+        poly_uniform_3x(a[idx], a[idx + 1], a[idx + 2], seed, nonce[idx], nonce[idx + 1], nonce[idx + 2]);
+    else if (batch_size - idx == 2)
+        poly_uniform_2x(a[idx], a[idx + 1], seed, nonce[idx], nonce[idx + 1]);
+    else if (batch_size - idx == 1)
+        poly_uniform_single(a[idx], seed, nonce[idx]);
+}
+
+/******************************************************************************
+ * Name:        poly_uniform_4x
+ *
+ * Description: Sample four polynomials with uniformly random coefficients
+ *             in [0,Q-1] by performing rejection sampling on the
+ *            output stream of SHAKE128x4(seed|nonce0, ..., nonce3)
+ *
+ * Arguments:   - poly *a0..a3: pointers to output polynomials
+ *            - const uint8_t seed[]: byte array with seed of length SEEDBYTES
+ *           - uint16_t nonce0..nonce3: 2-byte nonces
+ * *******************************************************************************/
+void poly_uniform_4x(poly *a0, poly *a1, poly *a2, poly *a3, const uint8_t seed[SEEDBYTES],
+                     uint16_t nonce0, uint16_t nonce1, uint16_t nonce2, uint16_t nonce3) {
+    unsigned int ctr0, ctr1, ctr2, ctr3;
+    uint8_t buf[4][SEEDBYTES + 2];
+    uint8_t outbuf[4][POLY_UNIFORM_BUFLEN];
+    keccakx4_state state;
+
+    memcpy(buf[0], seed, SEEDBYTES);
+    memcpy(buf[1], seed, SEEDBYTES);
+    memcpy(buf[2], seed, SEEDBYTES);
+    memcpy(buf[3], seed, SEEDBYTES);
+
+    buf[0][SEEDBYTES + 0] = (uint8_t)(nonce0 & 0xFF);
+    buf[0][SEEDBYTES + 1] = (uint8_t)(nonce0 >> 8);
+    buf[1][SEEDBYTES + 0] = (uint8_t)(nonce1 & 0xFF);
+    buf[1][SEEDBYTES + 1] = (uint8_t)(nonce1 >> 8);
+    buf[2][SEEDBYTES + 0] = (uint8_t)(nonce2 & 0xFF);
+    buf[2][SEEDBYTES + 1] = (uint8_t)(nonce2 >> 8);
+    buf[3][SEEDBYTES + 0] = (uint8_t)(nonce3 & 0xFF);
+    buf[3][SEEDBYTES + 1] = (uint8_t)(nonce3 >> 8);
+
+    FIPS202X4_NAMESPACE(shake128x4_absorb_once)(&state, buf[0], buf[1], buf[2], buf[3], SEEDBYTES + 2);
+    FIPS202X4_NAMESPACE(shake128x4_squeezeblocks)(outbuf[0], outbuf[1], outbuf[2], outbuf[3],
+                                                  POLY_UNIFORM_NBLOCKS, &state);
+
+    ctr0 = rej_uniform(a0->coeffs, N, outbuf[0], POLY_UNIFORM_BUFLEN);
+    ctr1 = rej_uniform(a1->coeffs, N, outbuf[1], POLY_UNIFORM_BUFLEN);
+    ctr2 = rej_uniform(a2->coeffs, N, outbuf[2], POLY_UNIFORM_BUFLEN);
+    ctr3 = rej_uniform(a3->coeffs, N, outbuf[3], POLY_UNIFORM_BUFLEN);
+
+    // POLY_UNIFORM_BUFLEN é múltiplo de 3: os blocos seguintes começam em
+    // fronteira de candidato, como nas versões x2/x3
+    while (ctr0 < N || ctr1 < N || ctr2 < N || ctr3 < N) {
+        FIPS202X4_NAMESPACE(shake128x4_squeezeblocks)(outbuf[0], outbuf[1], outbuf[2], outbuf[3], 1, &state);
+
+        ctr0 += rej_uniform(a0->coeffs + ctr0, N - ctr0, outbuf[0], SHAKE128_RATE);
+        ctr1 += rej_uniform(a1->coeffs + ctr1, N - ctr1, outbuf[1], SHAKE128_RATE);
+        ctr2 += rej_uniform(a2->coeffs + ctr2, N - ctr2, outbuf[2], SHAKE128_RATE);
+        ctr3 += rej_uniform(a3->coeffs + ctr3, N - ctr3, outbuf[3], SHAKE128_RATE);
+    }
+}
+
+
+/******************************************************************************
+ * Name:        poly_uniform_2x / poly_uniform_3x
+ *
+ * Description: Same as in poly_neon.c; the unused lanes of the x4 Keccak
+ *              sample a throwaway polynomial.
+ * *******************************************************************************/
+void poly_uniform_2x(poly *a0, poly *a1, const uint8_t seed[SEEDBYTES], uint16_t nonce0, uint16_t nonce1) {
+    poly tmp0, tmp1;
+
+    poly_uniform_4x(a0, a1, &tmp0, &tmp1, seed, nonce0, nonce1, 0, 0);
+}
+
+void poly_uniform_3x(poly *a0, poly *a1, poly *a2, const uint8_t seed[SEEDBYTES],
+                     uint16_t nonce0, uint16_t nonce1, uint16_t nonce2) {
+    poly tmp;
+
+    poly_uniform_4x(a0, a1, a2, &tmp, seed, nonce0, nonce1, nonce2, 0);
+}
+
+/*************************************************
+* Name:        rej_eta
+*
+* Description: Sample uniformly random coefficients in [-ETA, ETA] by
+*              performing rejection sampling on array of random bytes.
+*              Lane i holds nibble i (low nibble of byte i/2 for even i,
+*              high nibble for odd i), so vcompress keeps the order of the
+*              scalar version.
+*
+* Arguments:   - int32_t *a: pointer to output array (allocated)
+*              - unsigned int len: number of coefficients to be sampled
+*              - const uint8_t *buf: array of random bytes
+*              - unsigned int buflen: length of array of random bytes
+*
+* Returns number of sampled coefficients. Can be smaller than len if not enough
+* random bytes were given.
+**************************************************/
+static unsigned int rej_eta(int32_t *a, unsigned int len, const uint8_t *buf, unsigned int buflen) {
+  unsigned int ctr = 0, pos = 0, cnt;
+  size_t vl;
+  vuint32m1_t idx, t;
+  vint32m1_t v;
+  vbool32_t ok;
+
+  while (ctr < len && pos < buflen) {
+    // Número par de nibbles: cada passo consome bytes inteiros
+    vl = __riscv_vsetvl_e32m1(2 * (buflen - pos)) & ~(size_t)1;
+
+    idx = __riscv_vid_v_u32m1(vl);
+    t = __riscv_vzext_vf4_u32m1(__riscv_vluxei32_v_u8mf4(&buf[pos], __riscv_vsrl_vx_u32m1(idx, 1, vl), vl), vl);
+    t = __riscv_vsrl_vv_u32m1(t, __riscv_vsll_vx_u32m1(__riscv_vand_vx_u32m1(idx, 1, vl), 2, vl), vl);
+    t = __riscv_vand_vx_u32m1(t, 0x0F, vl);
+
+#if ETA == 2
+    // t < 15; 2 - (t mod 5), com t mod 5 = t - (205*t >> 10)*5
+    ok = __riscv_vmsltu_vx_u32m1_b32(t, 15, vl);
+    t = __riscv_vnmsac_vx_u32m1(t, 5, __riscv_vsrl_vx_u32m1(__riscv_vmul_vx_u32m1(t, 205, vl), 10, vl), vl);
+    v = __riscv_vrsub_vx_i32m1(__riscv_vreinterpret_v_u32m1_i32m1(t), 2, vl);
+#elif ETA == 4
+    // t < 9; 4 - t
+    ok = __riscv_vmsltu_vx_u32m1_b32(t, 9, vl);
+    v = __riscv_vrsub_vx_i32m1(__riscv_vreinterpret_v_u32m1_i32m1(t), 4, vl);
+#endif
+
+    cnt = (unsigned int)__riscv_vcpop_m_b32(ok, vl);
+    if (cnt > len - ctr)
+      cnt = len - ctr;
+    __riscv_vse32_v_i32m1(&a[ctr], __riscv_vcompress_vm_i32m1(v, ok, vl), cnt);
+
+    ctr += cnt;
+    pos += (unsigned int)vl / 2;
+  }
+
+  return ctr;
+}
+
+/*************************************************
+* Name:        poly_uniform_eta
+*
+* Description: Sample polynomial with uniformly random coefficients
+*              in [-ETA,ETA] by performing rejection sampling on the
+*              output stream from SHAKE256(seed|nonce)
+*
+* Arguments:   - poly *a: pointer to output polynomial
+*              - const uint8_t seed[]: byte array with seed of length CRHBYTES
+*              - uint16_t nonce: 2-byte nonce
+**************************************************/
+#if ETA == 2
+#define POLY_UNIFORM_ETA_NBLOCKS ((136 + STREAM256_BLOCKBYTES - 1)/STREAM256_BLOCKBYTES)
+#elif ETA == 4
+#define POLY_UNIFORM_ETA_NBLOCKS ((227 + STREAM256_BLOCKBYTES - 1)/STREAM256_BLOCKBYTES)
+#endif
+void poly_uniform_eta(poly *a,
+                      const uint8_t seed[CRHBYTES],
+                      uint16_t nonce)
+{
+  unsigned int ctr;
+  unsigned int buflen = POLY_UNIFORM_ETA_NBLOCKS*STREAM256_BLOCKBYTES;
+  uint8_t buf[POLY_UNIFORM_ETA_NBLOCKS*STREAM256_BLOCKBYTES];
+  stream256_state state;
+
+  stream256_init(&state, seed, nonce);
+  stream256_squeezeblocks(buf, POLY_UNIFORM_ETA_NBLOCKS, &state);
+
+  ctr = rej_eta(a->coeffs, N, buf, buflen);
+
+  while(ctr < N) {
+    stream256_squeezeblocks(buf, 1, &state);
+    ctr += rej_eta(a->coeffs + ctr, N - ctr, buf, STREAM256_BLOCKBYTES);
+  }
+}
+
+/*************************************************
+* Name:        poly_uniform_gamma1_4x
+*
+* Description: Sample four polynomials with coefficients in
+*              [-(GAMMA1 - 1), GAMMA1] from SHAKE256x4(seed|nonce_i);
+*              same output as four calls to poly_uniform_gamma1.
+*
+* Arguments:   - poly *a0..a3: pointers to output polynomials
+*              - const uint8_t seed[]: byte array with seed of length CRHBYTES
+*              - uint16_t nonce0..nonce3: 16-bit nonces
+**************************************************/
+#define POLY_UNIFORM_GAMMA1_NBLOCKS ((POLYZ_PACKEDBYTES + STREAM256_BLOCKBYTES - 1)/STREAM256_BLOCKBYTES)
+
+void poly_uniform_gamma1_4x(poly *a0, poly *a1, poly *a2, poly *a3, const uint8_t seed[64],
+                            uint16_t nonce0, uint16_t nonce1, uint16_t nonce2, uint16_t nonce3) {
+  uint8_t buf[4][POLY_UNIFORM_GAMMA1_NBLOCKS * STREAM256_BLOCKBYTES + 14];
+  keccakx4_state state;
+
+  memcpy(buf[0], seed, 64);
+  memcpy(buf[1], seed, 64);
+  memcpy(buf[2], seed, 64);
+  memcpy(buf[3], seed, 64);
+
+  buf[0][64] = nonce0 & 0xFF;
+  buf[0][65] = (nonce0 >> 8) & 0xFF;
+  buf[1][64] = nonce1 & 0xFF;
+  buf[1][65] = (nonce1 >> 8) & 0xFF;
+  buf[2][64] = nonce2 & 0xFF;
+  buf[2][65] = (nonce2 >> 8) & 0xFF;
+  buf[3][64] = nonce3 & 0xFF;
+  buf[3][65] = (nonce3 >> 8) & 0xFF;
+
+  FIPS202X4_NAMESPACE(shake256x4_absorb_once)(&state, buf[0], buf[1], buf[2], buf[3], 66);
+  FIPS202X4_NAMESPACE(shake256x4_squeezeblocks)(buf[0], buf[1], buf[2], buf[3],
+                                                POLY_UNIFORM_GAMMA1_NBLOCKS, &state);
+
+  polyz_unpack(a0, buf[0]);
+  polyz_unpack(a1, buf[1]);
+  polyz_unpack(a2, buf[2]);
+  polyz_unpack(a3, buf[3]);
+}
+
+void poly_uniform_gamma1_2x(poly *a0, poly *a1, const uint8_t seed[64],
+                            uint16_t nonce0, uint16_t nonce1) {
+  poly tmp0, tmp1;
+
+  poly_uniform_gamma1_4x(a0, a1, &tmp0, &tmp1, seed, nonce0, nonce1, 0, 0);
+}
+
+void poly_uniform_gamma1_3x(poly *a0, poly *a1, poly *a2, const uint8_t seed[64],
+                            uint16_t nonce0, uint16_t nonce1, uint16_t nonce2) {
+  poly tmp;
+
+  poly_uniform_gamma1_4x(a0, a1, a2, &tmp, seed, nonce0, nonce1, nonce2, 0);
+}
@@ -0,0 +1,538 @@
+#include <stdint.h>
+#include "params.h"
+#include "poly.h"
+#include "simd.h"
+
+/* Núcleos coeficiente a coeficiente de poly.h escritos uma única vez sobre
+ * a camada vetorial de simd.h: a mesma fonte gera as versões NEON, AVX2,
+ * AVX-512 e escalar. Com SVE, a aritmética, poly_chknorm e a rejeição
+ * vêm de poly_sve.c; aqui ficam o arredondamento (decompose, power2round
+ * e dicas) e poly_sparse_mul. */
+
+#ifdef DBENCH
+#include "test/cpucycles.h"
+extern const uint64_t timing_overhead;
+extern uint64_t *tred, *tadd, *tmul, *tround, *tsample, *tpack;
+#define DBENCH_START() uint64_t time = cpucycles()
+#define DBENCH_STOP(t) t += cpucycles() - time - timing_overhead
+#else
+#define DBENCH_START()
+#define DBENCH_STOP(t)
+#endif
+
+#if !defined(__ARM_FEATURE_SVE)
+/*************************************************
+* Name:        poly_reduce
+*
+* Description: Inplace reduction of all coefficients of polynomial to
+*              representative in [-6283008,6283008].
+*
+* Arguments:   - poly *a: pointer to input/output polynomial
+**************************************************/
+void poly_reduce(poly *a) {
+  unsigned int i;
+  DBENCH_START();
+
+  for (i = 0; i < N; i += VEC32_LANES)
+    vec32_store(&a->coeffs[i], vec32_reduce32(vec32_load(&a->coeffs[i])));
+
+  DBENCH_STOP(*tred);
+}
+
+/*************************************************
+* Name:        poly_caddq
+*
+* Description: For all coefficients of in/out polynomial add Q if
+*              coefficient is negative.
+*
+* Arguments:   - poly *a: pointer to input/output polynomial
+**************************************************/
+void poly_caddq(poly *a) {
+  unsigned int i;
+  DBENCH_START();
+
+  for (i = 0; i < N; i += VEC32_LANES)
+    vec32_store(&a->coeffs[i], vec32_caddq(vec32_load(&a->coeffs[i])));
+
+  DBENCH_STOP(*tred);
+}
+
+/*************************************************
+* Name:        poly_add
+*
+* Description: Add polynomials. No modular reduction is performed.
+*
+* Arguments:   - poly *c: pointer to output polynomial
+*              - const poly *a: pointer to first summand
+*              - const poly *b: pointer to second summand
+**************************************************/
+void poly_add(poly *c, const poly *a, const poly *b) {
+  unsigned int i;
+  DBENCH_START();
+
+  for (i = 0; i < N; i += VEC32_LANES)
+    vec32_store(&c->coeffs[i], vec32_add(vec32_load(&a->coeffs[i]), vec32_load(&b->coeffs[i])));
+
+  DBENCH_STOP(*tadd);
+}
+
+/*************************************************
+* Name:        poly_sub
+*
+* Description: Subtract polynomials. No modular reduction is
+*              performed.
+*
+* Arguments:   - poly *c: pointer to output polynomial
+*              - const poly *a: pointer to first input polynomial
+*              - const poly *b: pointer to second input polynomial to be
+*                               subtraced from first input polynomial
+**************************************************/
+void poly_sub(poly *c, const poly *a, const poly *b) {
+  unsigned int i;
+  DBENCH_START();
+
+  for (i = 0; i < N; i += VEC32_LANES)
+    vec32_store(&c->coeffs[i], vec32_sub(vec32_load(&a->coeffs[i]), vec32_load(&b->coeffs[i])));
+
+  DBENCH_STOP(*tadd);
+}
+
+/*************************************************
+* Name:        poly_shiftl
+*
+* Description: Multiply polynomial by 2^D without modular reduction. Assumes
+*              input coefficients to be less than 2^{31-D} in absolute value.
+*
+* Arguments:   - poly *a: pointer to input/output polynomial
+**************************************************/
+void poly_shiftl(poly *a) {
+  unsigned int i;
+  DBENCH_START();
+
+  for (i = 0; i < N; i += VEC32_LANES)
+    vec32_store(&a->coeffs[i], vec32_slli(vec32_load(&a->coeffs[i]), D));
+
+  DBENCH_STOP(*tmul);
+}
+
+/*************************************************
+* Name:        poly_pointwise_montgomery
+*
+* Description: Pointwise multiplication of polynomials in NTT domain
+*              representation and multiplication of resulting polynomial
+*              by 2^{-32}.
+*
+* Arguments:   - poly *c: pointer to output polynomial
+*              - const poly *a: pointer to first input polynomial
+*              - const poly *b: pointer to second input polynomial
+**************************************************/
+void poly_pointwise_montgomery(poly *c, const poly *a, const poly *b) {
+  unsigned int i;
+  DBENCH_START();
+
+  for (i = 0; i < N; i += VEC32_LANES)
+    vec32_store(&c->coeffs[i], vec32_montmul(vec32_load(&a->coeffs[i]), vec32_load(&b->coeffs[i])));
+
+  DBENCH_STOP(*tmul);
+}
+
+/*************************************************
+* Name:        poly_chknorm
+*
+* Description: Check infinity norm of polynomial against given bound.
+*              Assumes input coefficients were reduced by reduce32().
+*
+* Arguments:   - const poly *a: pointer to polynomial
+*              - int32_t B: norm bound
+*
+* Returns 0 if norm is strictly smaller than B <= (Q-1)/8 and 1 otherwise.
+**************************************************/
+int poly_chknorm(const poly *a, int32_t B) {
+  unsigned int i;
+  const vec32 bound = vec32_set1(B - 1);
+  vec32_mask acc;
+
+  if (B > (Q - 1) / 8)
+    return 1;
+
+  // Acumula |a| > B-1 sobre o polinômio inteiro, sem desvio por bloco
+  acc = vec32_cmpgt(vec32_abs(vec32_load(&a->coeffs[0])), bound);
+  for (i = VEC32_LANES; i < N; i += VEC32_LANES)
+    acc = vec32_mask_or(acc, vec32_cmpgt(vec32_abs(vec32_load(&a->coeffs[i])), bound));
+
+  return vec32_mask_any(acc);
+}
+
+/*************************************************
+* Name:        rej_uniform_simd
+*
+* Description: Sample uniformly random coefficients in [0, Q-1] by
+*              performing rejection sampling on array of random bytes.
+*
+* Arguments:   - int32_t *a: pointer to output array (allocated)
+*              - unsigned int len: number of coefficients to be sampled
+*              - const uint8_t *buf: array of random bytes
+*              - unsigned int buflen: length of array of random bytes
+*
+* Returns number of sampled coefficients. Can be smaller than len if not enough
+* random bytes were given.
+**************************************************/
+unsigned int rej_uniform_simd(int32_t *a, unsigned int len, const uint8_t *buf, unsigned int buflen) {
+  unsigned int ctr = 0, pos = 0;
+  const uint32_t mask = 0x7FFFFF; // Máscara para 23 bits
+  const vec32 bound = vec32_set1(Q);
+  const vec32 mask_vec = vec32_set1(mask);
+  vec32 t;
+
+  // Consome 3*VEC32_LANES bytes por iteração; a compactação pode gravar
+  // um vetor inteiro, por isso o laço exige VEC32_LANES posições livres
+  while (ctr + VEC32_LANES <= len && pos + VEC32_U24_LOADBYTES <= buflen) {
+    t = vec32_and(vec32_load_u24(&buf[pos]), mask_vec);
+    pos += 3*VEC32_LANES;
+    ctr += vec32_compress_store(&a[ctr], t, vec32_cmpgt(bound, t));
+  }
+
+  // Processamento escalar dos bytes restantes
+  uint32_t v;
+  while (ctr < len && pos + 3 <= buflen) {
+    v  = buf[pos++];
+    v |= (uint32_t)buf[pos++] << 8;
+    v |= (uint32_t)buf[pos++] << 16;
+    v &= mask;
+
+    if (v < Q)
+      a[ctr++] = v;
+  }
+
+  return ctr;
+}
+#endif
+
+/*************************************************
+* Name:        poly_power2round_n
+*
+* Description: poly_power2round for len consecutive polynomials, e.g. the
+*              K polynomials of a polyveck, in a single call.
+*
+* Arguments:   - poly *a1: pointer to output polynomials with coefficients c1
+*              - poly *a0: pointer to output polynomials with coefficients c0
+*              - const poly *a: pointer to input polynomials
+*              - unsigned int len: number of polynomials
+**************************************************/
+void poly_power2round_n(poly *a1, poly *a0, const poly *a, unsigned int len) {
+  unsigned int i, j;
+  const vec32 r = vec32_set1((1 << (D-1)) - 1);
+  vec32 f, f1;
+  DBENCH_START();
+
+  for (j = 0; j < len; ++j) {
+    for (i = 0; i < N; i += VEC32_LANES) {
+      f = vec32_load(&a[j].coeffs[i]);
+      f1 = vec32_srai(vec32_add(f, r), D);
+      vec32_store(&a1[j].coeffs[i], f1);
+      vec32_store(&a0[j].coeffs[i], vec32_sub(f, vec32_slli(f1, D)));
+    }
+  }
+
+  DBENCH_STOP(*tround);
+}
+
+void poly_power2round(poly *a1, poly *a0, const poly *a) {
+  poly_power2round_n(a1, a0, a, 1);
+}
+
+// decompose sem desvios; a0 é devolvido em *f0
+static inline vec32 decompose_vec(vec32 *f0, vec32 f) {
+  vec32 f1, t;
+
+  f1 = vec32_srai(vec32_add(f, vec32_set1(127)), 7);
+#if GAMMA2 == (Q-1)/32
+  // (f1*1025 + 2^21) >> 22 = (2*f1*(1025*2^9) + 2^31) >> 32
+  f1 = vec32_mulhrs(f1, vec32_set1(1025 << 9));
+  f1 = vec32_and(f1, vec32_set1(15));
+#elif GAMMA2 == (Q-1)/88
+  // (f1*11275 + 2^23) >> 24 = (2*f1*(11275*2^7) + 2^31) >> 32
+  f1 = vec32_mulhrs(f1, vec32_set1(11275 << 7));
+  f1 = vec32_xor(f1, vec32_and(vec32_srai(vec32_sub(vec32_set1(43), f1), 31), f1));
+#endif
+
+  t = vec32_sub(f, vec32_mullo(f1, vec32_set1(2*GAMMA2)));
+  t = vec32_sub(t, vec32_and(vec32_srai(vec32_sub(vec32_set1((Q-1)/2), t), 31), vec32_set1(Q)));
+  *f0 = t;
+  return f1;
+}
+
+/*************************************************
+* Name:        poly_decompose_n
+*
+* Description: poly_decompose for len consecutive polynomials.
+*
+* Arguments:   - poly *a1: pointer to output polynomials with coefficients c1
+*              - poly *a0: pointer to output polynomials with coefficients c0
+*              - const poly *a: pointer to input polynomials
+*              - unsigned int len: number of polynomials
+**************************************************/
+void poly_decompose_n(poly *a1, poly *a0, const poly *a, unsigned int len) {
+  unsigned int i, j;
+  vec32 f0, f1;
+  DBENCH_START();
+
+  for (j = 0; j < len; ++j) {
+    for (i = 0; i < N; i += VEC32_LANES) {
+      f1 = decompose_vec(&f0, vec32_load(&a[j].coeffs[i]));
+      vec32_store(&a1[j].coeffs[i], f1);
+      vec32_store(&a0[j].coeffs[i], f0);
+    }
+  }
+
+  DBENCH_STOP(*tround);
+}
+
+void poly_decompose(poly *a1, poly *a0, const poly *a) {
+  poly_decompose_n(a1, a0, a, 1);
+}
+
+// Representante padrão de f em ]-Q, Q[
+static inline vec32 caddq_vec(vec32 f) {
+  return vec32_add(f, vec32_and(vec32_srai(f, 31), vec32_set1(Q)));
+}
+
+/*************************************************
+* Name:        poly_decompose_w1
+*
+* Description: poly_caddq, poly_decompose and polyw1_pack in one call:
+*              the standard representative is taken in the same vector
+*              pass as the decomposition and c1 is packed while still in
+*              cache.
+*
+* Arguments:   - uint8_t *r: pointer to output byte array with at least
+*                            POLYW1_PACKEDBYTES bytes
+*              - poly *a1: pointer to output polynomial with coefficients c1
+*              - poly *a0: pointer to output polynomial with coefficients c0
+*              - const poly *a: pointer to input polynomial with
+*                               coefficients in ]-Q, Q[
+**************************************************/
+void poly_decompose_w1(uint8_t *r, poly *a1, poly *a0, const poly *a) {
+  unsigned int i;
+  vec32 f0, f1;
+  DBENCH_START();
+
+  for (i = 0; i < N; i += VEC32_LANES) {
+    f1 = decompose_vec(&f0, caddq_vec(vec32_load(&a->coeffs[i])));
+    vec32_store(&a1->coeffs[i], f1);
+    vec32_store(&a0->coeffs[i], f0);
+  }
+
+  DBENCH_STOP(*tround);
+
+  polyw1_pack(r, a1);
+}
+
+/*************************************************
+* Name:        poly_highbits_n
+*
+* Description: High bits c1 of poly_decompose for len consecutive
+*              polynomials, without storing the low bits. The standard
+*              representative is taken in the same pass, so input
+*              coefficients may be in ]-Q, Q[.
+*
+* Arguments:   - poly *a1: pointer to output polynomials with coefficients c1
+*              - const poly *a: pointer to input polynomials
+*              - unsigned int len: number of polynomials
+**************************************************/
+void poly_highbits_n(poly *a1, const poly *a, unsigned int len) {
+  unsigned int i, j;
+  vec32 f0;
+  DBENCH_START();
+
+  for (j = 0; j < len; ++j)
+    for (i = 0; i < N; i += VEC32_LANES)
+      vec32_store(&a1[j].coeffs[i], decompose_vec(&f0, caddq_vec(vec32_load(&a[j].coeffs[i]))));
+
+  DBENCH_STOP(*tround);
+}
+
+/*************************************************
+* Name:        poly_make_hint_n
+*
+* Description: poly_make_hint for len consecutive polynomials.
+*
+* Arguments:   - poly *h: pointer to output hint polynomials
+*              - const poly *a0: pointer to low parts of input polynomials
+*              - const poly *a1: pointer to high parts of input polynomials
+*              - unsigned int len: number of polynomials
+*
+* Returns number of 1 bits.
+**************************************************/
+unsigned int poly_make_hint_n(poly *h, const poly *a0, const poly *a1, unsigned int len) {
+  unsigned int i, j, s = 0;
+  int32_t lanes[VEC32_LANES];
+  const vec32 zero = vec32_set1(0);
+  const vec32 g = vec32_set1(GAMMA2);
+  vec32 f0, f1, t, u, acc = zero;
+  DBENCH_START();
+
+  for (j = 0; j < len; ++j) {
+    for (i = 0; i < N; i += VEC32_LANES) {
+      f0 = vec32_load(&a0[j].coeffs[i]);
+      f1 = vec32_load(&a1[j].coeffs[i]);
+      // -1 se a0 > GAMMA2
+      t = vec32_srai(vec32_sub(g, f0), 31);
+      // -1 se a0 - (a1 != 0) < -GAMMA2, isto é, a0 < -GAMMA2 ou
+      // a0 == -GAMMA2 com a1 != 0 (a1 nunca é negativo)
+      u = vec32_add(f0, vec32_srai(vec32_sub(zero, f1), 31));
+      u = vec32_srai(vec32_add(u, g), 31);
+      // As duas condições são exclusivas: a dica é -(t + u)
+      t = vec32_sub(zero, vec32_add(t, u));
+      vec32_store(&h[j].coeffs[i], t);
+      acc = vec32_add(acc, t);
+    }
+  }
+
+  vec32_store(lanes, acc);
+  for (i = 0; i < VEC32_LANES; ++i)
+    s += lanes[i];
+
+  DBENCH_STOP(*tround);
+  return s;
+}
+
+unsigned int poly_make_hint(poly *h, const poly *a0, const poly *a1) {
+  return poly_make_hint_n(h, a0, a1, 1);
+}
+
+/*************************************************
+* Name:        poly_make_hint_bits
+*
+* Description: poly_make_hint with the hint written as a bitset: bit j
+*              of h[w] is the hint of coefficient 64*w + j.
+*
+* Arguments:   - uint64_t h[]: output bitset of N bits
+*              - const poly *a0: pointer to low part of input polynomial
+*              - const poly *a1: pointer to high part of input polynomial
+*
+* Returns number of 1 bits.
+**************************************************/
+unsigned int poly_make_hint_bits(uint64_t h[N/64], const poly *a0, const poly *a1) {
+  unsigned int i, j, s;
+  uint64_t x;
+  const vec32 zero = vec32_set1(0);
+  const vec32 g = vec32_set1(GAMMA2);
+  vec32 f0, f1, t, u;
+  DBENCH_START();
+
+  for (j = 0; j < N/64; ++j) {
+    x = 0;
+    for (i = 0; i < 64; i += VEC32_LANES) {
+      f0 = vec32_load(&a0->coeffs[64*j + i]);
+      f1 = vec32_load(&a1->coeffs[64*j + i]);
+      // Mesmas condições de poly_make_hint_n: t + u é -1 onde há dica
+      t = vec32_srai(vec32_sub(g, f0), 31);
+      u = vec32_add(f0, vec32_srai(vec32_sub(zero, f1), 31));
+      u = vec32_srai(vec32_add(u, g), 31);
+      x |= (uint64_t)vec32_mask_bits(vec32_cmpgt(zero, vec32_add(t, u))) << i;
+    }
+    h[j] = x;
+  }
+
+#if defined(__ARM_NEON)
+  // vcnt conta os bits de cada byte; a soma longa cabe em 16 bits
+  s = vaddlvq_u8(vaddq_u8(vcntq_u8(vld1q_u8((const uint8_t *)&h[0])),
+                          vcntq_u8(vld1q_u8((const uint8_t *)&h[2]))));
+#else
+  s = 0;
+  for (j = 0; j < N/64; ++j)
+    s += (unsigned int)__builtin_popcountll(h[j]);
+#endif
+
+  DBENCH_STOP(*tround);
+  return s;
+}
+
+/*************************************************
+* Name:        poly_use_hint_n
+*
+* Description: poly_use_hint for len consecutive polynomials. The hint
+*              coefficients must be 0 or 1.
+*
+* Arguments:   - poly *b: pointer to output polynomials with corrected high bits
+*              - const poly *a: pointer to input polynomials
+*              - const poly *h: pointer to input hint polynomials
+*              - unsigned int len: number of polynomials
+**************************************************/
+void poly_use_hint_n(poly *b, const poly *a, const poly *h, unsigned int len) {
+  unsigned int i, j;
+  const vec32 zero = vec32_set1(0);
+  vec32 f0, f1, d;
+  DBENCH_START();
+
+  for (j = 0; j < len; ++j) {
+    for (i = 0; i < N; i += VEC32_LANES) {
+      f1 = decompose_vec(&f0, vec32_load(&a[j].coeffs[i]));
+      // d = +1 se a0 > 0 e -1 caso contrário, zerado onde a dica é 0
+      d = vec32_srai(vec32_sub(zero, f0), 31);
+      d = vec32_sub(vec32_set1(-1), vec32_slli(d, 1));
+      d = vec32_and(d, vec32_sub(zero, vec32_load(&h[j].coeffs[i])));
+      f1 = vec32_add(f1, d);
+#if GAMMA2 == (Q-1)/32
+      f1 = vec32_and(f1, vec32_set1(15));
+#elif GAMMA2 == (Q-1)/88
+      // -1 vira 43 e 44 vira 0
+      f1 = vec32_add(f1, vec32_and(vec32_srai(f1, 31), vec32_set1(44)));
+      f1 = vec32_sub(f1, vec32_and(vec32_srai(vec32_sub(vec32_set1(43), f1), 31), vec32_set1(44)));
+#endif
+      vec32_store(&b[j].coeffs[i], f1);
+    }
+  }
+
+  DBENCH_STOP(*tround);
+}
+
+void poly_use_hint(poly *b, const poly *a, const poly *h) {
+  poly_use_hint_n(b, a, h, 1);
+}
+
+/*************************************************
+* Name:        poly_sparse_mul
+*
+* Description: Multiplication of a polynomial by the sparse challenge c in
+*              the normal domain, r = c*a mod (X^N + 1). Each of the TAU
+*              nonzero coefficients of c contributes a negacyclic rotation
+*              of a. No modular reduction is performed; the caller must
+*              make sure TAU*max|a| fits in int32_t.
+*
+* Arguments:   - poly *r: pointer to output polynomial
+*              - const sparse_challenge *c: pointer to sparse challenge
+*              - const poly *a: pointer to input polynomial
+**************************************************/
+void poly_sparse_mul(poly *r, const sparse_challenge *c, const poly *a) {
+  unsigned int i, k;
+  int32_t ext[2*N];
+  const int32_t *w;
+  vec32 s, v;
+  DBENCH_START();
+
+  // ext = (-a, a): X^p * a corresponde à janela contígua ext[N-p .. 2N-p-1]
+  for (i = 0; i < N; i += VEC32_LANES) {
+    v = vec32_load(&a->coeffs[i]);
+    vec32_store(&ext[i], vec32_sub(vec32_set1(0), v));
+    vec32_store(&ext[N + i], v);
+  }
+
+  // Primeiro termo inicializa r; (w ^ s) - s nega onde s = -1
+  w = &ext[N - c->pos[0]];
+  s = vec32_set1(-(int32_t)(c->signs & 1));
+  for (i = 0; i < N; i += VEC32_LANES)
+    vec32_store(&r->coeffs[i], vec32_sub(vec32_xor(vec32_load(&w[i]), s), s));
+
+  // Acumula os TAU-1 termos restantes
+  for (k = 1; k < TAU; ++k) {
+    w = &ext[N - c->pos[k]];
+    s = vec32_set1(-(int32_t)((c->signs >> k) & 1));
+    for (i = 0; i < N; i += VEC32_LANES) {
+      v = vec32_sub(vec32_xor(vec32_load(&w[i]), s), s);
+      vec32_store(&r->coeffs[i], vec32_add(vec32_load(&r->coeffs[i]), v));
+    }
+  }
+  DBENCH_STOP(*tmul);
+}
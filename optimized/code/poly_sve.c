@@ -0,0 +1,309 @@
+#include "cpu.h"
+
+#if defined(POLY_SVE_STATIC) || defined(POLY_SVE_DISPATCH)
+
+#if !defined(POLY_SVE_STATIC)
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sve"))), apply_to = function)
+#else
+#pragma GCC target ("arch=armv8.2-a+sve")
+#endif
+#endif
+
+#include <stdint.h>
+#include <arm_sve.h>
+#include "params.h"
+#include "poly.h"
+#include "reduce.h"
+#include "reduce_sve.h"
+
+/* Núcleos SVE de poly.h, independentes do tamanho do vetor: cada laço
+ * avança svcntw() coeficientes e o último passo é predicado. O ARCH=sve
+ * compila poly_neon.c para a amostragem em lote (Keccak x2/x3) e usa
+ * daqui a aritmética e a rejeição com svcompact. Num binário NEON com
+ * DILITHIUM_RUNTIME_DISPATCH só rej_uniform_sve e rej_eta_sve são
+ * compiladas (para o alvo SVE), e poly_neon.c as escolhe em tempo de carga
+ * se o HWCAP indicar suporte. */
+
+#ifdef DBENCH
+#include "test/cpucycles.h"
+extern const uint64_t timing_overhead;
+extern uint64_t *tred, *tadd, *tmul, *tround, *tsample, *tpack;
+#define DBENCH_START() uint64_t time = cpucycles()
+#define DBENCH_STOP(t) t += cpucycles() - time - timing_overhead
+#else
+#define DBENCH_START()
+#define DBENCH_STOP(t)
+#endif
+
+#if defined(POLY_SVE_STATIC)
+/*************************************************
+* Name:        poly_reduce
+*
+* Description: Inplace reduction of all coefficients of polynomial to
+*              representative in [-6283008,6283008].
+*
+* Arguments:   - poly *a: pointer to input/output polynomial
+**************************************************/
+void poly_reduce(poly *a) {
+    unsigned int i;
+    svbool_t pg;
+    DBENCH_START();
+
+    for (i = 0; i < N; i += svcntw()) {
+        pg = svwhilelt_b32_u32(i, N);
+        svst1_s32(pg, &a->coeffs[i], reduce32_sve(pg, svld1_s32(pg, &a->coeffs[i])));
+    }
+    DBENCH_STOP(*tred);
+}
+
+/*************************************************
+* Name:        poly_caddq
+*
+* Description: For all coefficients of in/out polynomial add Q if
+*              coefficient is negative.
+*
+* Arguments:   - poly *a: pointer to input/output polynomial
+**************************************************/
+void poly_caddq(poly *a) {
+    unsigned int i;
+    svbool_t pg;
+    DBENCH_START();
+
+    for (i = 0; i < N; i += svcntw()) {
+        pg = svwhilelt_b32_u32(i, N);
+        svst1_s32(pg, &a->coeffs[i], caddq_sve(pg, svld1_s32(pg, &a->coeffs[i])));
+    }
+    DBENCH_STOP(*tred);
+}
+
+/*************************************************
+* Name:        poly_add
+*
+* Description: Add polynomials. No modular reduction is performed.
+*
+* Arguments:   - poly *c: pointer to output polynomial
+*              - const poly *a: pointer to first summand
+*              - const poly *b: pointer to second summand
+**************************************************/
+void poly_add(poly *c, const poly *a, const poly *b) {
+    unsigned int i;
+    svbool_t pg;
+    DBENCH_START();
+
+    for (i = 0; i < N; i += svcntw()) {
+        pg = svwhilelt_b32_u32(i, N);
+        svst1_s32(pg, &c->coeffs[i], svadd_s32_x(pg, svld1_s32(pg, &a->coeffs[i]), svld1_s32(pg, &b->coeffs[i])));
+    }
+    DBENCH_STOP(*tadd);
+}
+
+/*************************************************
+* Name:        poly_sub
+*
+* Description: Subtract polynomials. No modular reduction is
+*              performed.
+*
+* Arguments:   - poly *c: pointer to output polynomial
+*              - const poly *a: pointer to first input polynomial
+*              - const poly *b: pointer to second input polynomial to be
+*                               subtraced from first input polynomial
+**************************************************/
+void poly_sub(poly *c, const poly *a, const poly *b) {
+    unsigned int i;
+    svbool_t pg;
+    DBENCH_START();
+
+    for (i = 0; i < N; i += svcntw()) {
+        pg = svwhilelt_b32_u32(i, N);
+        svst1_s32(pg, &c->coeffs[i], svsub_s32_x(pg, svld1_s32(pg, &a->coeffs[i]), svld1_s32(pg, &b->coeffs[i])));
+    }
+    DBENCH_STOP(*tadd);
+}
+
+/*************************************************
+* Name:        poly_shiftl
+*
+* Description: Multiply polynomial by 2^D without modular reduction. Assumes
+*              input coefficients to be less than 2^{31-D} in absolute value.
+*
+* Arguments:   - poly *a: pointer to input/output polynomial
+**************************************************/
+void poly_shiftl(poly *a) {
+    unsigned int i;
+    svbool_t pg;
+    DBENCH_START();
+
+    for (i = 0; i < N; i += svcntw()) {
+        pg = svwhilelt_b32_u32(i, N);
+        svst1_s32(pg, &a->coeffs[i], svlsl_n_s32_x(pg, svld1_s32(pg, &a->coeffs[i]), D));
+    }
+    DBENCH_STOP(*tmul);
+}
+
+/*************************************************
+* Name:        poly_pointwise_montgomery
+*
+* Description: Pointwise multiplication of polynomials in NTT domain
+*              representation and multiplication of resulting polynomial
+*              by 2^{-32}.
+*
+* Arguments:   - poly *c: pointer to output polynomial
+*              - const poly *a: pointer to first input polynomial
+*              - const poly *b: pointer to second input polynomial
+**************************************************/
+void poly_pointwise_montgomery(poly *c, const poly *a, const poly *b) {
+    unsigned int i;
+    svbool_t pg;
+    DBENCH_START();
+
+    for (i = 0; i < N; i += svcntw()) {
+        pg = svwhilelt_b32_u32(i, N);
+        svst1_s32(pg, &c->coeffs[i],
+                  montgomery_mul_sve(pg, svld1_s32(pg, &a->coeffs[i]), svld1_s32(pg, &b->coeffs[i])));
+    }
+    DBENCH_STOP(*tmul);
+}
+
+/*************************************************
+* Name:        poly_chknorm
+*
+* Description: Check infinity norm of polynomial against given bound.
+*              Assumes input coefficients were reduced by reduce32().
+*
+* Arguments:   - const poly *a: pointer to polynomial
+*              - int32_t B: norm bound
+*
+* Returns 0 if norm is strictly smaller than B <= (Q-1)/8 and 1 otherwise.
+**************************************************/
+int poly_chknorm(const poly *a, int32_t B) {
+    unsigned int i;
+    svbool_t pg;
+    svint32_t v;
+
+    if (B > (Q - 1) / 8)
+        return 1;
+
+    for (i = 0; i < N; i += svcntw()) {
+        pg = svwhilelt_b32_u32(i, N);
+        v = svabs_s32_x(pg, svld1_s32(pg, &a->coeffs[i]));
+        if (svptest_any(pg, svcmpge_n_s32(pg, v, B)))
+            return 1;
+    }
+
+    return 0;
+}
+
+#endif
+
+/*************************************************
+* Name:        rej_uniform_sve
+*
+* Description: Sample uniformly random coefficients in [0, Q-1] by
+*              performing rejection sampling on array of random bytes.
+*              Each step reads svcntw() 3-byte candidates with byte
+*              gathers and packs the accepted ones, in order, with
+*              svcompact. Used by the samplers of poly_neon.c.
+*
+* Arguments:   - int32_t *a: pointer to output array (allocated)
+*              - unsigned int len: number of coefficients to be sampled
+*              - const uint8_t *buf: array of random bytes
+*              - unsigned int buflen: length of array of random bytes
+*
+* Returns number of sampled coefficients. Can be smaller than len if not enough
+* random bytes were given.
+**************************************************/
+unsigned int rej_uniform_sve(int32_t *a, unsigned int len, const uint8_t *buf, unsigned int buflen) {
+    unsigned int ctr = 0, pos = 0, ncand, cnt;
+    const unsigned int vl = (unsigned int)svcntw();
+    const svuint32_t off = svindex_u32(0, 3); // Deslocamento de cada candidato
+    svbool_t pg, ok;
+    svuint32_t t;
+
+    while (ctr < len && pos + 3 <= buflen) {
+        ncand = (buflen - pos) / 3;
+        pg = svwhilelt_b32_u32(0, ncand);
+
+        // Três bytes little-endian por candidato, 23 bits
+        t = svld1ub_gather_u32offset_u32(pg, &buf[pos], off);
+        t = svorr_u32_x(pg, t, svlsl_n_u32_x(pg, svld1ub_gather_u32offset_u32(pg, &buf[pos + 1], off), 8));
+        t = svorr_u32_x(pg, t, svlsl_n_u32_x(pg, svld1ub_gather_u32offset_u32(pg, &buf[pos + 2], off), 16));
+        t = svand_n_u32_x(pg, t, 0x7FFFFF);
+
+        // Aceitos (t < Q) juntados no início do vetor, na ordem original
+        ok = svcmplt_n_u32(pg, t, Q);
+        cnt = (unsigned int)svcntp_b32(pg, ok);
+        if (cnt > len - ctr)
+            cnt = len - ctr;
+        svst1_s32(svwhilelt_b32_u32(0, cnt), &a[ctr], svreinterpret_s32_u32(svcompact_u32(ok, t)));
+
+        ctr += cnt;
+        pos += 3 * (ncand < vl ? ncand : vl);
+    }
+
+    return ctr;
+}
+
+/*************************************************
+* Name:        rej_eta_sve
+*
+* Description: Sample uniformly random coefficients in [-ETA, ETA] by
+*              performing rejection sampling on array of random bytes.
+*              Lane i holds nibble i (low nibble of byte i/2 for even i,
+*              high nibble for odd i), so the accepted values keep the
+*              order of the scalar version after svcompact.
+*
+* Arguments:   - int32_t *a: pointer to output array (allocated)
+*              - unsigned int len: number of coefficients to be sampled
+*              - const uint8_t *buf: array of random bytes
+*              - unsigned int buflen: length of array of random bytes
+*
+* Returns number of sampled coefficients. Can be smaller than len if not enough
+* random bytes were given.
+**************************************************/
+unsigned int rej_eta_sve(int32_t *a, unsigned int len, const uint8_t *buf, unsigned int buflen) {
+    unsigned int ctr = 0, pos = 0, nnib, cnt;
+    const unsigned int vl = (unsigned int)svcntw();
+    const svbool_t all = svptrue_b32();
+    const svuint32_t idx = svindex_u32(0, 1);
+    const svuint32_t off = svlsr_n_u32_x(all, idx, 1);                      // byte i/2
+    const svuint32_t sh = svlsl_n_u32_x(all, svand_n_u32_x(all, idx, 1), 2); // 0 ou 4
+    svbool_t pg, ok;
+    svuint32_t t;
+    svint32_t v;
+
+    while (ctr < len && pos < buflen) {
+        nnib = 2 * (buflen - pos);
+        pg = svwhilelt_b32_u32(0, nnib);
+
+        t = svld1ub_gather_u32offset_u32(pg, &buf[pos], off);
+        t = svand_n_u32_x(pg, svlsr_u32_x(pg, t, sh), 0x0F);
+
+#if ETA == 2
+        // t < 15; 2 - (t mod 5), com t mod 5 = t - (205*t >> 10)*5
+        ok = svcmplt_n_u32(pg, t, 15);
+        t = svmls_n_u32_x(pg, t, svlsr_n_u32_x(pg, svmul_n_u32_x(pg, t, 205), 10), 5);
+        v = svsubr_n_s32_x(pg, svreinterpret_s32_u32(t), 2);
+#elif ETA == 4
+        // t < 9; 4 - t
+        ok = svcmplt_n_u32(pg, t, 9);
+        v = svsubr_n_s32_x(pg, svreinterpret_s32_u32(t), 4);
+#endif
+
+        cnt = (unsigned int)svcntp_b32(pg, ok);
+        if (cnt > len - ctr)
+            cnt = len - ctr;
+        svst1_s32(svwhilelt_b32_u32(0, cnt), &a[ctr], svcompact_s32(ok, v));
+
+        ctr += cnt;
+        pos += (nnib < vl ? nnib : vl) / 2;
+    }
+
+    return ctr;
+}
+
+#if !defined(POLY_SVE_STATIC) && defined(__clang__)
+#pragma clang attribute pop
+#endif
+
+#endif
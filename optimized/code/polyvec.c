@@ -2,44 +2,36 @@
 #include "params.h"
 #include "polyvec.h"
 #include "poly.h"
+#include "rounding.h"
+#include "fips202.h"
 #include <stddef.h>
-#include <arm_neon.h>
 
 
 /********************************************************************************
- * Name:        polyvec_matrix_expand UTILIZANDO POLY_UNIFORM_2X
+ * Name:        polyvec_matrix_expand
  * Description: Implementation of ExpandA. Generates matrix A with uniformly
  *             random coefficients a_{i,j} by performing rejection
- *            sampling on the output stream of SHAKE128x2(rho|j|i)
+ *            sampling on the output stream of SHAKE128(rho|j|i). All K*L
+ *            polynomials are handed to poly_uniform as one batch, which
+ *            samples them with the widest Keccak of the backend (x3 on
+ *            NEON, x4 on AVX2 and RVV, x8 on AVX-512).
  * Arguments:   - polyvecl mat[K]: output matrix
  *            - const uint8_t rho[]: byte array containing seed rho
- *           - int batch_size: number of polynomials to generate
  * Returns:     - void
  * *****************************************************************************/
-
-// UTILIZANDO POLY_UNIFORM_2X
 void polyvec_matrix_expand(polyvecl mat[K], const uint8_t rho[SEEDBYTES]) {
     unsigned int i, j;
+    poly *a_batch[K * L];
+    uint16_t nonce_batch[K * L];
 
     for (i = 0; i < K; ++i) {
-        for (j = 0; j < L;) {
-            int batch_size = L - j;
-            if (batch_size >= 2) {
-                // Use poly_uniform_2x quando possível
-                uint16_t nonce0 = (i << 8) + j;
-                uint16_t nonce1 = (i << 8) + (j + 1);
-                poly_uniform_2x(&mat[i].vec[j], &mat[i].vec[j + 1], rho, nonce0, nonce1);
-                j += 2;
-            } else {
-                // Se restar apenas 1 polinômio, use poly_uniform
-                //uint16_t nonce_batch[1] = {(i << 8) + j};
-                uint16_t nonce_batch[1] = {static_cast<uint16_t>((i << 8) + j)};
-                poly *a_batch[1] = {&mat[i].vec[j]};
-                poly_uniform(a_batch, rho, nonce_batch, 1);
-                j += 1;
-            }
+        for (j = 0; j < L; ++j) {
+            a_batch[i * L + j] = &mat[i].vec[j];
+            nonce_batch[i * L + j] = (uint16_t)((i << 8) + j);
         }
     }
+
+    poly_uniform(a_batch, rho, nonce_batch, K * L);
 }
 
 
@@ -71,23 +63,70 @@ void polyvecl_uniform_eta(polyvecl *v, const uint8_t seed[CRHBYTES], uint16_t no
     poly_uniform_eta(&v->vec[i], seed, nonce++);
 }
 
-// Função otimizada para utilizar poly_uniform_gamma1_2x
-void polyvecl_uniform_gamma1(polyvecl *v, const uint8_t seed[CRHBYTES], uint16_t nonce) {
+// Amostra v->vec[0..len-1] (nonces L*nonce+i) em grupos de três com o Keccak
+// híbrido x3, depois um par com o x2 e por fim um polinômio isolado. No
+// AVX2 e no RVV os grupos de quatro vão antes, com o Keccak x4
+static void polyvecl_uniform_gamma1_range(polyvecl *v, unsigned int len, const uint8_t seed[CRHBYTES], uint16_t nonce) {
   unsigned int i = 0;
 
-  // Processar dois polinômios por vez, garantindo que o nonce seja calculado corretamente
-  for (; i + 1 < L; i += 2) {
+#if defined(__AVX2__) || defined(__riscv_vector)
+  for (; i + 4 <= len; i += 4) {
+    uint16_t nonce0 = L * nonce + i;
+    poly_uniform_gamma1_4x(&v->vec[i], &v->vec[i + 1], &v->vec[i + 2], &v->vec[i + 3], seed,
+                           nonce0, nonce0 + 1, nonce0 + 2, nonce0 + 3);
+  }
+#endif
+
+  for (; i + 3 <= len; i += 3) {
     uint16_t nonce0 = L * nonce + i;
-    uint16_t nonce1 = L * nonce + i + 1;
-    poly_uniform_gamma1_2x(&v->vec[i], &v->vec[i + 1], seed, nonce0, nonce1);
+    poly_uniform_gamma1_3x(&v->vec[i], &v->vec[i + 1], &v->vec[i + 2], seed,
+                           nonce0, nonce0 + 1, nonce0 + 2);
   }
 
-  // Se L for ímpar, processar o último polinômio individualmente
-  if (i < L) {
+  if (len - i == 2) {
+    uint16_t nonce0 = L * nonce + i;
+    poly_uniform_gamma1_2x(&v->vec[i], &v->vec[i + 1], seed, nonce0, nonce0 + 1);
+  } else if (len - i == 1) {
     poly_uniform_gamma1(&v->vec[i], seed, L * nonce + i);
   }
 }
 
+void polyvecl_uniform_gamma1(polyvecl *v, const uint8_t seed[CRHBYTES], uint16_t nonce) {
+  polyvecl_uniform_gamma1_range(v, L, seed, nonce);
+}
+
+
+#if L % GAMMA1_LANES == 1
+/*************************************************
+* Name:        polyvecl_uniform_gamma1_interleaved
+*
+* Description: Same output as polyvecl_uniform_gamma1(v, seed, nonce), but
+*              when L % GAMMA1_LANES == 1 the last polynomial, which would
+*              otherwise be sampled alone, shares an x2 call with the last
+*              polynomial of attempt nonce+1. For even nonce both are sampled and the
+*              second one is kept in *next; for odd nonce it is taken from
+*              *next. Attempts must therefore be made with consecutive
+*              nonces starting from an even one.
+*
+* Arguments:   - polyvecl *v: pointer to output vector
+*              - poly *next: pointer to look-ahead polynomial
+*              - const uint8_t seed[]: byte array with seed of length CRHBYTES
+*              - uint16_t nonce: attempt counter
+**************************************************/
+void polyvecl_uniform_gamma1_interleaved(polyvecl *v, poly *next, const uint8_t seed[CRHBYTES], uint16_t nonce) {
+  polyvecl_uniform_gamma1_range(v, L - 1, seed, nonce);
+
+  // Último polinômio: usa a faixa livre do Keccak x2 para a próxima tentativa
+  if (nonce & 1) {
+    v->vec[L - 1] = *next;
+  } else {
+    uint16_t nonce0 = L * nonce + L - 1;
+    uint16_t nonce1 = L * (nonce + 1) + L - 1;
+    poly_uniform_gamma1_2x(&v->vec[L - 1], next, seed, nonce0, nonce1);
+  }
+}
+#endif
+
 
 void polyvecl_reduce(polyvecl *v) {
   unsigned int i;
@@ -142,6 +181,23 @@ void polyvecl_pointwise_poly_montgomery(polyvecl *r, const poly *a, const polyve
     poly_pointwise_montgomery(&r->vec[i], a, &v->vec[i]);
 }
 
+/*************************************************
+* Name:        polyvecl_sparse_mul
+*
+* Description: Multiply all polynomials in vector of length L by the sparse
+*              challenge c. Works in the normal domain; no NTT involved.
+*
+* Arguments:   - polyvecl *r: pointer to output vector
+*              - const sparse_challenge *c: pointer to sparse challenge
+*              - const polyvecl *v: pointer to input vector
+**************************************************/
+void polyvecl_sparse_mul(polyvecl *r, const sparse_challenge *c, const polyvecl *v) {
+  unsigned int i;
+
+  for(i = 0; i < L; ++i)
+    poly_sparse_mul(&r->vec[i], c, &v->vec[i]);
+}
+
 /*************************************************
 * Name:        polyvecl_pointwise_acc_montgomery
 *
@@ -157,6 +213,10 @@ void polyvecl_pointwise_acc_montgomery(poly *w,
                                        const polyvecl *u,
                                        const polyvecl *v)
 {
+#if defined(__AVX512F__)
+  // Multiplica e acumula em registradores, sem o polinômio temporário
+  poly_pointwise_acc_montgomery(w, u->vec, v->vec, L);
+#else
   unsigned int i;
   poly t;
 
@@ -165,6 +225,7 @@ void polyvecl_pointwise_acc_montgomery(poly *w,
     poly_pointwise_montgomery(&t, &u->vec[i], &v->vec[i]);
     poly_add(w, w, &t);
   }
+#endif
 }
 
 /*************************************************
@@ -318,6 +379,23 @@ void polyveck_pointwise_poly_montgomery(polyveck *r, const poly *a, const polyve
     poly_pointwise_montgomery(&r->vec[i], a, &v->vec[i]);
 }
 
+/*************************************************
+* Name:        polyveck_sparse_mul
+*
+* Description: Multiply all polynomials in vector of length K by the sparse
+*              challenge c. Works in the normal domain; no NTT involved.
+*
+* Arguments:   - polyveck *r: pointer to output vector
+*              - const sparse_challenge *c: pointer to sparse challenge
+*              - const polyveck *v: pointer to input vector
+**************************************************/
+void polyveck_sparse_mul(polyveck *r, const sparse_challenge *c, const polyveck *v) {
+  unsigned int i;
+
+  for(i = 0; i < K; ++i)
+    poly_sparse_mul(&r->vec[i], c, &v->vec[i]);
+}
+
 
 /*************************************************
 * Name:        polyveck_chknorm
@@ -356,10 +434,14 @@ int polyveck_chknorm(const polyveck *v, int32_t bound) {
 *              - const polyveck *v: pointer to input vector
 **************************************************/
 void polyveck_power2round(polyveck *v1, polyveck *v0, const polyveck *v) {
+#if defined(__riscv_vector)
   unsigned int i;
 
   for(i = 0; i < K; ++i)
     poly_power2round(&v1->vec[i], &v0->vec[i], &v->vec[i]);
+#else
+  poly_power2round_n(v1->vec, v0->vec, v->vec, K);
+#endif
 }
 
 /*************************************************
@@ -378,31 +460,40 @@ void polyveck_power2round(polyveck *v1, polyveck *v0, const polyveck *v) {
 *              - const polyveck *v: pointer to input vector
 **************************************************/
 void polyveck_decompose(polyveck *v1, polyveck *v0, const polyveck *v) {
+#if defined(__riscv_vector)
   unsigned int i;
 
   for(i = 0; i < K; ++i)
     poly_decompose(&v1->vec[i], &v0->vec[i], &v->vec[i]);
+#else
+  poly_decompose_n(v1->vec, v0->vec, v->vec, K);
+#endif
 }
 
 /*************************************************
 * Name:        polyveck_make_hint
 *
-* Description: Compute hint vector.
+* Description: Compute hint vector as a bitset. Stops as soon as the
+*              number of 1 bits exceeds OMEGA; the signature is then
+*              rejected and the remaining polynomials are not computed.
 *
-* Arguments:   - polyveck *h: pointer to output vector
+* Arguments:   - bitset_hint *h: pointer to output hint
 *              - const polyveck *v0: pointer to low part of input vector
 *              - const polyveck *v1: pointer to high part of input vector
 *
-* Returns number of 1 bits.
+* Returns number of 1 bits (greater than OMEGA if stopped early).
 **************************************************/
-unsigned int polyveck_make_hint(polyveck *h,
+unsigned int polyveck_make_hint(bitset_hint *h,
                                 const polyveck *v0,
                                 const polyveck *v1)
 {
   unsigned int i, s = 0;
 
-  for(i = 0; i < K; ++i)
-    s += poly_make_hint(&h->vec[i], &v0->vec[i], &v1->vec[i]);
+  for(i = 0; i < K; ++i) {
+    s += poly_make_hint_bits(h->bits[i], &v0->vec[i], &v1->vec[i]);
+    if(s > OMEGA)
+      break;
+  }
 
   return s;
 }
@@ -418,10 +509,88 @@ unsigned int polyveck_make_hint(polyveck *h,
 *              - const polyveck *h: pointer to input hint vector
 **************************************************/
 void polyveck_use_hint(polyveck *w, const polyveck *u, const polyveck *h) {
+#if defined(__riscv_vector)
   unsigned int i;
 
   for(i = 0; i < K; ++i)
     poly_use_hint(&w->vec[i], &u->vec[i], &h->vec[i]);
+#else
+  poly_use_hint_n(w->vec, u->vec, h->vec, K);
+#endif
+}
+
+/*************************************************
+* Name:        polyveck_use_hint_absorb_w1
+*
+* Description: Use hint in sparse form to correct the high bits of the
+*              input vector and absorb them bit-packed into a SHAKE256
+*              state. Each polynomial takes the standard representative
+*              and its high bits in one vectorized pass, gets its at most
+*              OMEGA hinted positions corrected and is packed into a
+*              stack buffer of POLYW1_PACKEDBYTES and absorbed while still
+*              in cache; only one polynomial of w1 and its packed bytes are
+*              held at a time, never the full K*POLYW1_PACKEDBYTES.
+*
+* Arguments:   - keccak_state *state: pointer to initialized SHAKE256 state
+*              - const polyveck *u: pointer to input vector with
+*                                   coefficients in ]-Q, Q[
+*              - const sparse_hint *h: pointer to input hint
+**************************************************/
+void polyveck_use_hint_absorb_w1(keccak_state *state, const polyveck *u, const sparse_hint *h) {
+  unsigned int i, j, k;
+  int32_t c;
+  uint8_t buf[POLYW1_PACKEDBYTES];
+  poly w;
+
+  for(i = 0, k = 0; i < K; k = h->cut[i++]) {
+#if defined(__riscv_vector)
+    int32_t a0;
+
+    for(j = 0; j < N; ++j) {
+      c = u->vec[i].coeffs[j];
+      c += (c >> 31) & Q;
+      w.coeffs[j] = decompose(&a0, c);
+    }
+#else
+    poly_highbits_n(&w, &u->vec[i], 1);
+#endif
+
+    for(j = k; j < h->cut[i]; ++j) {
+      c = u->vec[i].coeffs[h->idx[j]];
+      c += (c >> 31) & Q;
+      w.coeffs[h->idx[j]] = use_hint(c, 1);
+    }
+
+    polyw1_pack(buf, &w);
+    shake256_absorb(state, buf, POLYW1_PACKEDBYTES);
+  }
+}
+
+/*************************************************
+* Name:        polyveck_decompose_absorb_w1
+*
+* Description: Decompose vector of length K and absorb the bit-packed high
+*              bits into a SHAKE256 state. The standard representative,
+*              decomposition, packing and absorption are done polynomial by
+*              polynomial, so the packed bytes never leave the cache and no
+*              separate caddq pass over the vector is needed.
+*
+* Arguments:   - keccak_state *state: pointer to initialized SHAKE256 state
+*              - polyveck *v1: pointer to output vector of polynomials with
+*                              coefficients a1
+*              - polyveck *v0: pointer to output vector of polynomials with
+*                              coefficients a0
+*              - const polyveck *v: pointer to input vector with
+*                                   coefficients in ]-Q, Q[
+**************************************************/
+void polyveck_decompose_absorb_w1(keccak_state *state, polyveck *v1, polyveck *v0, const polyveck *v) {
+  unsigned int i;
+  uint8_t buf[POLYW1_PACKEDBYTES];
+
+  for(i = 0; i < K; ++i) {
+    poly_decompose_w1(buf, &v1->vec[i], &v0->vec[i], &v->vec[i]);
+    shake256_absorb(state, buf, POLYW1_PACKEDBYTES);
+  }
 }
 
 void polyveck_pack_w1(uint8_t r[K*POLYW1_PACKEDBYTES], const polyveck *w1) {
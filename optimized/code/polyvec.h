@@ -4,6 +4,7 @@
 #include <stdint.h>
 #include "params.h"
 #include "poly.h"
+#include "fips202.h"
 
 /* Vectors of polynomials of length L */
 typedef struct {
@@ -15,6 +16,19 @@ void polyvecl_uniform_eta(polyvecl *v, const uint8_t seed[CRHBYTES], uint16_t no
 
 #define polyvecl_uniform_gamma1 DILITHIUM_NAMESPACE(polyvecl_uniform_gamma1)
 void polyvecl_uniform_gamma1(polyvecl *v, const uint8_t seed[CRHBYTES], uint16_t nonce);
+/* Polinômios de y por chamada do Keccak em lote em polyvecl_uniform_gamma1:
+ * 4 no AVX2, AVX-512 e RVV (Keccak x4), 3 nos demais. A amostragem
+ * antecipada do último polinômio só compensa quando ele sobraria sozinho */
+#if defined(__AVX2__) || defined(__riscv_vector)
+#define GAMMA1_LANES 4
+#else
+#define GAMMA1_LANES 3
+#endif
+
+#if L % GAMMA1_LANES == 1
+#define polyvecl_uniform_gamma1_interleaved DILITHIUM_NAMESPACE(polyvecl_uniform_gamma1_interleaved)
+void polyvecl_uniform_gamma1_interleaved(polyvecl *v, poly *next, const uint8_t seed[CRHBYTES], uint16_t nonce);
+#endif
 
 #define polyvecl_reduce DILITHIUM_NAMESPACE(polyvecl_reduce)
 void polyvecl_reduce(polyvecl *v);
@@ -28,6 +42,8 @@ void polyvecl_ntt(polyvecl *v);
 void polyvecl_invntt_tomont(polyvecl *v);
 #define polyvecl_pointwise_poly_montgomery DILITHIUM_NAMESPACE(polyvecl_pointwise_poly_montgomery)
 void polyvecl_pointwise_poly_montgomery(polyvecl *r, const poly *a, const polyvecl *v);
+#define polyvecl_sparse_mul DILITHIUM_NAMESPACE(polyvecl_sparse_mul)
+void polyvecl_sparse_mul(polyvecl *r, const sparse_challenge *c, const polyvecl *v);
 #define polyvecl_pointwise_acc_montgomery \
         DILITHIUM_NAMESPACE(polyvecl_pointwise_acc_montgomery)
 void polyvecl_pointwise_acc_montgomery(poly *w,
@@ -45,6 +61,19 @@ typedef struct {
   poly vec[K];
 } polyveck;
 
+/* Hint h in the sparse form of the signature: the ones of polynomial i
+ * are at positions idx[cut[i-1]], ..., idx[cut[i] - 1], with cut[-1] = 0. */
+typedef struct {
+  uint8_t idx[OMEGA];
+  uint8_t cut[K];
+} sparse_hint;
+
+/* Hint h of the signing path as a bitset: bit j of bits[i][w] is
+ * coefficient 64*w + j of polynomial i. */
+typedef struct {
+  uint64_t bits[K][N/64];
+} bitset_hint;
+
 #define polyveck_uniform_eta DILITHIUM_NAMESPACE(polyveck_uniform_eta)
 void polyveck_uniform_eta(polyveck *v, const uint8_t seed[CRHBYTES], uint16_t nonce);
 
@@ -66,6 +95,8 @@ void polyveck_ntt(polyveck *v);
 void polyveck_invntt_tomont(polyveck *v);
 #define polyveck_pointwise_poly_montgomery DILITHIUM_NAMESPACE(polyveck_pointwise_poly_montgomery)
 void polyveck_pointwise_poly_montgomery(polyveck *r, const poly *a, const polyveck *v);
+#define polyveck_sparse_mul DILITHIUM_NAMESPACE(polyveck_sparse_mul)
+void polyveck_sparse_mul(polyveck *r, const sparse_challenge *c, const polyveck *v);
 
 #define polyveck_chknorm DILITHIUM_NAMESPACE(polyveck_chknorm)
 int polyveck_chknorm(const polyveck *v, int32_t B);
@@ -75,11 +106,15 @@ void polyveck_power2round(polyveck *v1, polyveck *v0, const polyveck *v);
 #define polyveck_decompose DILITHIUM_NAMESPACE(polyveck_decompose)
 void polyveck_decompose(polyveck *v1, polyveck *v0, const polyveck *v);
 #define polyveck_make_hint DILITHIUM_NAMESPACE(polyveck_make_hint)
-unsigned int polyveck_make_hint(polyveck *h,
+unsigned int polyveck_make_hint(bitset_hint *h,
                                 const polyveck *v0,
                                 const polyveck *v1);
 #define polyveck_use_hint DILITHIUM_NAMESPACE(polyveck_use_hint)
 void polyveck_use_hint(polyveck *w, const polyveck *v, const polyveck *h);
+#define polyveck_use_hint_absorb_w1 DILITHIUM_NAMESPACE(polyveck_use_hint_absorb_w1)
+void polyveck_use_hint_absorb_w1(keccak_state *state, const polyveck *u, const sparse_hint *h);
+#define polyveck_decompose_absorb_w1 DILITHIUM_NAMESPACE(polyveck_decompose_absorb_w1)
+void polyveck_decompose_absorb_w1(keccak_state *state, polyveck *v1, polyveck *v0, const polyveck *v);
 
 #define polyveck_pack_w1 DILITHIUM_NAMESPACE(polyveck_pack_w1)
 void polyveck_pack_w1(uint8_t r[K*POLYW1_PACKEDBYTES], const polyveck *w1);
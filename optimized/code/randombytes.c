@@ -1,6 +1,8 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
+#include "config.h"
 #include "randombytes.h"
 
 #ifdef _WIN32
@@ -16,10 +18,18 @@
 #else
 #include <unistd.h>
 #endif
+#ifdef __wasi__
+#include <sys/random.h>
+#endif
+#endif
+
+#if defined(DILITHIUM_DRBG_SHAKE256) && !defined(_WIN32)
+#include <pthread.h>
+#include "fips202.h"
 #endif
 
 #ifdef _WIN32
-void randombytes(uint8_t *out, size_t outlen) {
+static void randombytes_sys(uint8_t *out, size_t outlen) {
   HCRYPTPROV ctx;
   size_t len;
 
@@ -38,8 +48,22 @@ void randombytes(uint8_t *out, size_t outlen) {
   if(!CryptReleaseContext(ctx, 0))
     abort();
 }
+#elif defined(__wasi__)
+static void randombytes_sys(uint8_t *out, size_t outlen) {
+  size_t len;
+
+  /* WASI: random_get do runtime via getentropy (até 256 bytes por chamada) */
+  while(outlen > 0) {
+    len = (outlen > 256) ? 256 : outlen;
+    if(getentropy(out, len) == -1)
+      abort();
+
+    out += len;
+    outlen -= len;
+  }
+}
 #elif defined(__linux__) && defined(SYS_getrandom)
-void randombytes(uint8_t *out, size_t outlen) {
+static void randombytes_sys(uint8_t *out, size_t outlen) {
   ssize_t ret;
 
   while(outlen > 0) {
@@ -54,7 +78,7 @@ void randombytes(uint8_t *out, size_t outlen) {
   }
 }
 #else
-void randombytes(uint8_t *out, size_t outlen) {
+static void randombytes_sys(uint8_t *out, size_t outlen) {
   static int fd = -1;
   ssize_t ret;
 
@@ -78,3 +102,114 @@ void randombytes(uint8_t *out, size_t outlen) {
   }
 }
 #endif
+
+#if defined(DILITHIUM_DRBG_SHAKE256) && !defined(_WIN32)
+/*************************************************
+* Per-thread SHAKE256 DRBG
+*
+* Each thread keeps a 32-byte key and a buffer of output. A refill computes
+* SHAKE256(key) and splits the result into the next key and the new buffer
+* (fast key erasure), so bytes already handed out cannot be recomputed from
+* the state. Served bytes are wiped from the buffer. The key is mixed with
+* fresh OS randomness on first use, every DRBG_RESEED_INTERVAL bytes (checked
+* at each refill, so also within one large request) and in
+* the child after fork(); the fork check is a generation counter bumped by a
+* pthread_atfork handler, so no syscall is needed per request.
+**************************************************/
+#define DRBG_KEYBYTES 32
+#define DRBG_NBLOCKS 4
+#define DRBG_BUFBYTES (DRBG_NBLOCKS*SHAKE256_RATE - DRBG_KEYBYTES)
+#ifndef DRBG_RESEED_INTERVAL
+#define DRBG_RESEED_INTERVAL (1UL << 20)
+#endif
+
+typedef struct {
+  uint8_t key[DRBG_KEYBYTES];
+  uint8_t buf[DRBG_BUFBYTES];
+  unsigned int pos;
+  unsigned long generated;
+  unsigned long generation;
+  int seeded;
+} drbg_state;
+
+static __thread drbg_state drbg;
+static volatile unsigned long drbg_fork_generation;
+static int drbg_atfork_registered;
+
+// memset chamado por um ponteiro volátil: o compilador não pode provar
+// que a limpeza é inútil e removê-la, como faz com memset em variáveis
+// locais que não são mais lidas
+static void *(*const volatile drbg_memset)(void *, int, size_t) = memset;
+
+static void drbg_wipe(void *p, size_t len) {
+  drbg_memset(p, 0, len);
+}
+
+static void drbg_atfork_child(void) {
+  drbg_fork_generation++;
+}
+
+static void drbg_reseed(void) {
+  uint8_t seed[2*DRBG_KEYBYTES];
+
+  if(!__atomic_exchange_n(&drbg_atfork_registered, 1, __ATOMIC_ACQ_REL))
+    if(pthread_atfork(NULL, NULL, drbg_atfork_child))
+      abort();
+
+  memcpy(seed, drbg.key, DRBG_KEYBYTES);
+  randombytes_sys(seed + DRBG_KEYBYTES, DRBG_KEYBYTES);
+  shake256(drbg.key, DRBG_KEYBYTES, seed, sizeof(seed));
+  drbg_wipe(seed, sizeof(seed));
+
+  drbg_wipe(drbg.buf, DRBG_BUFBYTES);
+  drbg.pos = DRBG_BUFBYTES;
+  drbg.generated = 0;
+  drbg.generation = drbg_fork_generation;
+  drbg.seeded = 1;
+}
+
+static void drbg_refill(void) {
+  uint8_t out[DRBG_NBLOCKS*SHAKE256_RATE];
+  keccak_state state;
+
+  shake256_absorb_once(&state, drbg.key, DRBG_KEYBYTES);
+  shake256_squeezeblocks(out, DRBG_NBLOCKS, &state);
+  memcpy(drbg.key, out, DRBG_KEYBYTES);
+  memcpy(drbg.buf, out + DRBG_KEYBYTES, DRBG_BUFBYTES);
+  drbg_wipe(out, sizeof(out));
+  drbg_wipe(&state, sizeof(state));
+  drbg.pos = 0;
+}
+
+void randombytes(uint8_t *out, size_t outlen) {
+  size_t len;
+
+  if(!drbg.seeded || drbg.generation != drbg_fork_generation)
+    drbg_reseed();
+
+  while(outlen > 0) {
+    if(drbg.pos == DRBG_BUFBYTES) {
+      // O intervalo é conferido a cada recarga, de modo que um pedido
+      // grande também é ressemeado no meio
+      if(drbg.generated >= DRBG_RESEED_INTERVAL)
+        drbg_reseed();
+      drbg_refill();
+    }
+
+    len = DRBG_BUFBYTES - drbg.pos;
+    if(len > outlen)
+      len = outlen;
+    memcpy(out, drbg.buf + drbg.pos, len);
+    // Bytes entregues saem do buffer: só a chave já avançada fica no estado
+    drbg_wipe(drbg.buf + drbg.pos, len);
+    drbg.pos += len;
+    drbg.generated += len;
+    out += len;
+    outlen -= len;
+  }
+}
+#else
+void randombytes(uint8_t *out, size_t outlen) {
+  randombytes_sys(out, outlen);
+}
+#endif
@@ -19,6 +19,7 @@ int32_t montgomery_reduce(int64_t a) {
   t = (a - (int64_t)t*Q) >> 32;
   return t;
 }
+#if defined(__ARM_NEON)
 // Esta versão trouxe assertividade e aceleração de 1.5x em relação à implementação de referência
 // Função Montgomery de Redução Otimizada para 4 coeficientes
 int32x4_t montgomery_reduce_neon_4(int64x2x2_t a) {
@@ -80,6 +81,7 @@ int32x4x2_t montgomery_reduce_neon_8(int64x2x2_t a1, int64x2x2_t a2) {
 
     return (int32x4x2_t) { result1, result2 };
 }
+#endif
 
 /*************************************************
 * Name:        reduce32
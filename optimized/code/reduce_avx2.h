@@ -0,0 +1,70 @@
+#ifndef REDUCE_AVX2_H
+#define REDUCE_AVX2_H
+
+#include <immintrin.h>
+#include "params.h"
+#include "reduce.h"
+
+/*************************************************
+* Name:        montgomery_mul_avx2
+*
+* Description: For 8 pairs of int32_t coefficients compute
+*              montgomery_reduce((int64_t)a*b) exactly as the scalar
+*              and NEON versions do: the full 64-bit products are formed
+*              by _mm256_mul_epi32 on the even and odd lanes.
+*
+* Arguments:   - __m256i a: first factors
+*              - __m256i b: second factors
+*
+* Returns r = a*b*2^{-32} mod Q with -Q < r < Q.
+**************************************************/
+static inline __m256i montgomery_mul_avx2(__m256i a, __m256i b) {
+  const __m256i q = _mm256_set1_epi32(Q);
+  const __m256i qinv = _mm256_set1_epi32(QINV);
+  __m256i p_even, p_odd, t_even, t_odd;
+
+  // Produtos de 64 bits das posições pares e ímpares
+  p_even = _mm256_mul_epi32(a, b);
+  p_odd = _mm256_mul_epi32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+
+  // t = (int32_t)p * QINV; mul_epi32 só usa os 32 bits baixos de cada operando
+  t_even = _mm256_mul_epi32(p_even, qinv);
+  t_odd = _mm256_mul_epi32(p_odd, qinv);
+
+  // (p - t*Q) >> 32
+  t_even = _mm256_sub_epi64(p_even, _mm256_mul_epi32(t_even, q));
+  t_odd = _mm256_sub_epi64(p_odd, _mm256_mul_epi32(t_odd, q));
+
+  return _mm256_blend_epi32(_mm256_srli_epi64(t_even, 32), t_odd, 0xAA);
+}
+
+/*************************************************
+* Name:        reduce32_avx2
+*
+* Description: reduce32 on 8 coefficients.
+*
+* Arguments:   - __m256i a: coefficients with a <= 2^{31} - 2^{22} - 1
+*
+* Returns r \equiv a (mod Q) with -6283008 <= r <= 6283008.
+**************************************************/
+static inline __m256i reduce32_avx2(__m256i a) {
+  __m256i t = _mm256_add_epi32(a, _mm256_set1_epi32(1 << 22));
+  t = _mm256_srai_epi32(t, 23);
+  return _mm256_sub_epi32(a, _mm256_mullo_epi32(t, _mm256_set1_epi32(Q)));
+}
+
+/*************************************************
+* Name:        caddq_avx2
+*
+* Description: caddq on 8 coefficients: add Q where negative.
+*
+* Arguments:   - __m256i a: coefficients
+*
+* Returns a + Q where a < 0, a elsewhere.
+**************************************************/
+static inline __m256i caddq_avx2(__m256i a) {
+  __m256i t = _mm256_and_si256(_mm256_srai_epi32(a, 31), _mm256_set1_epi32(Q));
+  return _mm256_add_epi32(a, t);
+}
+
+#endif
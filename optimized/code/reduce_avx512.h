@@ -0,0 +1,40 @@
+#ifndef REDUCE_AVX512_H
+#define REDUCE_AVX512_H
+
+#include <immintrin.h>
+#include "params.h"
+#include "reduce.h"
+
+/*************************************************
+* Name:        montgomery_mul_avx512
+*
+* Description: For 16 pairs of int32_t coefficients compute
+*              montgomery_reduce((int64_t)a*b); same even/odd lane
+*              scheme as montgomery_mul_avx2.
+*
+* Arguments:   - __m512i a: first factors
+*              - __m512i b: second factors
+*
+* Returns r = a*b*2^{-32} mod Q with -Q < r < Q.
+**************************************************/
+static inline __m512i montgomery_mul_avx512(__m512i a, __m512i b) {
+  const __m512i q = _mm512_set1_epi32(Q);
+  const __m512i qinv = _mm512_set1_epi32(QINV);
+  __m512i p_even, p_odd, t_even, t_odd;
+
+  // Produtos de 64 bits das posições pares e ímpares
+  p_even = _mm512_mul_epi32(a, b);
+  p_odd = _mm512_mul_epi32(_mm512_srli_epi64(a, 32), _mm512_srli_epi64(b, 32));
+
+  // t = (int32_t)p * QINV
+  t_even = _mm512_mul_epi32(p_even, qinv);
+  t_odd = _mm512_mul_epi32(p_odd, qinv);
+
+  // (p - t*Q) >> 32
+  t_even = _mm512_sub_epi64(p_even, _mm512_mul_epi32(t_even, q));
+  t_odd = _mm512_sub_epi64(p_odd, _mm512_mul_epi32(t_odd, q));
+
+  return _mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(t_even, 32), t_odd);
+}
+
+#endif
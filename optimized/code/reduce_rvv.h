@@ -0,0 +1,60 @@
+#ifndef REDUCE_RVV_H
+#define REDUCE_RVV_H
+
+#include <stddef.h>
+#include <riscv_vector.h>
+#include "params.h"
+#include "reduce.h"
+
+/*************************************************
+* Name:        montgomery_mul_rvv
+*
+* Description: For vl int32_t lanes compute montgomery_reduce((int64_t)a*b)
+*              with vmulh/vmul: the low halves of a*b and t*Q,
+*              t = (int32_t)(a*b)*QINV, are equal, so the difference of the
+*              high halves is exactly (a*b - t*Q) >> 32.
+*
+* Arguments:   - vint32m1_t a: first factors
+*              - vint32m1_t b: second factors
+*              - size_t vl: number of lanes
+*
+* Returns r = a*b*2^{-32} mod Q with -Q < r < Q.
+**************************************************/
+static inline vint32m1_t montgomery_mul_rvv(vint32m1_t a, vint32m1_t b, size_t vl) {
+  vint32m1_t hi = __riscv_vmulh_vv_i32m1(a, b, vl);
+  vint32m1_t t = __riscv_vmul_vx_i32m1(__riscv_vmul_vv_i32m1(a, b, vl), QINV, vl);
+
+  return __riscv_vsub_vv_i32m1(hi, __riscv_vmulh_vx_i32m1(t, Q, vl), vl);
+}
+
+/*************************************************
+* Name:        reduce32_rvv
+*
+* Description: reduce32 on vl lanes.
+*
+* Arguments:   - vint32m1_t a: coefficients with a <= 2^{31} - 2^{22} - 1
+*              - size_t vl: number of lanes
+*
+* Returns r \equiv a (mod Q) with -6283008 <= r <= 6283008.
+**************************************************/
+static inline vint32m1_t reduce32_rvv(vint32m1_t a, size_t vl) {
+  vint32m1_t t = __riscv_vsra_vx_i32m1(__riscv_vadd_vx_i32m1(a, 1 << 22, vl), 23, vl);
+  return __riscv_vnmsac_vx_i32m1(a, Q, t, vl);
+}
+
+/*************************************************
+* Name:        caddq_rvv
+*
+* Description: caddq on vl lanes: add Q where negative.
+*
+* Arguments:   - vint32m1_t a: coefficients
+*              - size_t vl: number of lanes
+*
+* Returns a + Q where a < 0, a elsewhere.
+**************************************************/
+static inline vint32m1_t caddq_rvv(vint32m1_t a, size_t vl) {
+  vint32m1_t t = __riscv_vand_vx_i32m1(__riscv_vsra_vx_i32m1(a, 31, vl), Q, vl);
+  return __riscv_vadd_vv_i32m1(a, t, vl);
+}
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef REDUCE_SVE_H
+#define REDUCE_SVE_H
+
+#include <arm_sve.h>
+#include "params.h"
+#include "reduce.h"
+
+/*************************************************
+* Name:        montgomery_mul_sve
+*
+* Description: For the active int32_t lanes compute
+*              montgomery_reduce((int64_t)a*b). The high halves of a*b and
+*              t*Q, t = (int32_t)(a*b)*QINV, are taken with SMULH; since the
+*              low halves of both products are equal, their difference is
+*              exactly (a*b - t*Q) >> 32, as in the scalar version.
+*
+* Arguments:   - svbool_t pg: active lanes
+*              - svint32_t a: first factors
+*              - svint32_t b: second factors
+*
+* Returns r = a*b*2^{-32} mod Q with -Q < r < Q.
+**************************************************/
+static inline svint32_t montgomery_mul_sve(svbool_t pg, svint32_t a, svint32_t b) {
+  svint32_t hi = svmulh_s32_x(pg, a, b);
+  svint32_t t = svmul_n_s32_x(pg, svmul_s32_x(pg, a, b), QINV);
+
+  return svsub_s32_x(pg, hi, svmulh_n_s32_x(pg, t, Q));
+}
+
+/*************************************************
+* Name:        reduce32_sve
+*
+* Description: reduce32 on the active lanes.
+*
+* Arguments:   - svbool_t pg: active lanes
+*              - svint32_t a: coefficients with a <= 2^{31} - 2^{22} - 1
+*
+* Returns r \equiv a (mod Q) with -6283008 <= r <= 6283008.
+**************************************************/
+static inline svint32_t reduce32_sve(svbool_t pg, svint32_t a) {
+  svint32_t t = svasr_n_s32_x(pg, svadd_n_s32_x(pg, a, 1 << 22), 23);
+  return svmls_n_s32_x(pg, a, t, Q);
+}
+
+/*************************************************
+* Name:        caddq_sve
+*
+* Description: caddq on the active lanes: add Q where negative.
+*
+* Arguments:   - svbool_t pg: active lanes
+*              - svint32_t a: coefficients
+*
+* Returns a + Q where a < 0, a elsewhere.
+**************************************************/
+static inline svint32_t caddq_sve(svbool_t pg, svint32_t a) {
+  svint32_t t = svand_n_s32_x(pg, svasr_n_s32_x(pg, a, 31), Q);
+  return svadd_s32_x(pg, a, t);
+}
+
+#endif
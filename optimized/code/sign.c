@@ -9,24 +9,23 @@
 #include "fips202.h"
 
 /*************************************************
-* Name:        crypto_sign_keypair
+* Name:        crypto_sign_keypair_ws
 *
-* Description: Generates public and private key.
+* Description: Generates public and private key. All polynomial vectors
+*              live in the caller-provided workspace.
 *
 * Arguments:   - uint8_t *pk: pointer to output public key (allocated
 *                             array of CRYPTO_PUBLICKEYBYTES bytes)
 *              - uint8_t *sk: pointer to output private key (allocated
 *                             array of CRYPTO_SECRETKEYBYTES bytes)
+*              - dilithium_workspace *ws: pointer to scratch workspace
 *
 * Returns 0 (success)
 **************************************************/
-int crypto_sign_keypair(uint8_t *pk, uint8_t *sk) {
+int crypto_sign_keypair_ws(uint8_t *pk, uint8_t *sk, dilithium_workspace *ws) {
   uint8_t seedbuf[2*SEEDBYTES + CRHBYTES];
   uint8_t tr[TRBYTES];
   const uint8_t *rho, *rhoprime, *key;
-  polyvecl mat[K];
-  polyvecl s1, s1hat;
-  polyveck s2, t1, t0;
 
   /* Get randomness for rho, rhoprime and key */
   randombytes(seedbuf, SEEDBYTES);
@@ -38,84 +37,174 @@ int crypto_sign_keypair(uint8_t *pk, uint8_t *sk) {
   key = rhoprime + CRHBYTES;
 
   /* Expand matrix */
-  polyvec_matrix_expand(mat, rho);
+  polyvec_matrix_expand(ws->mat, rho);
 
   /* Sample short vectors s1 and s2 */
-  polyvecl_uniform_eta(&s1, rhoprime, 0);
-  polyveck_uniform_eta(&s2, rhoprime, L);
+  polyvecl_uniform_eta(&ws->s1, rhoprime, 0);
+  polyveck_uniform_eta(&ws->s2, rhoprime, L);
 
   /* Matrix-vector multiplication */
-  s1hat = s1;
-  polyvecl_ntt(&s1hat);
-  polyvec_matrix_pointwise_montgomery(&t1, mat, &s1hat);
-  polyveck_reduce(&t1);
-  polyveck_invntt_tomont(&t1);
+  ws->z = ws->s1;
+  polyvecl_ntt(&ws->z);
+  polyvec_matrix_pointwise_montgomery(&ws->t1, ws->mat, &ws->z);
+  polyveck_reduce(&ws->t1);
+  polyveck_invntt_tomont(&ws->t1);
 
-  /* Add error vector s2 */
-  polyveck_add(&t1, &t1, &s2);
+  /* Add error vector s2, extract t1 and t0 and write both keys;
+   * each polynomial of t is split and packed in a single pass */
+  pack_keys(pk, sk, rho, key, &ws->t1, &ws->s1, &ws->s2);
 
-  /* Extract t1 and write public key */
-  polyveck_caddq(&t1);
-  polyveck_power2round(&t1, &t0, &t1);
-  pack_pk(pk, rho, &t1);
-
-  /* Compute H(rho, t1) and write secret key */
+  /* Compute H(rho, t1) and complete secret key */
   shake256(tr, TRBYTES, pk, CRYPTO_PUBLICKEYBYTES);
-  pack_sk(sk, rho, tr, key, &t0, &s1, &s2);
+  pack_sk_tr(sk, tr);
 
   return 0;
 }
 
 /*************************************************
-* Name:        crypto_sign_signature
+* Name:        crypto_sign_keypair
+*
+* Description: Generates public and private key using a workspace on
+*              the stack.
+*
+* Arguments:   - uint8_t *pk: pointer to output public key (allocated
+*                             array of CRYPTO_PUBLICKEYBYTES bytes)
+*              - uint8_t *sk: pointer to output private key (allocated
+*                             array of CRYPTO_SECRETKEYBYTES bytes)
+*
+* Returns 0 (success)
+**************************************************/
+int crypto_sign_keypair(uint8_t *pk, uint8_t *sk) {
+  dilithium_workspace ws;
+
+  return crypto_sign_keypair_ws(pk, sk, &ws);
+}
+
+/*************************************************
+* Name:        mu_prefix_init
+*
+* Description: Absorbs tr || 0 || ctxlen || ctx, the part of the input to
+*              mu = CRH(tr, 0, ctxlen, ctx, msg) that does not depend on
+*              the message.
 *
-* Description: Computes signature.
+* Arguments:   - dilithium_mu_prefix *prefix: pointer to output prefix state
+*              - const uint8_t *tr: pointer to public-key hash
+*              - const uint8_t *ctx: pointer to context string
+*              - size_t ctxlen: length of context string (at most 255)
+**************************************************/
+static void mu_prefix_init(dilithium_mu_prefix *prefix,
+                           const uint8_t tr[TRBYTES],
+                           const uint8_t *ctx,
+                           size_t ctxlen)
+{
+  uint8_t pre[2];
+
+  pre[0] = 0;
+  pre[1] = ctxlen;
+  shake256_init(&prefix->state);
+  shake256_absorb(&prefix->state, tr, TRBYTES);
+  shake256_absorb(&prefix->state, pre, 2);
+  shake256_absorb(&prefix->state, ctx, ctxlen);
+}
+
+/*************************************************
+* Name:        crypto_sign_prefix_sk
+*
+* Description: Precomputes the message-independent part of mu for signing
+*              with the given secret key and context string.
+*
+* Arguments:   - dilithium_mu_prefix *prefix: pointer to output prefix state
+*              - const uint8_t *ctx: pointer to context string
+*              - size_t ctxlen: length of context string
+*              - const uint8_t *sk: pointer to bit-packed secret key
+*
+* Returns 0 (success) or -1 (context string too long)
+**************************************************/
+int crypto_sign_prefix_sk(dilithium_mu_prefix *prefix,
+                          const uint8_t *ctx,
+                          size_t ctxlen,
+                          const uint8_t *sk)
+{
+  if(ctxlen > 255)
+    return -1;
+
+  /* tr follows rho and key in the packed secret key */
+  mu_prefix_init(prefix, sk + 2*SEEDBYTES, ctx, ctxlen);
+  return 0;
+}
+
+/*************************************************
+* Name:        crypto_sign_prefix_pk
+*
+* Description: Precomputes the message-independent part of mu for
+*              verifying with the given public key and context string,
+*              including tr = H(pk).
+*
+* Arguments:   - dilithium_mu_prefix *prefix: pointer to output prefix state
+*              - const uint8_t *ctx: pointer to context string
+*              - size_t ctxlen: length of context string
+*              - const uint8_t *pk: pointer to bit-packed public key
+*
+* Returns 0 (success) or -1 (context string too long)
+**************************************************/
+int crypto_sign_prefix_pk(dilithium_mu_prefix *prefix,
+                          const uint8_t *ctx,
+                          size_t ctxlen,
+                          const uint8_t *pk)
+{
+  uint8_t tr[TRBYTES];
+
+  if(ctxlen > 255)
+    return -1;
+
+  shake256(tr, TRBYTES, pk, CRYPTO_PUBLICKEYBYTES);
+  mu_prefix_init(prefix, tr, ctx, ctxlen);
+  return 0;
+}
+
+/*************************************************
+* Name:        crypto_sign_signature_prefix_ws
+*
+* Description: Computes signature from a precomputed mu prefix. All
+*              polynomial vectors live in the caller-provided workspace.
 *
 * Arguments:   - uint8_t *sig:   pointer to output signature (of length CRYPTO_BYTES)
 *              - size_t *siglen: pointer to output length of signature
 *              - uint8_t *m:     pointer to message to be signed
 *              - size_t mlen:    length of message
-*              - uint8_t *ctx:   pointer to context string
-*              - size_t ctxlen:  length of context string
+*              - const dilithium_mu_prefix *prefix: prefix state from
+*                                crypto_sign_prefix_sk for the same sk
 *              - uint8_t *sk:    pointer to bit-packed secret key
+*              - dilithium_workspace *ws: pointer to scratch workspace
 *
-* Returns 0 (success) or -1 (context string too long)
+* Returns 0 (success)
 **************************************************/
-int crypto_sign_signature(uint8_t *sig,
-                          size_t *siglen,
-                          const uint8_t *m,
-                          size_t mlen,
-                          const uint8_t *ctx,
-                          size_t ctxlen,
-                          const uint8_t *sk)
+int crypto_sign_signature_prefix_ws(uint8_t *sig,
+                                    size_t *siglen,
+                                    const uint8_t *m,
+                                    size_t mlen,
+                                    const dilithium_mu_prefix *prefix,
+                                    const uint8_t *sk,
+                                    dilithium_workspace *ws)
 {
-  unsigned int n;
+  unsigned int i, n;
   uint8_t seedbuf[2*SEEDBYTES + TRBYTES + RNDBYTES + 2*CRHBYTES];
   uint8_t *rho, *tr, *key, *mu, *rhoprime, *rnd;
   uint16_t nonce = 0;
-  polyvecl mat[K], s1, y, z;
-  polyveck t0, s2, w1, w0, h;
-  poly cp;
+  sparse_challenge cp;
+  bitset_hint hint;
   keccak_state state;
 
-  if(ctxlen > 255)
-    return -1;
-
   rho = seedbuf;
   tr = rho + SEEDBYTES;
   key = tr + TRBYTES;
   rnd = key + SEEDBYTES;
   mu = rnd + RNDBYTES;
   rhoprime = mu + CRHBYTES;
-  unpack_sk(rho, tr, key, &t0, &s1, &s2, sk);
+  unpack_sk(rho, tr, key, &ws->t0, &ws->s1, &ws->s2, sk);
 
   /* Compute mu = CRH(tr, 0, ctxlen, ctx, msg) */
-  mu[0] = 0;
-  mu[1] = ctxlen;
-  shake256_init(&state);
-  shake256_absorb(&state, tr, TRBYTES);
-  shake256_absorb(&state, mu, 2);
-  shake256_absorb(&state, ctx, ctxlen);
+  shake256_clone(&state, &prefix->state);
   shake256_absorb(&state, m, mlen);
   shake256_finalize(&state);
   shake256_squeeze(mu, CRHBYTES, &state);
@@ -128,71 +217,141 @@ int crypto_sign_signature(uint8_t *sig,
 #endif
   shake256(rhoprime, CRHBYTES, key, SEEDBYTES + RNDBYTES + CRHBYTES);
 
-  /* Expand matrix and transform vectors */
-  polyvec_matrix_expand(mat, rho);
-  polyvecl_ntt(&s1);
-  polyveck_ntt(&s2);
-  polyveck_ntt(&t0);
+  /* Expand matrix; s1, s2 and t0 stay in the normal domain since they
+   * are only ever multiplied by the sparse challenge */
+  polyvec_matrix_expand(ws->mat, rho);
 
 rej:
   /* Sample intermediate vector y */
-  polyvecl_uniform_gamma1(&y, rhoprime, nonce++);
+#if defined(DILITHIUM_INTERLEAVED_MASK) && (L % GAMMA1_LANES == 1)
+  polyvecl_uniform_gamma1_interleaved(&ws->y, &ws->ynext, rhoprime, nonce++);
+#else
+  polyvecl_uniform_gamma1(&ws->y, rhoprime, nonce++);
+#endif
  
   /* Matrix-vector multiplication */
-  z = y;
-  polyvecl_ntt(&z);
-  polyvec_matrix_pointwise_montgomery(&w1, mat, &z);
-  polyveck_reduce(&w1);
-  polyveck_invntt_tomont(&w1);
-
-  /* Decompose w and call the random oracle */
-  polyveck_caddq(&w1);
-  polyveck_decompose(&w1, &w0, &w1);
-  polyveck_pack_w1(sig, &w1);
-
+  ws->z = ws->y;
+  polyvecl_ntt(&ws->z);
+  polyvec_matrix_pointwise_montgomery(&ws->w1, ws->mat, &ws->z);
+  polyveck_reduce(&ws->w1);
+  polyveck_invntt_tomont(&ws->w1);
+
+  /* Decompose w and call the random oracle; the high bits of each
+   * polynomial are packed and absorbed as soon as they are computed */
   shake256_init(&state);
   shake256_absorb(&state, mu, CRHBYTES);
-  shake256_absorb(&state, sig, K*POLYW1_PACKEDBYTES);
+  polyveck_decompose_absorb_w1(&state, &ws->w1, &ws->w0, &ws->w1);
   shake256_finalize(&state);
   shake256_squeeze(sig, CTILDEBYTES, &state);
-  poly_challenge(&cp, sig);
-  poly_ntt(&cp);
+  poly_challenge_sparse(&cp, sig);
 
-  /* Compute z, reject if it reveals secret */
-  polyvecl_pointwise_poly_montgomery(&z, &cp, &s1);
-  polyvecl_invntt_tomont(&z);
-  polyvecl_add(&z, &z, &y);
-  polyvecl_reduce(&z);
-  if(polyvecl_chknorm(&z, GAMMA1 - BETA))
-    goto rej;
+  /* The products with the sparse challenge are exact over the integers:
+   * |c*s1|, |c*s2| <= BETA and |c*t0| <= TAU*2^(D-1), so no reduction is
+   * needed and the norm checks see the centered values directly. */
+
+  /* Each polynomial is finished and checked in turn so a rejected attempt
+   * stops at the first failing one. The low bits check runs first: it is
+   * the most likely to fail (GAMMA2 < GAMMA1) and costs the same per
+   * polynomial as the z check. The c*t0 check almost never fails and only
+   * runs on attempts that are otherwise accepted. */
 
   /* Check that subtracting cs2 does not change high bits of w and low bits
    * do not reveal secret information */
-  polyveck_pointwise_poly_montgomery(&h, &cp, &s2);
-  polyveck_invntt_tomont(&h);
-  polyveck_sub(&w0, &w0, &h);
-  polyveck_reduce(&w0);
-  if(polyveck_chknorm(&w0, GAMMA2 - BETA))
-    goto rej;
+  for(i = 0; i < K; ++i) {
+    poly_sparse_mul(&ws->h.vec[i], &cp, &ws->s2.vec[i]);
+    poly_sub(&ws->w0.vec[i], &ws->w0.vec[i], &ws->h.vec[i]);
+    if(poly_chknorm(&ws->w0.vec[i], GAMMA2 - BETA))
+      goto rej;
+  }
+
+  /* Compute z, reject if it reveals secret */
+  for(i = 0; i < L; ++i) {
+    poly_sparse_mul(&ws->z.vec[i], &cp, &ws->s1.vec[i]);
+    poly_add(&ws->z.vec[i], &ws->z.vec[i], &ws->y.vec[i]);
+    if(poly_chknorm(&ws->z.vec[i], GAMMA1 - BETA))
+      goto rej;
+  }
 
   /* Compute hints for w1 */
-  polyveck_pointwise_poly_montgomery(&h, &cp, &t0);
-  polyveck_invntt_tomont(&h);
-  polyveck_reduce(&h);
-  if(polyveck_chknorm(&h, GAMMA2))
-    goto rej;
+  for(i = 0; i < K; ++i) {
+    poly_sparse_mul(&ws->h.vec[i], &cp, &ws->t0.vec[i]);
+    if(poly_chknorm(&ws->h.vec[i], GAMMA2))
+      goto rej;
+    poly_add(&ws->w0.vec[i], &ws->w0.vec[i], &ws->h.vec[i]);
+  }
 
-  polyveck_add(&w0, &w0, &h);
-  n = polyveck_make_hint(&h, &w0, &w1);
+  n = polyveck_make_hint(&hint, &ws->w0, &ws->w1);
   if(n > OMEGA)
     goto rej;
 
   /* Write signature */
-  pack_sig(sig, sig, &z, &h);
+  pack_sig(sig, sig, &ws->z, &hint);
   *siglen = CRYPTO_BYTES;
   return 0;
 }
 
+/*************************************************
+* Name:        crypto_sign_signature_ws
+*
+* Description: Computes signature. All polynomial vectors live in the
+*              caller-provided workspace.
+*
+* Arguments:   - uint8_t *sig:   pointer to output signature (of length CRYPTO_BYTES)
+*              - size_t *siglen: pointer to output length of signature
+*              - uint8_t *m:     pointer to message to be signed
+*              - size_t mlen:    length of message
+*              - uint8_t *ctx:   pointer to context string
+*              - size_t ctxlen:  length of context string
+*              - uint8_t *sk:    pointer to bit-packed secret key
+*              - dilithium_workspace *ws: pointer to scratch workspace
+*
+* Returns 0 (success) or -1 (context string too long)
+**************************************************/
+int crypto_sign_signature_ws(uint8_t *sig,
+                             size_t *siglen,
+                             const uint8_t *m,
+                             size_t mlen,
+                             const uint8_t *ctx,
+                             size_t ctxlen,
+                             const uint8_t *sk,
+                             dilithium_workspace *ws)
+{
+  dilithium_mu_prefix prefix;
+
+  if(crypto_sign_prefix_sk(&prefix, ctx, ctxlen, sk))
+    return -1;
+
+  return crypto_sign_signature_prefix_ws(sig, siglen, m, mlen, &prefix, sk, ws);
+}
+
+/*************************************************
+* Name:        crypto_sign_signature
+*
+* Description: Computes signature using a workspace on the stack.
+*
+* Arguments:   - uint8_t *sig:   pointer to output signature (of length CRYPTO_BYTES)
+*              - size_t *siglen: pointer to output length of signature
+*              - uint8_t *m:     pointer to message to be signed
+*              - size_t mlen:    length of message
+*              - uint8_t *ctx:   pointer to context string
+*              - size_t ctxlen:  length of context string
+*              - uint8_t *sk:    pointer to bit-packed secret key
+*
+* Returns 0 (success) or -1 (context string too long)
+**************************************************/
+int crypto_sign_signature(uint8_t *sig,
+                          size_t *siglen,
+                          const uint8_t *m,
+                          size_t mlen,
+                          const uint8_t *ctx,
+                          size_t ctxlen,
+                          const uint8_t *sk)
+{
+  dilithium_workspace ws;
+
+  return crypto_sign_signature_ws(sig, siglen, m, mlen, ctx, ctxlen, sk, &ws);
+}
+
 /*************************************************
 * Name:        crypto_sign
 *
@@ -230,85 +389,75 @@ int crypto_sign(uint8_t *sm,
 }
 
 /*************************************************
-* Name:        crypto_sign_verify
+* Name:        crypto_sign_verify_prefix_ws
 *
-* Description: Verifies signature.
+* Description: Verifies signature with a precomputed mu prefix. All
+*              polynomial vectors live in the caller-provided workspace.
 *
 * Arguments:   - uint8_t *m: pointer to input signature
 *              - size_t siglen: length of signature
 *              - const uint8_t *m: pointer to message
 *              - size_t mlen: length of message
-*              - const uint8_t *ctx: pointer to context string
-*              - size_t ctxlen: length of context string
+*              - const dilithium_mu_prefix *prefix: prefix state from
+*                                crypto_sign_prefix_pk for the same pk
 *              - const uint8_t *pk: pointer to bit-packed public key
+*              - dilithium_workspace *ws: pointer to scratch workspace
 *
 * Returns 0 if signature could be verified correctly and -1 otherwise
 **************************************************/
-int crypto_sign_verify(const uint8_t *sig,
-                       size_t siglen,
-                       const uint8_t *m,
-                       size_t mlen,
-                       const uint8_t *ctx,
-                       size_t ctxlen,
-                       const uint8_t *pk)
+int crypto_sign_verify_prefix_ws(const uint8_t *sig,
+                                 size_t siglen,
+                                 const uint8_t *m,
+                                 size_t mlen,
+                                 const dilithium_mu_prefix *prefix,
+                                 const uint8_t *pk,
+                                 dilithium_workspace *ws)
 {
   unsigned int i;
-  uint8_t buf[K*POLYW1_PACKEDBYTES];
   uint8_t rho[SEEDBYTES];
   uint8_t mu[CRHBYTES];
   uint8_t c[CTILDEBYTES];
   uint8_t c2[CTILDEBYTES];
   poly cp;
-  polyvecl mat[K], z;
-  polyveck t1, w1, h;
+  sparse_hint h;
   keccak_state state;
 
-  if(ctxlen > 255 || siglen != CRYPTO_BYTES)
+  if(siglen != CRYPTO_BYTES)
     return -1;
 
-  unpack_pk(rho, &t1, pk);
-  if(unpack_sig(c, &z, &h, sig))
+  unpack_pk(rho, &ws->t1, pk);
+  if(unpack_sig_sparse(c, &ws->z, &h, sig))
     return -1;
-  if(polyvecl_chknorm(&z, GAMMA1 - BETA))
+  if(polyvecl_chknorm(&ws->z, GAMMA1 - BETA))
     return -1;
 
-  /* Compute CRH(H(rho, t1), msg) */
-  shake256(mu, TRBYTES, pk, CRYPTO_PUBLICKEYBYTES);
-  shake256_init(&state);
-  shake256_absorb(&state, mu, TRBYTES);
-  mu[0] = 0;
-  mu[1] = ctxlen;
-  shake256_absorb(&state, mu, 2);
-  shake256_absorb(&state, ctx, ctxlen);
+  /* Compute CRH(H(rho, t1), 0, ctxlen, ctx, msg) */
+  shake256_clone(&state, &prefix->state);
   shake256_absorb(&state, m, mlen);
   shake256_finalize(&state);
   shake256_squeeze(mu, CRHBYTES, &state);
 
   /* Matrix-vector multiplication; compute Az - c2^dt1 */
   poly_challenge(&cp, c);
-  polyvec_matrix_expand(mat, rho);
+  polyvec_matrix_expand(ws->mat, rho);
 
-  polyvecl_ntt(&z);
-  polyvec_matrix_pointwise_montgomery(&w1, mat, &z);
+  polyvecl_ntt(&ws->z);
+  polyvec_matrix_pointwise_montgomery(&ws->w1, ws->mat, &ws->z);
 
   poly_ntt(&cp);
-  polyveck_shiftl(&t1);
-  polyveck_ntt(&t1);
-  polyveck_pointwise_poly_montgomery(&t1, &cp, &t1);
-
-  polyveck_sub(&w1, &w1, &t1);
-  polyveck_reduce(&w1);
-  polyveck_invntt_tomont(&w1);
+  polyveck_shiftl(&ws->t1);
+  polyveck_ntt(&ws->t1);
+  polyveck_pointwise_poly_montgomery(&ws->t1, &cp, &ws->t1);
 
-  /* Reconstruct w1 */
-  polyveck_caddq(&w1);
-  polyveck_use_hint(&w1, &w1, &h);
-  polyveck_pack_w1(buf, &w1);
+  polyveck_sub(&ws->w1, &ws->w1, &ws->t1);
+  polyveck_reduce(&ws->w1);
+  polyveck_invntt_tomont(&ws->w1);
 
-  /* Call random oracle and verify challenge */
+  /* Reconstruct w1 and call random oracle; each polynomial of w1 is
+   * packed and absorbed as soon as its hints are applied */
   shake256_init(&state);
   shake256_absorb(&state, mu, CRHBYTES);
-  shake256_absorb(&state, buf, K*POLYW1_PACKEDBYTES);
+  polyveck_use_hint_absorb_w1(&state, &ws->w1, &h);
   shake256_finalize(&state);
   shake256_squeeze(c2, CTILDEBYTES, &state);
   for(i = 0; i < CTILDEBYTES; ++i)
@@ -318,6 +467,68 @@ int crypto_sign_verify(const uint8_t *sig,
   return 0;
 }
 
+/*************************************************
+* Name:        crypto_sign_verify_ws
+*
+* Description: Verifies signature. All polynomial vectors live in the
+*              caller-provided workspace.
+*
+* Arguments:   - uint8_t *m: pointer to input signature
+*              - size_t siglen: length of signature
+*              - const uint8_t *m: pointer to message
+*              - size_t mlen: length of message
+*              - const uint8_t *ctx: pointer to context string
+*              - size_t ctxlen: length of context string
+*              - const uint8_t *pk: pointer to bit-packed public key
+*              - dilithium_workspace *ws: pointer to scratch workspace
+*
+* Returns 0 if signature could be verified correctly and -1 otherwise
+**************************************************/
+int crypto_sign_verify_ws(const uint8_t *sig,
+                          size_t siglen,
+                          const uint8_t *m,
+                          size_t mlen,
+                          const uint8_t *ctx,
+                          size_t ctxlen,
+                          const uint8_t *pk,
+                          dilithium_workspace *ws)
+{
+  dilithium_mu_prefix prefix;
+
+  if(crypto_sign_prefix_pk(&prefix, ctx, ctxlen, pk))
+    return -1;
+
+  return crypto_sign_verify_prefix_ws(sig, siglen, m, mlen, &prefix, pk, ws);
+}
+
+/*************************************************
+* Name:        crypto_sign_verify
+*
+* Description: Verifies signature using a workspace on the stack.
+*
+* Arguments:   - uint8_t *m: pointer to input signature
+*              - size_t siglen: length of signature
+*              - const uint8_t *m: pointer to message
+*              - size_t mlen: length of message
+*              - const uint8_t *ctx: pointer to context string
+*              - size_t ctxlen: length of context string
+*              - const uint8_t *pk: pointer to bit-packed public key
+*
+* Returns 0 if signature could be verified correctly and -1 otherwise
+**************************************************/
+int crypto_sign_verify(const uint8_t *sig,
+                       size_t siglen,
+                       const uint8_t *m,
+                       size_t mlen,
+                       const uint8_t *ctx,
+                       size_t ctxlen,
+                       const uint8_t *pk)
+{
+  dilithium_workspace ws;
+
+  return crypto_sign_verify_ws(sig, siglen, m, mlen, ctx, ctxlen, pk, &ws);
+}
+
 /*************************************************
 * Name:        crypto_sign_open
 *
@@ -6,16 +6,58 @@
 #include "params.h"
 #include "polyvec.h"
 #include "poly.h"
+#include "fips202.h"
+
+/* Scratch memory for key generation, signing and verification. Callers that
+ * cannot afford the large stack frames (e.g. small fiber stacks) allocate one
+ * per thread and pass it to the _ws functions; its contents are not needed
+ * between calls. */
+typedef struct {
+  polyvecl mat[K];
+  polyvecl s1, y, z;
+  polyveck t0, t1, s2, w1, w0, h;
+  poly ynext;
+} dilithium_workspace;
+
+/* SHAKE256 state after absorbing tr || 0 || ctxlen || ctx. Callers that sign
+ * or verify many messages under one key and context string compute it once
+ * with crypto_sign_prefix_sk/_pk and pass it to the _prefix_ws functions,
+ * which then only absorb the message to get mu. */
+typedef struct {
+  keccak_state state;
+} dilithium_mu_prefix;
 
 #define crypto_sign_keypair DILITHIUM_NAMESPACE(keypair)
 int crypto_sign_keypair(uint8_t *pk, uint8_t *sk);
 
+#define crypto_sign_keypair_ws DILITHIUM_NAMESPACE(keypair_ws)
+int crypto_sign_keypair_ws(uint8_t *pk, uint8_t *sk, dilithium_workspace *ws);
+
 #define crypto_sign_signature DILITHIUM_NAMESPACE(signature)
 int crypto_sign_signature(uint8_t *sig, size_t *siglen,
                           const uint8_t *m, size_t mlen,
                           const uint8_t *ctx, size_t ctxlen,
                           const uint8_t *sk);
 
+#define crypto_sign_signature_ws DILITHIUM_NAMESPACE(signature_ws)
+int crypto_sign_signature_ws(uint8_t *sig, size_t *siglen,
+                             const uint8_t *m, size_t mlen,
+                             const uint8_t *ctx, size_t ctxlen,
+                             const uint8_t *sk,
+                             dilithium_workspace *ws);
+
+#define crypto_sign_prefix_sk DILITHIUM_NAMESPACE(prefix_sk)
+int crypto_sign_prefix_sk(dilithium_mu_prefix *prefix,
+                          const uint8_t *ctx, size_t ctxlen,
+                          const uint8_t *sk);
+
+#define crypto_sign_signature_prefix_ws DILITHIUM_NAMESPACE(signature_prefix_ws)
+int crypto_sign_signature_prefix_ws(uint8_t *sig, size_t *siglen,
+                                    const uint8_t *m, size_t mlen,
+                                    const dilithium_mu_prefix *prefix,
+                                    const uint8_t *sk,
+                                    dilithium_workspace *ws);
+
 #define crypto_sign DILITHIUM_NAMESPACETOP
 int crypto_sign(uint8_t *sm, size_t *smlen,
                 const uint8_t *m, size_t mlen,
@@ -28,6 +70,25 @@ int crypto_sign_verify(const uint8_t *sig, size_t siglen,
                        const uint8_t *ctx, size_t ctxlen,
                        const uint8_t *pk);
 
+#define crypto_sign_verify_ws DILITHIUM_NAMESPACE(verify_ws)
+int crypto_sign_verify_ws(const uint8_t *sig, size_t siglen,
+                          const uint8_t *m, size_t mlen,
+                          const uint8_t *ctx, size_t ctxlen,
+                          const uint8_t *pk,
+                          dilithium_workspace *ws);
+
+#define crypto_sign_prefix_pk DILITHIUM_NAMESPACE(prefix_pk)
+int crypto_sign_prefix_pk(dilithium_mu_prefix *prefix,
+                          const uint8_t *ctx, size_t ctxlen,
+                          const uint8_t *pk);
+
+#define crypto_sign_verify_prefix_ws DILITHIUM_NAMESPACE(verify_prefix_ws)
+int crypto_sign_verify_prefix_ws(const uint8_t *sig, size_t siglen,
+                                 const uint8_t *m, size_t mlen,
+                                 const dilithium_mu_prefix *prefix,
+                                 const uint8_t *pk,
+                                 dilithium_workspace *ws);
+
 #define crypto_sign_open DILITHIUM_NAMESPACE(open)
 int crypto_sign_open(uint8_t *m, size_t *mlen,
                      const uint8_t *sm, size_t smlen,
@@ -0,0 +1,412 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <stdint.h>
+#include "params.h"
+#include "reduce.h"
+
+/* Camada vetorial portátil para coeficientes de 32 bits. Cada backend
+ * define o tipo vec32 (VEC32_LANES coeficientes), o tipo de máscara
+ * vec32_mask e as mesmas operações:
+ *
+ *   vec32_load/store/set1          carga, armazenamento e difusão
+ *   vec32_add/sub/mullo/and/xor    aritmética e lógica lane a lane
+ *   vec32_slli/srai                deslocamentos por constante
+ *   vec32_abs                      valor absoluto
+ *   vec32_montmul                  montgomery_reduce((int64_t)a*b) exato
+ *   vec32_mulhrs                   (2*a*b + 2^31) >> 32, parte alta
+ *                                  arredondada (vqrdmulh)
+ *   vec32_cmpgt, vec32_mask_or,
+ *   vec32_mask_any                 comparação e máscaras
+ *   vec32_mask_bits                um bit por lane, lane 0 no bit 0
+ *   vec32_compress_store           grava os lanes selecionados em ordem
+ *   vec32_load_u24                 candidatos de 24 bits da amostragem
+ *
+ * Os núcleos de poly_simd.c usam apenas essas operações, de modo que
+ * servem a NEON, AVX2, AVX-512, WebAssembly SIMD128 e à versão escalar
+ * (ARCH=generic). A NTT continua por ISA: as camadas pequenas dependem
+ * de permutações próprias de cada conjunto de instruções. */
+
+#if !defined(__AVX2__) && (defined(__ARM_NEON) || defined(__wasm_simd128__))
+// Tabelas das versões de 4 lanes: índices de bytes para a compactação
+// (255 zera o byte) e para montar os candidatos de 24 bits
+static const uint8_t vec32_compress_idx[16][16] = {
+  {255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255},
+  {  0,   1,   2,   3, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255},
+  {  4,   5,   6,   7, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255},
+  {  0,   1,   2,   3,   4,   5,   6,   7, 255, 255, 255, 255, 255, 255, 255, 255},
+  {  8,   9,  10,  11, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255},
+  {  0,   1,   2,   3,   8,   9,  10,  11, 255, 255, 255, 255, 255, 255, 255, 255},
+  {  4,   5,   6,   7,   8,   9,  10,  11, 255, 255, 255, 255, 255, 255, 255, 255},
+  {  0,   1,   2,   3,   4,   5,   6,   7,   8,   9,  10,  11, 255, 255, 255, 255},
+  { 12,  13,  14,  15, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255},
+  {  0,   1,   2,   3,  12,  13,  14,  15, 255, 255, 255, 255, 255, 255, 255, 255},
+  {  4,   5,   6,   7,  12,  13,  14,  15, 255, 255, 255, 255, 255, 255, 255, 255},
+  {  0,   1,   2,   3,   4,   5,   6,   7,  12,  13,  14,  15, 255, 255, 255, 255},
+  {  8,   9,  10,  11,  12,  13,  14,  15, 255, 255, 255, 255, 255, 255, 255, 255},
+  {  0,   1,   2,   3,   8,   9,  10,  11,  12,  13,  14,  15, 255, 255, 255, 255},
+  {  4,   5,   6,   7,   8,   9,  10,  11,  12,  13,  14,  15, 255, 255, 255, 255},
+  {  0,   1,   2,   3,   4,   5,   6,   7,   8,   9,  10,  11,  12,  13,  14,  15}
+};
+static const uint8_t vec32_u24_idx[16] = {0, 1, 2, 255, 3, 4, 5, 255, 6, 7, 8, 255, 9, 10, 11, 255};
+#endif
+
+#if defined(__AVX512F__)
+#include <immintrin.h>
+#include "reduce_avx512.h"
+
+#define VEC32_LANES 16
+// Lê 64 bytes para formar 16 candidatos (48 bytes)
+#define VEC32_U24_LOADBYTES 64
+
+typedef __m512i vec32;
+typedef __mmask16 vec32_mask;
+
+#define vec32_load(p) _mm512_loadu_si512((const void *)(p))
+#define vec32_store(p, a) _mm512_storeu_si512((void *)(p), a)
+#define vec32_set1(x) _mm512_set1_epi32(x)
+#define vec32_add(a, b) _mm512_add_epi32(a, b)
+#define vec32_sub(a, b) _mm512_sub_epi32(a, b)
+#define vec32_mullo(a, b) _mm512_mullo_epi32(a, b)
+#define vec32_and(a, b) _mm512_and_si512(a, b)
+#define vec32_xor(a, b) _mm512_xor_si512(a, b)
+#define vec32_slli(a, n) _mm512_slli_epi32(a, n)
+#define vec32_srai(a, n) _mm512_srai_epi32(a, n)
+#define vec32_abs(a) _mm512_abs_epi32(a)
+#define vec32_montmul(a, b) montgomery_mul_avx512(a, b)
+#define vec32_cmpgt(a, b) _mm512_cmpgt_epi32_mask(a, b)
+#define vec32_mask_or(m, n) ((vec32_mask)((m) | (n)))
+#define vec32_mask_any(m) ((m) != 0)
+#define vec32_mask_bits(m) ((unsigned int)(m))
+
+static inline vec32 vec32_mulhrs(vec32 a, vec32 b) {
+  // Produtos de 64 bits das lanes pares e ímpares; bits 31..62 de p + 2^30
+  const __m512i r = _mm512_set1_epi64(1 << 30);
+  __m512i p0 = _mm512_add_epi64(_mm512_mul_epi32(a, b), r);
+  __m512i p1 = _mm512_add_epi64(_mm512_mul_epi32(_mm512_srli_epi64(a, 32), _mm512_srli_epi64(b, 32)), r);
+
+  return _mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(p0, 31), _mm512_slli_epi64(p1, 1));
+}
+
+static inline unsigned int vec32_compress_store(int32_t *p, vec32 a, vec32_mask m) {
+  _mm512_mask_compressstoreu_epi32(p, m, a);
+  return (unsigned int)_mm_popcnt_u32(m);
+}
+
+static inline vec32 vec32_load_u24(const uint8_t *p) {
+  // Cada bloco de 128 bits recebe os seus 12 bytes; o shuffle monta os valores
+  const __m512i perm = _mm512_setr_epi32(0, 1, 2, 2, 3, 4, 5, 5, 6, 7, 8, 8, 9, 10, 11, 11);
+  const __m512i idx = _mm512_broadcast_i32x4(_mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1,
+                                                           6, 7, 8, -1, 9, 10, 11, -1));
+  __m512i d = _mm512_loadu_si512((const void *)p);
+
+  return _mm512_shuffle_epi8(_mm512_permutexvar_epi32(perm, d), idx);
+}
+
+#elif defined(__AVX2__)
+#include <immintrin.h>
+#include "reduce_avx2.h"
+
+#define VEC32_LANES 8
+// Lê 32 bytes para formar 8 candidatos (24 bytes)
+#define VEC32_U24_LOADBYTES 32
+
+typedef __m256i vec32;
+typedef __m256i vec32_mask;
+
+#define vec32_load(p) _mm256_loadu_si256((const __m256i *)(p))
+#define vec32_store(p, a) _mm256_storeu_si256((__m256i *)(p), a)
+#define vec32_set1(x) _mm256_set1_epi32(x)
+#define vec32_add(a, b) _mm256_add_epi32(a, b)
+#define vec32_sub(a, b) _mm256_sub_epi32(a, b)
+#define vec32_mullo(a, b) _mm256_mullo_epi32(a, b)
+#define vec32_and(a, b) _mm256_and_si256(a, b)
+#define vec32_xor(a, b) _mm256_xor_si256(a, b)
+#define vec32_slli(a, n) _mm256_slli_epi32(a, n)
+#define vec32_srai(a, n) _mm256_srai_epi32(a, n)
+#define vec32_abs(a) _mm256_abs_epi32(a)
+#define vec32_montmul(a, b) montgomery_mul_avx2(a, b)
+#define vec32_cmpgt(a, b) _mm256_cmpgt_epi32(a, b)
+#define vec32_mask_or(m, n) _mm256_or_si256(m, n)
+#define vec32_mask_any(m) (!_mm256_testz_si256(m, m))
+#define vec32_mask_bits(m) ((unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(m)))
+
+static inline vec32 vec32_mulhrs(vec32 a, vec32 b) {
+  // Produtos de 64 bits das lanes pares e ímpares; bits 31..62 de p + 2^30
+  const __m256i r = _mm256_set1_epi64x(1 << 30);
+  __m256i p0 = _mm256_add_epi64(_mm256_mul_epi32(a, b), r);
+  __m256i p1 = _mm256_add_epi64(_mm256_mul_epi32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32)), r);
+
+  return _mm256_blend_epi32(_mm256_srli_epi64(p0, 31), _mm256_slli_epi64(p1, 1), 0xAA);
+}
+
+static inline unsigned int vec32_compress_store(int32_t *p, vec32 a, vec32_mask m) {
+  uint32_t good = (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(m));
+  // pdep espalha a máscara em bytes, pext seleciona os índices dos aceitos
+  uint64_t spread = _pdep_u64(good, 0x0101010101010101ULL) * 0xFF;
+  __m256i sel = _mm256_cvtepu8_epi32(_mm_cvtsi64_si128((long long)_pext_u64(0x0706050403020100ULL, spread)));
+
+  _mm256_storeu_si256((__m256i *)p, _mm256_permutevar8x32_epi32(a, sel));
+  return (unsigned int)_mm_popcnt_u32(good);
+}
+
+static inline vec32 vec32_load_u24(const uint8_t *p) {
+  // Bytes 0..11 na metade baixa e 12..23 na alta (que começa no byte 8)
+  const __m256i idx = _mm256_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1,
+                                       4, 5, 6, -1, 7, 8, 9, -1, 10, 11, 12, -1, 13, 14, 15, -1);
+  __m256i d = _mm256_loadu_si256((const __m256i *)p);
+
+  return _mm256_shuffle_epi8(_mm256_permute4x64_epi64(d, 0x94), idx);
+}
+
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+
+#define VEC32_LANES 4
+// Lê 16 bytes para formar 4 candidatos (12 bytes)
+#define VEC32_U24_LOADBYTES 16
+
+typedef int32x4_t vec32;
+typedef uint32x4_t vec32_mask;
+
+#define vec32_load(p) vld1q_s32(p)
+#define vec32_store(p, a) vst1q_s32(p, a)
+#define vec32_set1(x) vdupq_n_s32(x)
+#define vec32_add(a, b) vaddq_s32(a, b)
+#define vec32_sub(a, b) vsubq_s32(a, b)
+#define vec32_mullo(a, b) vmulq_s32(a, b)
+#define vec32_and(a, b) vandq_s32(a, b)
+#define vec32_xor(a, b) veorq_s32(a, b)
+#define vec32_slli(a, n) vshlq_n_s32(a, n)
+#define vec32_srai(a, n) vshrq_n_s32(a, n)
+#define vec32_abs(a) vabsq_s32(a)
+#define vec32_mulhrs(a, b) vqrdmulhq_s32(a, b)
+#define vec32_cmpgt(a, b) vcgtq_s32(a, b)
+#define vec32_mask_or(m, n) vorrq_u32(m, n)
+#define vec32_mask_any(m) (vmaxvq_u32(m) != 0)
+#define vec32_mask_bits(m) vaddvq_u32(vandq_u32(m, vld1q_u32(vec32_lane_bit)))
+
+static const uint32_t vec32_lane_bit[4] = {1, 2, 4, 8};
+
+static inline vec32 vec32_montmul(vec32 a, vec32 b) {
+  // vqdmulh dá 2*a*b >> 32; como a*b e t*Q coincidem nos 32 bits baixos,
+  // a meia subtração devolve exatamente (a*b - t*Q) >> 32
+  int32x4_t hi = vqdmulhq_s32(a, b);
+  int32x4_t t = vmulq_s32(vmulq_s32(a, b), vdupq_n_s32(QINV));
+
+  return vhsubq_s32(hi, vqdmulhq_s32(t, vdupq_n_s32(Q)));
+}
+
+static inline unsigned int vec32_compress_store(int32_t *p, vec32 a, vec32_mask m) {
+  unsigned int bits = vec32_mask_bits(m);
+  uint8x16_t idx = vld1q_u8(vec32_compress_idx[bits]);
+
+  vst1q_s32(p, vreinterpretq_s32_u8(vqtbl1q_u8(vreinterpretq_u8_s32(a), idx)));
+  return vaddvq_u32(vshrq_n_u32(m, 31));
+}
+
+static inline vec32 vec32_load_u24(const uint8_t *p) {
+  // Índice 255 zera o byte alto de cada candidato
+  return vreinterpretq_s32_u8(vqtbl1q_u8(vld1q_u8(p), vld1q_u8(vec32_u24_idx)));
+}
+
+#elif defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+
+#define VEC32_LANES 4
+// Lê 16 bytes para formar 4 candidatos (12 bytes)
+#define VEC32_U24_LOADBYTES 16
+
+typedef v128_t vec32;
+typedef v128_t vec32_mask;
+
+#define vec32_load(p) wasm_v128_load(p)
+#define vec32_store(p, a) wasm_v128_store(p, a)
+#define vec32_set1(x) wasm_i32x4_splat(x)
+#define vec32_add(a, b) wasm_i32x4_add(a, b)
+#define vec32_sub(a, b) wasm_i32x4_sub(a, b)
+#define vec32_mullo(a, b) wasm_i32x4_mul(a, b)
+#define vec32_and(a, b) wasm_v128_and(a, b)
+#define vec32_xor(a, b) wasm_v128_xor(a, b)
+#define vec32_slli(a, n) wasm_i32x4_shl(a, n)
+#define vec32_srai(a, n) wasm_i32x4_shr(a, n)
+#define vec32_abs(a) wasm_i32x4_abs(a)
+#define vec32_cmpgt(a, b) wasm_i32x4_gt(a, b)
+#define vec32_mask_or(m, n) wasm_v128_or(m, n)
+#define vec32_mask_any(m) wasm_v128_any_true(m)
+#define vec32_mask_bits(m) ((unsigned int)wasm_i32x4_bitmask(m))
+
+static inline vec32 vec32_montmul(vec32 a, vec32 b) {
+  const v128_t q = wasm_i32x4_splat(Q);
+  // Produtos de 64 bits das lanes 0,1 e 2,3; t = (int32_t)(a*b) * QINV
+  v128_t p0 = wasm_i64x2_extmul_low_i32x4(a, b);
+  v128_t p1 = wasm_i64x2_extmul_high_i32x4(a, b);
+  v128_t t = wasm_i32x4_mul(wasm_i32x4_mul(a, b), wasm_i32x4_splat(QINV));
+
+  // (p - t*Q) >> 32: as metades altas das quatro lanes de 64 bits
+  p0 = wasm_i64x2_sub(p0, wasm_i64x2_extmul_low_i32x4(t, q));
+  p1 = wasm_i64x2_sub(p1, wasm_i64x2_extmul_high_i32x4(t, q));
+  return wasm_i32x4_shuffle(p0, p1, 1, 3, 5, 7);
+}
+
+static inline vec32 vec32_mulhrs(vec32 a, vec32 b) {
+  // Bits 31..62 de a*b + 2^30: deslocamento de 31 e as metades baixas
+  const v128_t r = wasm_i64x2_splat(1 << 30);
+  v128_t p0 = wasm_u64x2_shr(wasm_i64x2_add(wasm_i64x2_extmul_low_i32x4(a, b), r), 31);
+  v128_t p1 = wasm_u64x2_shr(wasm_i64x2_add(wasm_i64x2_extmul_high_i32x4(a, b), r), 31);
+
+  return wasm_i32x4_shuffle(p0, p1, 0, 2, 4, 6);
+}
+
+static inline unsigned int vec32_compress_store(int32_t *p, vec32 a, vec32_mask m) {
+  unsigned int bits = vec32_mask_bits(m);
+
+  wasm_v128_store(p, wasm_i8x16_swizzle(a, wasm_v128_load(vec32_compress_idx[bits])));
+  return (unsigned int)__builtin_popcount(bits);
+}
+
+static inline vec32 vec32_load_u24(const uint8_t *p) {
+  // Índices >= 16 zeram o byte alto de cada candidato
+  return wasm_i8x16_swizzle(wasm_v128_load(p), wasm_v128_load(vec32_u24_idx));
+}
+
+#else
+
+#define VEC32_LANES 8
+#define VEC32_U24_LOADBYTES (3*VEC32_LANES)
+
+// Versão escalar: laços de tamanho fixo que o compilador pode vetorizar
+typedef struct {
+  int32_t v[VEC32_LANES];
+} vec32;
+typedef uint32_t vec32_mask;
+
+static inline vec32 vec32_load(const int32_t *p) {
+  vec32 r;
+  for (unsigned int i = 0; i < VEC32_LANES; ++i) r.v[i] = p[i];
+  return r;
+}
+
+static inline void vec32_store(int32_t *p, vec32 a) {
+  for (unsigned int i = 0; i < VEC32_LANES; ++i) p[i] = a.v[i];
+}
+
+static inline vec32 vec32_set1(int32_t x) {
+  vec32 r;
+  for (unsigned int i = 0; i < VEC32_LANES; ++i) r.v[i] = x;
+  return r;
+}
+
+static inline vec32 vec32_add(vec32 a, vec32 b) {
+  for (unsigned int i = 0; i < VEC32_LANES; ++i) a.v[i] = (int32_t)((uint32_t)a.v[i] + (uint32_t)b.v[i]);
+  return a;
+}
+
+static inline vec32 vec32_sub(vec32 a, vec32 b) {
+  for (unsigned int i = 0; i < VEC32_LANES; ++i) a.v[i] = (int32_t)((uint32_t)a.v[i] - (uint32_t)b.v[i]);
+  return a;
+}
+
+static inline vec32 vec32_mullo(vec32 a, vec32 b) {
+  for (unsigned int i = 0; i < VEC32_LANES; ++i) a.v[i] = (int32_t)((uint32_t)a.v[i] * (uint32_t)b.v[i]);
+  return a;
+}
+
+static inline vec32 vec32_and(vec32 a, vec32 b) {
+  for (unsigned int i = 0; i < VEC32_LANES; ++i) a.v[i] &= b.v[i];
+  return a;
+}
+
+static inline vec32 vec32_xor(vec32 a, vec32 b) {
+  for (unsigned int i = 0; i < VEC32_LANES; ++i) a.v[i] ^= b.v[i];
+  return a;
+}
+
+static inline vec32 vec32_slli(vec32 a, unsigned int n) {
+  for (unsigned int i = 0; i < VEC32_LANES; ++i) a.v[i] = (int32_t)((uint32_t)a.v[i] << n);
+  return a;
+}
+
+static inline vec32 vec32_srai(vec32 a, unsigned int n) {
+  for (unsigned int i = 0; i < VEC32_LANES; ++i) a.v[i] >>= n;
+  return a;
+}
+
+static inline vec32 vec32_abs(vec32 a) {
+  for (unsigned int i = 0; i < VEC32_LANES; ++i) a.v[i] = a.v[i] < 0 ? -a.v[i] : a.v[i];
+  return a;
+}
+
+static inline vec32 vec32_montmul(vec32 a, vec32 b) {
+  int64_t p;
+  int32_t t;
+
+  for (unsigned int i = 0; i < VEC32_LANES; ++i) {
+    p = (int64_t)a.v[i]*b.v[i];
+    t = (int64_t)(int32_t)p*QINV;
+    a.v[i] = (p - (int64_t)t*Q) >> 32;
+  }
+  return a;
+}
+
+static inline vec32 vec32_mulhrs(vec32 a, vec32 b) {
+  for (unsigned int i = 0; i < VEC32_LANES; ++i)
+    a.v[i] = (int32_t)(((int64_t)a.v[i]*b.v[i] + (1 << 30)) >> 31);
+  return a;
+}
+
+static inline vec32_mask vec32_cmpgt(vec32 a, vec32 b) {
+  vec32_mask m = 0;
+  for (unsigned int i = 0; i < VEC32_LANES; ++i) m |= (vec32_mask)(a.v[i] > b.v[i]) << i;
+  return m;
+}
+
+#define vec32_mask_or(m, n) ((m) | (n))
+#define vec32_mask_any(m) ((m) != 0)
+#define vec32_mask_bits(m) ((unsigned int)(m))
+
+static inline unsigned int vec32_compress_store(int32_t *p, vec32 a, vec32_mask m) {
+  unsigned int ctr = 0;
+  for (unsigned int i = 0; i < VEC32_LANES; ++i)
+    if ((m >> i) & 1)
+      p[ctr++] = a.v[i];
+  return ctr;
+}
+
+static inline vec32 vec32_load_u24(const uint8_t *p) {
+  vec32 r;
+  for (unsigned int i = 0; i < VEC32_LANES; ++i)
+    r.v[i] = p[3*i] | (int32_t)p[3*i + 1] << 8 | (int32_t)p[3*i + 2] << 16;
+  return r;
+}
+
+#endif
+
+/*************************************************
+* Name:        vec32_reduce32
+*
+* Description: reduce32 on VEC32_LANES coefficients.
+*
+* Arguments:   - vec32 a: coefficients with a <= 2^{31} - 2^{22} - 1
+*
+* Returns r \equiv a (mod Q) with -6283008 <= r <= 6283008.
+**************************************************/
+static inline vec32 vec32_reduce32(vec32 a) {
+  vec32 t = vec32_srai(vec32_add(a, vec32_set1(1 << 22)), 23);
+  return vec32_sub(a, vec32_mullo(t, vec32_set1(Q)));
+}
+
+/*************************************************
+* Name:        vec32_caddq
+*
+* Description: caddq on VEC32_LANES coefficients: add Q where negative.
+*
+* Arguments:   - vec32 a: coefficients
+*
+* Returns a + Q where a < 0, a elsewhere.
+**************************************************/
+static inline vec32 vec32_caddq(vec32 a) {
+  return vec32_add(a, vec32_and(vec32_srai(a, 31), vec32_set1(Q)));
+}
+
+#endif
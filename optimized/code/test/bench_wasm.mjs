@@ -0,0 +1,72 @@
+// Benchmark do módulo WebAssembly (make ARCH=wasm wasm) no node (>= 20):
+//
+//   node test/bench_wasm.mjs dilithium3.wasm [NTESTS]
+//
+// Gera um par de chaves, assina uma mensagem de 59 bytes e mede a vazão da
+// verificação com e sem o prefixo de mu pré-computado (mldsa_verify_init).
+import { readFile } from 'node:fs/promises';
+import { WASI } from 'node:wasi';
+import { randomFillSync } from 'node:crypto';
+import { argv, exit } from 'node:process';
+
+const path = argv[2] ?? 'dilithium3.wasm';
+const NTESTS = Number(argv[3] ?? 1000);
+const MLEN = 59;
+
+const wasi = new WASI({ version: 'preview1', args: [], env: {} });
+const module = await WebAssembly.compile(await readFile(path));
+const instance = await WebAssembly.instantiate(module, wasi.getImportObject());
+wasi.initialize(instance);
+const m = instance.exports;
+
+const pklen = m.mldsa_publickeybytes();
+const sklen = m.mldsa_secretkeybytes();
+const siglen = m.mldsa_signaturebytes();
+const pk = m.mldsa_alloc(pklen);
+const sk = m.mldsa_alloc(sklen);
+const sig = m.mldsa_alloc(siglen);
+const msg = m.mldsa_alloc(MLEN);
+
+// A memória pode crescer em mldsa_alloc: a visão é refeita a cada uso
+const bytes = () => new Uint8Array(m.memory.buffer);
+
+randomFillSync(bytes(), msg, MLEN);
+if (m.mldsa_keypair(pk, sk) !== 0) {
+  console.error('ERROR: keypair');
+  exit(1);
+}
+const len = m.mldsa_sign(sig, msg, MLEN, 0, 0, sk);
+if (len !== siglen) {
+  console.error('ERROR: sign');
+  exit(1);
+}
+if (m.mldsa_verify(sig, len, msg, MLEN, 0, 0, pk) !== 0) {
+  console.error('ERROR: verify');
+  exit(1);
+}
+bytes()[sig + 17] ^= 1;
+if (m.mldsa_verify(sig, len, msg, MLEN, 0, 0, pk) === 0) {
+  console.error('ERROR: forged signature accepted');
+  exit(1);
+}
+bytes()[sig + 17] ^= 1;
+
+function bench(name, fn) {
+  const t0 = process.hrtime.bigint();
+  for (let i = 0; i < NTESTS; ++i)
+    fn();
+  const ns = Number(process.hrtime.bigint() - t0) / NTESTS;
+  console.log(`${name.padEnd(18)} ${(ns / 1000).toFixed(1).padStart(9)} us  ${(1e9 / ns).toFixed(0).padStart(7)} op/s`);
+}
+
+console.log(`${path}: pk ${pklen} bytes, sig ${siglen} bytes, ${NTESTS} runs`);
+bench('keypair', () => m.mldsa_keypair(pk, sk));
+bench('sign', () => m.mldsa_sign(sig, msg, MLEN, 0, 0, sk));
+bench('verify', () => m.mldsa_verify(sig, len, msg, MLEN, 0, 0, pk));
+m.mldsa_verify_init(0, 0, pk);
+bench('verify (prefix)', () => m.mldsa_verify_prefixed(sig, len, msg, MLEN, pk));
+
+m.mldsa_free(msg);
+m.mldsa_free(sig);
+m.mldsa_free(sk);
+m.mldsa_free(pk);
@@ -2,6 +2,9 @@
 #define CPUCYCLES_H
 
 #include <stdint.h>
+#if defined(__wasm__)
+#include <time.h>
+#endif
 
 #ifdef USE_RDPMC  /* Needs echo 2 > /sys/devices/cpu/rdpmc */
 
@@ -19,11 +22,21 @@ static inline uint64_t cpucycles(void) {
 
 static inline uint64_t cpucycles(void) {
   uint64_t result;
-/*
+
+#if defined(__x86_64__)
   __asm__ volatile ("rdtsc; shlq $32,%%rdx; orq %%rdx,%%rax"
     : "=a" (result) : : "%rdx");
-*/
+#elif defined(__wasm__)
+  /* Sem contador de ciclos em WebAssembly: nanossegundos do runtime */
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  result = (uint64_t)ts.tv_sec*1000000000ULL + (uint64_t)ts.tv_nsec;
+#elif defined(__riscv)
+  __asm__ volatile ("rdtime %0" : "=r" (result));
+#else
     asm volatile("mrs %0, cntvct_el0" : "=r" (result));
+#endif
 
   return result;
 }
@@ -8,11 +8,13 @@
 #define CTXLEN 14
 #define NTESTS 10000
 
+static dilithium_workspace ws;
+
 int main(void)
 {
   size_t i, j;
   int ret;
-  size_t mlen, smlen;
+  size_t mlen, smlen, siglen;
   uint8_t b;
   uint8_t ctx[CTXLEN] = {0};
   uint8_t m[MLEN + CRYPTO_BYTES];
@@ -49,6 +51,36 @@ int main(void)
       }
     }
 
+    /* Variantes com workspace, com chaves e buffers próprios para não
+     * alterar sm, pk e sk usados no teste de falsificação abaixo */
+    {
+      uint8_t sig_ws[CRYPTO_BYTES];
+      uint8_t pk_ws[CRYPTO_PUBLICKEYBYTES];
+      uint8_t sk_ws[CRYPTO_SECRETKEYBYTES];
+      dilithium_mu_prefix skprefix, pkprefix;
+
+      crypto_sign_keypair_ws(pk_ws, sk_ws, &ws);
+      crypto_sign_signature_ws(sig_ws, &siglen, m, MLEN, ctx, CTXLEN, sk_ws, &ws);
+      ret = crypto_sign_verify_ws(sig_ws, siglen, m, MLEN, ctx, CTXLEN, pk_ws, &ws);
+      if(ret) {
+        fprintf(stderr, "Verification with workspace failed\n");
+        return -1;
+      }
+
+      /* Prefixos reutilizados para duas mensagens diferentes */
+      crypto_sign_prefix_sk(&skprefix, ctx, CTXLEN, sk_ws);
+      crypto_sign_prefix_pk(&pkprefix, ctx, CTXLEN, pk_ws);
+      crypto_sign_signature_prefix_ws(sig_ws, &siglen, m, MLEN, &skprefix, sk_ws, &ws);
+      ret = crypto_sign_verify(sig_ws, siglen, m, MLEN, ctx, CTXLEN, pk_ws);
+      ret |= crypto_sign_verify_prefix_ws(sig_ws, siglen, m, MLEN, &pkprefix, pk_ws, &ws);
+      crypto_sign_signature(sig_ws, &siglen, m, MLEN - 1, ctx, CTXLEN, sk_ws);
+      ret |= crypto_sign_verify_prefix_ws(sig_ws, siglen, m, MLEN - 1, &pkprefix, pk_ws, &ws);
+      if(ret) {
+        fprintf(stderr, "Verification with cached prefix failed\n");
+        return -1;
+      }
+    }
+
     randombytes((uint8_t *)&j, sizeof(j));
     do {
       randombytes(&b, 1);
@@ -0,0 +1,155 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "../randombytes.h"
+
+#if !defined(DILITHIUM_DRBG_SHAKE256)
+#error "test_drbg must be built with -DDILITHIUM_DRBG_SHAKE256"
+#endif
+
+#ifndef DRBG_RESEED_INTERVAL
+#define DRBG_RESEED_INTERVAL (1UL << 20)
+#endif
+
+#define OUTBYTES 64
+#define NTHREADS 4
+#define NINTERVALS 3
+#define CHUNK 1000
+
+static uint8_t thread_out[NTHREADS][OUTBYTES];
+static uint8_t big_out[NINTERVALS*DRBG_RESEED_INTERVAL];
+
+static void *thread_main(void *arg) {
+  randombytes((uint8_t *)arg, OUTBYTES);
+  return NULL;
+}
+
+/*************************************************
+* Name:        check_fork
+*
+* Description: Parent and child must not continue the same DRBG stream
+*              after fork(); the parent seeds its state before forking.
+*
+* Returns 1 if the outputs match or the child fails; otherwise 0.
+**************************************************/
+static int check_fork(void) {
+  int fd[2], status;
+  pid_t pid;
+  uint8_t parent[OUTBYTES], child[OUTBYTES];
+
+  randombytes(parent, OUTBYTES);
+  if(pipe(fd))
+    return 1;
+
+  pid = fork();
+  if(pid < 0)
+    return 1;
+  if(pid == 0) {
+    randombytes(child, OUTBYTES);
+    if(write(fd[1], child, OUTBYTES) != OUTBYTES)
+      _exit(1);
+    _exit(0);
+  }
+
+  close(fd[1]);
+  randombytes(parent, OUTBYTES);
+  if(read(fd[0], child, OUTBYTES) != OUTBYTES)
+    return 1;
+  close(fd[0]);
+  if(waitpid(pid, &status, 0) != pid || !WIFEXITED(status) || WEXITSTATUS(status))
+    return 1;
+
+  if(!memcmp(parent, child, OUTBYTES)) {
+    fprintf(stderr, "ERROR: parent and child share DRBG output after fork\n");
+    return 1;
+  }
+  return 0;
+}
+
+/*************************************************
+* Name:        check_threads
+*
+* Description: Every thread keeps its own DRBG state, so no two threads
+*              (nor the main thread) may produce the same output.
+*
+* Returns 1 if two outputs match; otherwise 0.
+**************************************************/
+static int check_threads(void) {
+  unsigned int i, j;
+  pthread_t th[NTHREADS];
+  uint8_t main_out[OUTBYTES];
+
+  randombytes(main_out, OUTBYTES);
+  for(i = 0; i < NTHREADS; ++i)
+    if(pthread_create(&th[i], NULL, thread_main, thread_out[i]))
+      return 1;
+  for(i = 0; i < NTHREADS; ++i)
+    pthread_join(th[i], NULL);
+
+  for(i = 0; i < NTHREADS; ++i) {
+    if(!memcmp(thread_out[i], main_out, OUTBYTES)) {
+      fprintf(stderr, "ERROR: thread %u repeats the main thread output\n", i);
+      return 1;
+    }
+    for(j = 0; j < i; ++j)
+      if(!memcmp(thread_out[i], thread_out[j], OUTBYTES)) {
+        fprintf(stderr, "ERROR: threads %u and %u share DRBG output\n", j, i);
+        return 1;
+      }
+  }
+  return 0;
+}
+
+/*************************************************
+* Name:        check_reseed
+*
+* Description: Draws NINTERVALS reseed intervals in odd-sized requests, then
+*              once more in a single request, and checks that the stream
+*              keeps going: no CHUNK of output may be all zero or repeat
+*              the previous one.
+*
+* Returns 1 on a degenerate request; otherwise 0.
+**************************************************/
+static int check_reseed(void) {
+  unsigned int i;
+  unsigned long total;
+  uint8_t prev[CHUNK], cur[CHUNK], zero[CHUNK] = {0};
+
+  randombytes(prev, CHUNK);
+  for(total = CHUNK; total < NINTERVALS*DRBG_RESEED_INTERVAL + CHUNK; total += CHUNK) {
+    randombytes(cur, CHUNK);
+    if(!memcmp(cur, prev, CHUNK) || !memcmp(cur, zero, CHUNK)) {
+      fprintf(stderr, "ERROR: degenerate DRBG output after %lu bytes\n", total);
+      return 1;
+    }
+    for(i = 0; i < CHUNK; ++i)
+      prev[i] = cur[i];
+  }
+
+  randombytes(big_out, sizeof(big_out));
+  for(total = CHUNK; total + CHUNK <= sizeof(big_out); total += CHUNK) {
+    if(!memcmp(big_out + total, big_out + total - CHUNK, CHUNK)
+       || !memcmp(big_out + total, zero, CHUNK)) {
+      fprintf(stderr, "ERROR: degenerate DRBG output at byte %lu of one request\n", total);
+      return 1;
+    }
+  }
+  return 0;
+}
+
+int main(void)
+{
+  if(check_fork())
+    return -1;
+  if(check_threads())
+    return -1;
+  if(check_reseed())
+    return -1;
+
+  printf("DRBG: fork, threads and %lu bytes past %d reseeds ok\n",
+         (unsigned long)NINTERVALS*DRBG_RESEED_INTERVAL, NINTERVALS);
+  return 0;
+}
@@ -0,0 +1,254 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "../fips202.h"
+#if defined(__ARM_NEON) || defined(__wasm_simd128__)
+#include "../fips202x2.h"
+#endif
+#if defined(__ARM_NEON)
+#include "../fips202x3.h"
+#endif
+#if defined(__AVX2__) || defined(__riscv_vector)
+#include "../fips202x4.h"
+#endif
+#if defined(__AVX512F__)
+#include "../fips202x8.h"
+#endif
+#include "../cpu.h"
+#include "cpucycles.h"
+#include "speed_print.h"
+
+#define NTESTS 10000
+#define BIGLEN 16384
+
+uint64_t t[NTESTS];
+static uint8_t big[BIGLEN];
+
+/* FIPS 202 known answers: first 32 output bytes for the empty message and
+ * for 200 bytes of 0xa3 */
+static const uint8_t kat_shake128[2][32] = {
+  {0x7f,0x9c,0x2b,0xa4,0xe8,0x8f,0x82,0x7d,0x61,0x60,0x45,0x50,0x76,0x05,0x85,0x3e,
+   0xd7,0x3b,0x80,0x93,0xf6,0xef,0xbc,0x88,0xeb,0x1a,0x6e,0xac,0xfa,0x66,0xef,0x26},
+  {0x13,0x1a,0xb8,0xd2,0xb5,0x94,0x94,0x6b,0x9c,0x81,0x33,0x3f,0x9b,0xb6,0xe0,0xce,
+   0x75,0xc3,0xb9,0x31,0x04,0xfa,0x34,0x69,0xd3,0x91,0x74,0x57,0x38,0x5d,0xa0,0x37}
+};
+static const uint8_t kat_shake256[2][32] = {
+  {0x46,0xb9,0xdd,0x2b,0x0b,0xa8,0x8d,0x13,0x23,0x3b,0x3f,0xeb,0x74,0x3e,0xeb,0x24,
+   0x3f,0xcd,0x52,0xea,0x62,0xb8,0x1b,0x82,0xb5,0x0c,0x27,0x64,0x6e,0xd5,0x76,0x2f},
+  {0xcd,0x8a,0x92,0x0e,0xd1,0x41,0xaa,0x04,0x07,0xa2,0x2d,0x59,0x28,0x86,0x52,0xe9,
+   0xd9,0xf1,0xa7,0xee,0x0c,0x1e,0x7c,0x1c,0xa6,0x99,0x42,0x4d,0xa8,0x4a,0x90,0x4d}
+};
+
+int main(void)
+{
+  unsigned int i, j, k;
+  size_t pos;
+  int fail = 0;
+  uint8_t in[8][512];
+  uint8_t out[9][512];
+  keccak_state state;
+#if defined(__ARM_NEON) || defined(__wasm_simd128__)
+  keccakx2_state statex2;
+#endif
+#if defined(__ARM_NEON)
+  keccakx3_state statex3;
+#endif
+#if defined(__AVX2__) || defined(__riscv_vector)
+  keccakx4_state statex4;
+#endif
+#if defined(__AVX512F__)
+  keccakx8_state statex8;
+  const uint8_t *inx8[8];
+  uint8_t *outx8[8];
+#endif
+
+#if defined(__APPLE__) && (defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_SHA3))
+  printf("Keccak: SHA3 extension (feat.S)\n");
+#elif defined(__ARM_FEATURE_SHA3)
+  printf("Keccak: SHA3 extension (feat_sha3.c)\n");
+#elif defined(KECCAK_SHA3_DISPATCH)
+  if(dilithium_cpu_features() & CPU_FEATURE_SHA3)
+    printf("Keccak: SHA3 extension (feat_sha3.c, runtime dispatch)\n");
+  else
+    printf("Keccak: generic NEON/scalar (runtime dispatch)\n");
+#elif defined(__AVX512F__)
+  printf("Keccak: scalar, AVX2 x4, AVX-512 x8\n");
+#elif defined(__AVX2__)
+  printf("Keccak: scalar, AVX2 x4\n");
+#elif defined(__riscv_vector)
+  printf("Keccak: scalar, RVV x4\n");
+#elif defined(__wasm_simd128__)
+  printf("Keccak: scalar, WebAssembly SIMD128 x2\n");
+#else
+  printf("Keccak: generic NEON/scalar\n");
+#endif
+
+  /* Known answers */
+  memset(in[0], 0xa3, 200);
+  for(i = 0; i < 2; ++i) {
+    shake128(out[0], 32, in[0], i ? 200 : 0);
+    shake256(out[1], 32, in[0], i ? 200 : 0);
+    if(memcmp(out[0], kat_shake128[i], 32) || memcmp(out[1], kat_shake256[i], 32)) {
+      fprintf(stderr, "ERROR in SHAKE known answer %u\n", i);
+      fail = 1;
+    }
+  }
+
+  /* Incremental absorb in chunks of every size must match one-shot */
+  for(i = 0; i < BIGLEN; ++i)
+    big[i] = (uint8_t)(13*i + 5);
+  shake256(out[0], 64, big, 4000);
+  for(k = 1; k <= 300; ++k) {
+    shake256_init(&state);
+    for(pos = 0; pos + k <= 4000; pos += k)
+      shake256_absorb(&state, big + pos, k);
+    shake256_absorb(&state, big + pos, 4000 - pos);
+    shake256_finalize(&state);
+    shake256_squeeze(out[1], 64, &state);
+    if(memcmp(out[0], out[1], 64)) {
+      fprintf(stderr, "ERROR in incremental shake256_absorb, chunk %u\n", k);
+      fail = 1;
+    }
+  }
+
+  /* Every lane of the x2, x3, x4 and x8 versions must match the single-lane one */
+  for(i = 0; i < 512; ++i)
+    for(k = 0; k < 8; ++k)
+      in[k][i] = (uint8_t)(7*i + 31*k + 1);
+
+  for(i = 0; i <= 400; i += 7) {
+#if defined(__ARM_NEON) || defined(__wasm_simd128__)
+    FIPS202X2_NAMESPACE(shake128x2)(out[0], out[1], 500, in[0], in[1], i);
+    for(k = 0; k < 2; ++k) {
+      shake128(out[3], 500, in[k], i);
+      if(memcmp(out[k], out[3], 500)) {
+        fprintf(stderr, "ERROR in shake128x2 lane %u, inlen %u\n", k, i);
+        fail = 1;
+      }
+    }
+    FIPS202X2_NAMESPACE(shake256x2)(out[0], out[1], 500, in[0], in[1], i);
+    for(k = 0; k < 2; ++k) {
+      shake256(out[3], 500, in[k], i);
+      if(memcmp(out[k], out[3], 500)) {
+        fprintf(stderr, "ERROR in shake256x2 lane %u, inlen %u\n", k, i);
+        fail = 1;
+      }
+    }
+#endif
+#if defined(__ARM_NEON)
+    FIPS202X3_NAMESPACE(shake128x3)(out[0], out[1], out[2], 500, in[0], in[1], in[2], i);
+    for(k = 0; k < 3; ++k) {
+      shake128(out[3], 500, in[k], i);
+      if(memcmp(out[k], out[3], 500)) {
+        fprintf(stderr, "ERROR in shake128x3 lane %u, inlen %u\n", k, i);
+        fail = 1;
+      }
+    }
+    FIPS202X3_NAMESPACE(shake256x3)(out[0], out[1], out[2], 500, in[0], in[1], in[2], i);
+    for(k = 0; k < 3; ++k) {
+      shake256(out[3], 500, in[k], i);
+      if(memcmp(out[k], out[3], 500)) {
+        fprintf(stderr, "ERROR in shake256x3 lane %u, inlen %u\n", k, i);
+        fail = 1;
+      }
+    }
+#endif
+#if defined(__AVX2__) || defined(__riscv_vector)
+    FIPS202X4_NAMESPACE(shake128x4)(out[0], out[1], out[2], out[3], 500, in[0], in[1], in[2], in[3], i);
+    for(k = 0; k < 4; ++k) {
+      shake128(out[4], 500, in[k], i);
+      if(memcmp(out[k], out[4], 500)) {
+        fprintf(stderr, "ERROR in shake128x4 lane %u, inlen %u\n", k, i);
+        fail = 1;
+      }
+    }
+    FIPS202X4_NAMESPACE(shake256x4)(out[0], out[1], out[2], out[3], 500, in[0], in[1], in[2], in[3], i);
+    for(k = 0; k < 4; ++k) {
+      shake256(out[4], 500, in[k], i);
+      if(memcmp(out[k], out[4], 500)) {
+        fprintf(stderr, "ERROR in shake256x4 lane %u, inlen %u\n", k, i);
+        fail = 1;
+      }
+    }
+#endif
+#if defined(__AVX512F__)
+    for(k = 0; k < 8; ++k) {
+      inx8[k] = in[k];
+      outx8[k] = out[k];
+    }
+    FIPS202X8_NAMESPACE(shake128x8)(outx8, 500, inx8, i);
+    for(k = 0; k < 8; ++k) {
+      shake128(out[8], 500, in[k], i);
+      if(memcmp(out[k], out[8], 500)) {
+        fprintf(stderr, "ERROR in shake128x8 lane %u, inlen %u\n", k, i);
+        fail = 1;
+      }
+    }
+    FIPS202X8_NAMESPACE(shake256x8)(outx8, 500, inx8, i);
+    for(k = 0; k < 8; ++k) {
+      shake256(out[8], 500, in[k], i);
+      if(memcmp(out[k], out[8], 500)) {
+        fprintf(stderr, "ERROR in shake256x8 lane %u, inlen %u\n", k, i);
+        fail = 1;
+      }
+    }
+#endif
+  }
+
+  /* Cycles per squeezed block, i.e. per permutation call */
+  shake128_absorb_once(&state, in[0], 34);
+  for(j = 0; j < NTESTS; ++j) {
+    t[j] = cpucycles();
+    shake128_squeezeblocks(out[0], 1, &state);
+  }
+  print_results("KeccakF1600 (1 lane):", t, NTESTS);
+
+#if defined(__ARM_NEON) || defined(__wasm_simd128__)
+  FIPS202X2_NAMESPACE(shake128x2_absorb_once)(&statex2, in[0], in[1], 34);
+  for(j = 0; j < NTESTS; ++j) {
+    t[j] = cpucycles();
+    FIPS202X2_NAMESPACE(shake128x2_squeezeblocks)(out[0], out[1], 1, &statex2);
+  }
+  print_results("KeccakF1600x2 (2 lanes):", t, NTESTS);
+#endif
+
+#if defined(__ARM_NEON)
+  FIPS202X3_NAMESPACE(shake128x3_absorb)(&statex3, in[0], in[1], in[2], 34);
+  for(j = 0; j < NTESTS; ++j) {
+    t[j] = cpucycles();
+    FIPS202X3_NAMESPACE(shake128x3_squeezeblocks)(out[0], out[1], out[2], 1, &statex3);
+  }
+  print_results("KeccakF1600x3 (3 lanes):", t, NTESTS);
+#endif
+
+#if defined(__AVX2__) || defined(__riscv_vector)
+  FIPS202X4_NAMESPACE(shake128x4_absorb_once)(&statex4, in[0], in[1], in[2], in[3], 34);
+  for(j = 0; j < NTESTS; ++j) {
+    t[j] = cpucycles();
+    FIPS202X4_NAMESPACE(shake128x4_squeezeblocks)(out[0], out[1], out[2], out[3], 1, &statex4);
+  }
+  print_results("KeccakF1600x4 (4 lanes):", t, NTESTS);
+#endif
+
+#if defined(__AVX512F__)
+  FIPS202X8_NAMESPACE(shake128x8_absorb_once)(&statex8, inx8, 34);
+  for(j = 0; j < NTESTS; ++j) {
+    for(k = 0; k < 8; ++k)
+      outx8[k] = out[k];
+    t[j] = cpucycles();
+    FIPS202X8_NAMESPACE(shake128x8_squeezeblocks)(outx8, 1, &statex8);
+  }
+  print_results("KeccakF1600x8 (8 lanes):", t, NTESTS);
+#endif
+
+  for(j = 0; j < NTESTS/10; ++j) {
+    t[j] = cpucycles();
+    shake256_init(&state);
+    shake256_absorb(&state, big + 1, BIGLEN - 1);
+    shake256_finalize(&state);
+    shake256_squeeze(out[0], 64, &state);
+  }
+  print_results("SHAKE256 of 16 KiB (unaligned):", t, NTESTS/10);
+
+  return fail;
+}
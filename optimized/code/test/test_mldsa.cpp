@@ -0,0 +1,66 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include "../mldsa.hpp"
+
+extern "C" {
+#include "../randombytes.h"
+}
+
+#define MLEN 59
+#define NTESTS 1000
+
+/* Os três níveis no mesmo processo, sobre a biblioteca com os três modos */
+template <class S>
+static int test_level(const char *name) {
+  static typename S::public_key pk;
+  static typename S::secret_key sk;
+  static typename S::signature sig;
+  std::uint8_t m[MLEN];
+  std::uint8_t ctx[14] = "test_dilitium";
+  std::size_t i, j;
+  std::uint8_t b;
+
+  for(i = 0; i < NTESTS; ++i) {
+    randombytes(m, MLEN);
+
+    if(S::keypair(pk, sk) || S::sign(sig, m, ctx, sk)) {
+      std::fprintf(stderr, "%s: keypair/sign failed\n", name);
+      return -1;
+    }
+    if(!S::verify(sig, m, ctx, pk)) {
+      std::fprintf(stderr, "%s: verification failed\n", name);
+      return -1;
+    }
+    if(S::verify(sig, std::span<const std::uint8_t>(m, MLEN - 1), ctx, pk)) {
+      std::fprintf(stderr, "%s: wrong message verified\n", name);
+      return -1;
+    }
+
+    randombytes((std::uint8_t *)&j, sizeof(j));
+    do {
+      randombytes(&b, 1);
+    } while(!b);
+    sig[j % S::signature_bytes] += b;
+    if(S::verify(sig, m, ctx, pk)) {
+      std::fprintf(stderr, "%s: trivial forgeries possible\n", name);
+      return -1;
+    }
+  }
+
+  std::printf("%s: public key %zu, secret key %zu, signature %zu bytes\n", name,
+              S::public_key_bytes, S::secret_key_bytes, S::signature_bytes);
+  return 0;
+}
+
+int main(void)
+{
+  if(test_level<mldsa::ml_dsa_44>("ML-DSA-44"))
+    return -1;
+  if(test_level<mldsa::ml_dsa_65>("ML-DSA-65"))
+    return -1;
+  if(test_level<mldsa::ml_dsa_87>("ML-DSA-87"))
+    return -1;
+
+  return 0;
+}
@@ -24,11 +24,14 @@ static void poly_naivemul(poly *c, const poly *a, const poly *b) {
 int main(void) {
   unsigned int i, j;
   uint8_t seed[SEEDBYTES];
+  uint8_t cseed[CTILDEBYTES];
   uint16_t nonce = 0;
   poly a, b, c, d;
+  sparse_challenge cs;
 
   randombytes(seed, sizeof(seed));
   for(i = 0; i < NTESTS; ++i) {
+    randombytes(cseed, sizeof(cseed));
     //poly_uniform(&a, seed, nonce++);
     //poly_uniform(&b, seed, nonce++);
      // Prepara os arrays para processamento em lote
@@ -50,6 +53,16 @@ int main(void) {
                 j, c.coeffs[j]%Q, a.coeffs[j]);
     }
 
+    poly_challenge(&c, cseed);
+    poly_challenge_sparse(&cs, cseed);
+    poly_naivemul(&c, &c, &a);
+    poly_sparse_mul(&d, &cs, &a);
+    for(j = 0; j < N; ++j) {
+      if((d.coeffs[j] - c.coeffs[j]) % Q)
+        fprintf(stderr, "ERROR in sparse multiplication: d[%d] = %d != %d\n",
+                j, d.coeffs[j], c.coeffs[j]);
+    }
+
     poly_naivemul(&c, &a, &b);
     poly_ntt(&a);
     poly_ntt(&b);
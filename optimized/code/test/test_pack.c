@@ -0,0 +1,602 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "../params.h"
+#include "../randombytes.h"
+#include "../poly.h"
+#include "../rounding.h"
+
+#define NTESTS 10000
+
+/* Versões escalares de referência (as de poly.c) para comparar com as
+ * versões vetoriais de poly_neon.c */
+
+static void ref_polyeta_pack(uint8_t *r, const poly *a) {
+  unsigned int i;
+  uint8_t t[8];
+
+#if ETA == 2
+  for(i = 0; i < N/8; ++i) {
+    t[0] = ETA - a->coeffs[8*i+0];
+    t[1] = ETA - a->coeffs[8*i+1];
+    t[2] = ETA - a->coeffs[8*i+2];
+    t[3] = ETA - a->coeffs[8*i+3];
+    t[4] = ETA - a->coeffs[8*i+4];
+    t[5] = ETA - a->coeffs[8*i+5];
+    t[6] = ETA - a->coeffs[8*i+6];
+    t[7] = ETA - a->coeffs[8*i+7];
+
+    r[3*i+0]  = (t[0] >> 0) | (t[1] << 3) | (t[2] << 6);
+    r[3*i+1]  = (t[2] >> 2) | (t[3] << 1) | (t[4] << 4) | (t[5] << 7);
+    r[3*i+2]  = (t[5] >> 1) | (t[6] << 2) | (t[7] << 5);
+  }
+#elif ETA == 4
+  for(i = 0; i < N/2; ++i) {
+    t[0] = ETA - a->coeffs[2*i+0];
+    t[1] = ETA - a->coeffs[2*i+1];
+    r[i] = t[0] | (t[1] << 4);
+  }
+#endif
+}
+
+static void ref_polyeta_unpack(poly *r, const uint8_t *a) {
+  unsigned int i;
+
+#if ETA == 2
+  for(i = 0; i < N/8; ++i) {
+    r->coeffs[8*i+0] =  (a[3*i+0] >> 0) & 7;
+    r->coeffs[8*i+1] =  (a[3*i+0] >> 3) & 7;
+    r->coeffs[8*i+2] = ((a[3*i+0] >> 6) | (a[3*i+1] << 2)) & 7;
+    r->coeffs[8*i+3] =  (a[3*i+1] >> 1) & 7;
+    r->coeffs[8*i+4] =  (a[3*i+1] >> 4) & 7;
+    r->coeffs[8*i+5] = ((a[3*i+1] >> 7) | (a[3*i+2] << 1)) & 7;
+    r->coeffs[8*i+6] =  (a[3*i+2] >> 2) & 7;
+    r->coeffs[8*i+7] =  (a[3*i+2] >> 5) & 7;
+
+    r->coeffs[8*i+0] = ETA - r->coeffs[8*i+0];
+    r->coeffs[8*i+1] = ETA - r->coeffs[8*i+1];
+    r->coeffs[8*i+2] = ETA - r->coeffs[8*i+2];
+    r->coeffs[8*i+3] = ETA - r->coeffs[8*i+3];
+    r->coeffs[8*i+4] = ETA - r->coeffs[8*i+4];
+    r->coeffs[8*i+5] = ETA - r->coeffs[8*i+5];
+    r->coeffs[8*i+6] = ETA - r->coeffs[8*i+6];
+    r->coeffs[8*i+7] = ETA - r->coeffs[8*i+7];
+  }
+#elif ETA == 4
+  for(i = 0; i < N/2; ++i) {
+    r->coeffs[2*i+0] = a[i] & 0x0F;
+    r->coeffs[2*i+1] = a[i] >> 4;
+    r->coeffs[2*i+0] = ETA - r->coeffs[2*i+0];
+    r->coeffs[2*i+1] = ETA - r->coeffs[2*i+1];
+  }
+#endif
+}
+
+static void ref_polyt1_pack(uint8_t *r, const poly *a) {
+  unsigned int i;
+
+  for(i = 0; i < N/4; ++i) {
+    r[5*i+0] = (a->coeffs[4*i+0] >> 0);
+    r[5*i+1] = (a->coeffs[4*i+0] >> 8) | (a->coeffs[4*i+1] << 2);
+    r[5*i+2] = (a->coeffs[4*i+1] >> 6) | (a->coeffs[4*i+2] << 4);
+    r[5*i+3] = (a->coeffs[4*i+2] >> 4) | (a->coeffs[4*i+3] << 6);
+    r[5*i+4] = (a->coeffs[4*i+3] >> 2);
+  }
+}
+
+static void ref_polyt1_unpack(poly *r, const uint8_t *a) {
+  unsigned int i;
+
+  for(i = 0; i < N/4; ++i) {
+    r->coeffs[4*i+0] = ((a[5*i+0] >> 0) | ((uint32_t)a[5*i+1] << 8)) & 0x3FF;
+    r->coeffs[4*i+1] = ((a[5*i+1] >> 2) | ((uint32_t)a[5*i+2] << 6)) & 0x3FF;
+    r->coeffs[4*i+2] = ((a[5*i+2] >> 4) | ((uint32_t)a[5*i+3] << 4)) & 0x3FF;
+    r->coeffs[4*i+3] = ((a[5*i+3] >> 6) | ((uint32_t)a[5*i+4] << 2)) & 0x3FF;
+  }
+}
+
+static void ref_polyt0_pack(uint8_t *r, const poly *a) {
+  unsigned int i;
+  uint32_t t[8];
+
+  for(i = 0; i < N/8; ++i) {
+    t[0] = (1 << (D-1)) - a->coeffs[8*i+0];
+    t[1] = (1 << (D-1)) - a->coeffs[8*i+1];
+    t[2] = (1 << (D-1)) - a->coeffs[8*i+2];
+    t[3] = (1 << (D-1)) - a->coeffs[8*i+3];
+    t[4] = (1 << (D-1)) - a->coeffs[8*i+4];
+    t[5] = (1 << (D-1)) - a->coeffs[8*i+5];
+    t[6] = (1 << (D-1)) - a->coeffs[8*i+6];
+    t[7] = (1 << (D-1)) - a->coeffs[8*i+7];
+
+    r[13*i+ 0]  =  t[0];
+    r[13*i+ 1]  =  t[0] >>  8;
+    r[13*i+ 1] |=  t[1] <<  5;
+    r[13*i+ 2]  =  t[1] >>  3;
+    r[13*i+ 3]  =  t[1] >> 11;
+    r[13*i+ 3] |=  t[2] <<  2;
+    r[13*i+ 4]  =  t[2] >>  6;
+    r[13*i+ 4] |=  t[3] <<  7;
+    r[13*i+ 5]  =  t[3] >>  1;
+    r[13*i+ 6]  =  t[3] >>  9;
+    r[13*i+ 6] |=  t[4] <<  4;
+    r[13*i+ 7]  =  t[4] >>  4;
+    r[13*i+ 8]  =  t[4] >> 12;
+    r[13*i+ 8] |=  t[5] <<  1;
+    r[13*i+ 9]  =  t[5] >>  7;
+    r[13*i+ 9] |=  t[6] <<  6;
+    r[13*i+10]  =  t[6] >>  2;
+    r[13*i+11]  =  t[6] >> 10;
+    r[13*i+11] |=  t[7] <<  3;
+    r[13*i+12]  =  t[7] >>  5;
+  }
+}
+
+static void ref_polyt0_unpack(poly *r, const uint8_t *a) {
+  unsigned int i;
+
+  for(i = 0; i < N/8; ++i) {
+    r->coeffs[8*i+0]  = a[13*i+0];
+    r->coeffs[8*i+0] |= (uint32_t)a[13*i+1] << 8;
+    r->coeffs[8*i+0] &= 0x1FFF;
+
+    r->coeffs[8*i+1]  = a[13*i+1] >> 5;
+    r->coeffs[8*i+1] |= (uint32_t)a[13*i+2] << 3;
+    r->coeffs[8*i+1] |= (uint32_t)a[13*i+3] << 11;
+    r->coeffs[8*i+1] &= 0x1FFF;
+
+    r->coeffs[8*i+2]  = a[13*i+3] >> 2;
+    r->coeffs[8*i+2] |= (uint32_t)a[13*i+4] << 6;
+    r->coeffs[8*i+2] &= 0x1FFF;
+
+    r->coeffs[8*i+3]  = a[13*i+4] >> 7;
+    r->coeffs[8*i+3] |= (uint32_t)a[13*i+5] << 1;
+    r->coeffs[8*i+3] |= (uint32_t)a[13*i+6] << 9;
+    r->coeffs[8*i+3] &= 0x1FFF;
+
+    r->coeffs[8*i+4]  = a[13*i+6] >> 4;
+    r->coeffs[8*i+4] |= (uint32_t)a[13*i+7] << 4;
+    r->coeffs[8*i+4] |= (uint32_t)a[13*i+8] << 12;
+    r->coeffs[8*i+4] &= 0x1FFF;
+
+    r->coeffs[8*i+5]  = a[13*i+8] >> 1;
+    r->coeffs[8*i+5] |= (uint32_t)a[13*i+9] << 7;
+    r->coeffs[8*i+5] &= 0x1FFF;
+
+    r->coeffs[8*i+6]  = a[13*i+9] >> 6;
+    r->coeffs[8*i+6] |= (uint32_t)a[13*i+10] << 2;
+    r->coeffs[8*i+6] |= (uint32_t)a[13*i+11] << 10;
+    r->coeffs[8*i+6] &= 0x1FFF;
+
+    r->coeffs[8*i+7]  = a[13*i+11] >> 3;
+    r->coeffs[8*i+7] |= (uint32_t)a[13*i+12] << 5;
+    r->coeffs[8*i+7] &= 0x1FFF;
+
+    r->coeffs[8*i+0] = (1 << (D-1)) - r->coeffs[8*i+0];
+    r->coeffs[8*i+1] = (1 << (D-1)) - r->coeffs[8*i+1];
+    r->coeffs[8*i+2] = (1 << (D-1)) - r->coeffs[8*i+2];
+    r->coeffs[8*i+3] = (1 << (D-1)) - r->coeffs[8*i+3];
+    r->coeffs[8*i+4] = (1 << (D-1)) - r->coeffs[8*i+4];
+    r->coeffs[8*i+5] = (1 << (D-1)) - r->coeffs[8*i+5];
+    r->coeffs[8*i+6] = (1 << (D-1)) - r->coeffs[8*i+6];
+    r->coeffs[8*i+7] = (1 << (D-1)) - r->coeffs[8*i+7];
+  }
+}
+
+static void ref_polyz_pack(uint8_t *r, const poly *a) {
+  unsigned int i;
+  uint32_t t[4];
+
+#if GAMMA1 == (1 << 17)
+  for(i = 0; i < N/4; ++i) {
+    t[0] = GAMMA1 - a->coeffs[4*i+0];
+    t[1] = GAMMA1 - a->coeffs[4*i+1];
+    t[2] = GAMMA1 - a->coeffs[4*i+2];
+    t[3] = GAMMA1 - a->coeffs[4*i+3];
+
+    r[9*i+0]  = t[0];
+    r[9*i+1]  = t[0] >> 8;
+    r[9*i+2]  = t[0] >> 16;
+    r[9*i+2] |= t[1] << 2;
+    r[9*i+3]  = t[1] >> 6;
+    r[9*i+4]  = t[1] >> 14;
+    r[9*i+4] |= t[2] << 4;
+    r[9*i+5]  = t[2] >> 4;
+    r[9*i+6]  = t[2] >> 12;
+    r[9*i+6] |= t[3] << 6;
+    r[9*i+7]  = t[3] >> 2;
+    r[9*i+8]  = t[3] >> 10;
+  }
+#elif GAMMA1 == (1 << 19)
+  for(i = 0; i < N/2; ++i) {
+    t[0] = GAMMA1 - a->coeffs[2*i+0];
+    t[1] = GAMMA1 - a->coeffs[2*i+1];
+
+    r[5*i+0]  = t[0];
+    r[5*i+1]  = t[0] >> 8;
+    r[5*i+2]  = t[0] >> 16;
+    r[5*i+2] |= t[1] << 4;
+    r[5*i+3]  = t[1] >> 4;
+    r[5*i+4]  = t[1] >> 12;
+  }
+#endif
+}
+
+static void ref_polyz_unpack(poly *r, const uint8_t *a) {
+  unsigned int i;
+
+#if GAMMA1 == (1 << 17)
+  for(i = 0; i < N/4; ++i) {
+    r->coeffs[4*i+0]  = a[9*i+0];
+    r->coeffs[4*i+0] |= (uint32_t)a[9*i+1] << 8;
+    r->coeffs[4*i+0] |= (uint32_t)a[9*i+2] << 16;
+    r->coeffs[4*i+0] &= 0x3FFFF;
+
+    r->coeffs[4*i+1]  = a[9*i+2] >> 2;
+    r->coeffs[4*i+1] |= (uint32_t)a[9*i+3] << 6;
+    r->coeffs[4*i+1] |= (uint32_t)a[9*i+4] << 14;
+    r->coeffs[4*i+1] &= 0x3FFFF;
+
+    r->coeffs[4*i+2]  = a[9*i+4] >> 4;
+    r->coeffs[4*i+2] |= (uint32_t)a[9*i+5] << 4;
+    r->coeffs[4*i+2] |= (uint32_t)a[9*i+6] << 12;
+    r->coeffs[4*i+2] &= 0x3FFFF;
+
+    r->coeffs[4*i+3]  = a[9*i+6] >> 6;
+    r->coeffs[4*i+3] |= (uint32_t)a[9*i+7] << 2;
+    r->coeffs[4*i+3] |= (uint32_t)a[9*i+8] << 10;
+    r->coeffs[4*i+3] &= 0x3FFFF;
+
+    r->coeffs[4*i+0] = GAMMA1 - r->coeffs[4*i+0];
+    r->coeffs[4*i+1] = GAMMA1 - r->coeffs[4*i+1];
+    r->coeffs[4*i+2] = GAMMA1 - r->coeffs[4*i+2];
+    r->coeffs[4*i+3] = GAMMA1 - r->coeffs[4*i+3];
+  }
+#elif GAMMA1 == (1 << 19)
+  for(i = 0; i < N/2; ++i) {
+    r->coeffs[2*i+0]  = a[5*i+0];
+    r->coeffs[2*i+0] |= (uint32_t)a[5*i+1] << 8;
+    r->coeffs[2*i+0] |= (uint32_t)a[5*i+2] << 16;
+    r->coeffs[2*i+0] &= 0xFFFFF;
+
+    r->coeffs[2*i+1]  = a[5*i+2] >> 4;
+    r->coeffs[2*i+1] |= (uint32_t)a[5*i+3] << 4;
+    r->coeffs[2*i+1] |= (uint32_t)a[5*i+4] << 12;
+
+    r->coeffs[2*i+0] = GAMMA1 - r->coeffs[2*i+0];
+    r->coeffs[2*i+1] = GAMMA1 - r->coeffs[2*i+1];
+  }
+#endif
+}
+
+static void ref_polyw1_pack(uint8_t *r, const poly *a) {
+  unsigned int i;
+
+#if GAMMA2 == (Q-1)/88
+  for(i = 0; i < N/4; ++i) {
+    r[3*i+0]  = a->coeffs[4*i+0];
+    r[3*i+0] |= a->coeffs[4*i+1] << 6;
+    r[3*i+1]  = a->coeffs[4*i+1] >> 2;
+    r[3*i+1] |= a->coeffs[4*i+2] << 4;
+    r[3*i+2]  = a->coeffs[4*i+2] >> 4;
+    r[3*i+2] |= a->coeffs[4*i+3] << 2;
+  }
+#elif GAMMA2 == (Q-1)/32
+  for(i = 0; i < N/2; ++i)
+    r[i] = a->coeffs[2*i+0] | (a->coeffs[2*i+1] << 4);
+#endif
+}
+
+// Sequência de poly_add, poly_caddq e power2round da referência
+static void ref_power2round(poly *c1, poly *c0, const poly *a, const poly *b) {
+  unsigned int i;
+  int32_t c;
+
+  for(i = 0; i < N; ++i) {
+    c = a->coeffs[i] + b->coeffs[i];
+    c += (c >> 31) & Q;
+    c1->coeffs[i] = (c + (1 << (D-1)) - 1) >> D;
+    c0->coeffs[i] = c - (c1->coeffs[i] << D);
+  }
+}
+
+// Bytes após o polinômio empacotado: não podem ser alterados
+#define GUARD 32
+
+static int check_bytes(const char *name, const uint8_t *buf, const uint8_t *ref, size_t len) {
+  size_t i;
+
+  if(memcmp(buf, ref, len)) {
+    fprintf(stderr, "ERROR in %s: packed bytes differ\n", name);
+    return 1;
+  }
+  for(i = len; i < len + GUARD; ++i)
+    if(buf[i] != 0xA5) {
+      fprintf(stderr, "ERROR in %s: write past the end\n", name);
+      return 1;
+    }
+  return 0;
+}
+
+static int check_poly(const char *name, const poly *a, const poly *b) {
+  unsigned int j;
+
+  for(j = 0; j < N; ++j)
+    if(a->coeffs[j] != b->coeffs[j]) {
+      fprintf(stderr, "ERROR in %s: c[%u] = %d != %d\n", name, j, a->coeffs[j], b->coeffs[j]);
+      return 1;
+    }
+  return 0;
+}
+
+/* Arredondamento vetorial de poly_simd.c contra rounding.c para todo a em
+ * [0, Q), em lotes de RBATCH polinômios */
+#define RBATCH 4
+
+#if defined(__riscv_vector)
+// Em RVV não há versões _n: um polinômio por vez
+static void poly_power2round_n(poly *a1, poly *a0, const poly *a, unsigned int len) {
+  while(len--)
+    poly_power2round(a1++, a0++, a++);
+}
+
+static void poly_decompose_n(poly *a1, poly *a0, const poly *a, unsigned int len) {
+  while(len--)
+    poly_decompose(a1++, a0++, a++);
+}
+
+static unsigned int poly_make_hint_n(poly *h, const poly *a0, const poly *a1, unsigned int len) {
+  unsigned int s = 0;
+
+  while(len--)
+    s += poly_make_hint(h++, a0++, a1++);
+  return s;
+}
+
+static void poly_use_hint_n(poly *b, const poly *a, const poly *h, unsigned int len) {
+  while(len--)
+    poly_use_hint(b++, a++, h++);
+}
+#endif
+
+static int check_coeff(const char *name, int32_t a, int32_t r, int32_t ref) {
+  if(r != ref) {
+    fprintf(stderr, "ERROR in %s: a = %d gives %d != %d\n", name, a, r, ref);
+    return 1;
+  }
+  return 0;
+}
+
+static int check_rounding(void) {
+  static poly a[RBATCH], a1[RBATCH], a0[RBATCH], h[RBATCH], b[RBATCH];
+  unsigned int j, k, t, s, sref;
+  int32_t v, x, r0, r1;
+  int err = 0;
+
+  for(v = 0; v < Q && !err; ) {
+    for(k = 0; k < RBATCH; ++k)
+      for(j = 0; j < N; ++j)
+        a[k].coeffs[j] = v < Q ? v++ : 0;
+
+    poly_power2round_n(a1, a0, a, RBATCH);
+    for(k = 0; k < RBATCH; ++k)
+      for(j = 0; j < N; ++j) {
+        x = a[k].coeffs[j];
+        r1 = power2round(&r0, x);
+        err |= check_coeff("poly_power2round_n (a1)", x, a1[k].coeffs[j], r1);
+        err |= check_coeff("poly_power2round_n (a0)", x, a0[k].coeffs[j], r0);
+      }
+
+    poly_decompose_n(a1, a0, a, RBATCH);
+    for(k = 0; k < RBATCH; ++k)
+      for(j = 0; j < N; ++j) {
+        x = a[k].coeffs[j];
+        r1 = decompose(&r0, x);
+        err |= check_coeff("poly_decompose_n (a1)", x, a1[k].coeffs[j], r1);
+        err |= check_coeff("poly_decompose_n (a0)", x, a0[k].coeffs[j], r0);
+      }
+
+    // Cada a com dica 0 e com dica 1
+    for(t = 0; t < 2; ++t) {
+      for(k = 0; k < RBATCH; ++k)
+        for(j = 0; j < N; ++j)
+          h[k].coeffs[j] = (j + t) & 1;
+      poly_use_hint_n(b, a, h, RBATCH);
+      for(k = 0; k < RBATCH; ++k)
+        for(j = 0; j < N; ++j) {
+          x = a[k].coeffs[j];
+          err |= check_coeff("poly_use_hint_n", x, b[k].coeffs[j], use_hint(x, (j + t) & 1));
+        }
+    }
+
+    /* make_hint com a0 = a - (Q-1)/2, que percorre [-(Q-1)/2, (Q-1)/2] e
+     * passa por -GAMMA2 e GAMMA2, com a1 das partes altas de a e com a1 = 0 */
+    for(t = 0; t < 2; ++t) {
+      sref = 0;
+      for(k = 0; k < RBATCH; ++k)
+        for(j = 0; j < N; ++j) {
+          a0[k].coeffs[j] = a[k].coeffs[j] - (Q-1)/2;
+          if(t)
+            a1[k].coeffs[j] = 0;
+          sref += make_hint(a0[k].coeffs[j], a1[k].coeffs[j]);
+        }
+      s = poly_make_hint_n(h, a0, a1, RBATCH);
+      for(k = 0; k < RBATCH; ++k)
+        for(j = 0; j < N; ++j) {
+          x = a0[k].coeffs[j];
+          err |= check_coeff("poly_make_hint_n", x, h[k].coeffs[j], make_hint(x, a1[k].coeffs[j]));
+        }
+      err |= check_coeff("poly_make_hint_n (count)", a[0].coeffs[0], s, sref);
+    }
+  }
+
+  return err;
+}
+
+int main(void) {
+  unsigned int i, j, r;
+  int32_t v;
+  int err = 0;
+  uint32_t rnd[N];
+  uint8_t buf[POLYZ_PACKEDBYTES + GUARD], ref[POLYZ_PACKEDBYTES + GUARD];
+  uint8_t buf1[POLYT1_PACKEDBYTES + GUARD], ref1[POLYT1_PACKEDBYTES + GUARD];
+  poly a, b, c, d, e;
+  static const int32_t w_edge[] = {
+    -(Q - 1), -(Q - GAMMA2 + 1), -(Q - GAMMA2), -(GAMMA2 + 1), -GAMMA2, -1, 0, 1,
+    GAMMA2, GAMMA2 + 1, Q - GAMMA2 - 2, Q - GAMMA2 - 1, Q - GAMMA2, Q - GAMMA2 + 1, Q - 1
+  };
+
+  if(check_rounding())
+    return -1;
+
+  // eta: todos os valores em [-ETA, ETA] em todas as posições
+  for(r = 0; r < N; ++r) {
+    for(j = 0; j < N; ++j)
+      a.coeffs[j] = (int32_t)((j + r) % (2*ETA + 1)) - ETA;
+
+    memset(buf, 0xA5, sizeof(buf));
+    polyeta_pack(buf, &a);
+    ref_polyeta_pack(ref, &a);
+    err |= check_bytes("polyeta_pack", buf, ref, POLYETA_PACKEDBYTES);
+
+    polyeta_unpack(&b, buf);
+    err |= check_poly("polyeta_unpack", &b, &a);
+    if(err)
+      return -1;
+  }
+
+  /* t1 e t0: todos os valores, em cada posição de um grupo de 8 e no
+   * último grupo, com ida e volta */
+  for(r = 0; r < 16; ++r) {
+    for(v = 0; v < (1 << 10); v += N) {
+      for(j = 0; j < N; ++j)
+        a.coeffs[(j + r) % N] = v + j;
+
+      memset(buf, 0xA5, sizeof(buf));
+      polyt1_pack(buf, &a);
+      ref_polyt1_pack(ref, &a);
+      err |= check_bytes("polyt1_pack", buf, ref, POLYT1_PACKEDBYTES);
+
+      polyt1_unpack(&b, buf);
+      err |= check_poly("polyt1_unpack", &b, &a);
+      if(err)
+        return -1;
+    }
+
+    for(v = -(1 << (D-1)) + 1; v <= (1 << (D-1)); v += N) {
+      for(j = 0; j < N; ++j)
+        a.coeffs[(j + r) % N] = v + j;
+
+      memset(buf, 0xA5, sizeof(buf));
+      polyt0_pack(buf, &a);
+      ref_polyt0_pack(ref, &a);
+      err |= check_bytes("polyt0_pack", buf, ref, POLYT0_PACKEDBYTES);
+
+      polyt0_unpack(&b, buf);
+      err |= check_poly("polyt0_unpack", &b, &a);
+      if(err)
+        return -1;
+    }
+  }
+
+  /* z: todos os valores em [-(GAMMA1 - 1), GAMMA1], em cada posição de um
+   * grupo de 4 e no último grupo, com ida e volta */
+  for(r = 0; r < 8; ++r) {
+    for(v = -(GAMMA1 - 1); v <= GAMMA1; v += N) {
+      for(j = 0; j < N; ++j)
+        a.coeffs[(j + r) % N] = v + j;
+
+      memset(buf, 0xA5, sizeof(buf));
+      polyz_pack(buf, &a);
+      ref_polyz_pack(ref, &a);
+      err |= check_bytes("polyz_pack", buf, ref, POLYZ_PACKEDBYTES);
+
+      polyz_unpack(&b, buf);
+      err |= check_poly("polyz_unpack", &b, &a);
+      if(err)
+        return -1;
+    }
+  }
+
+  // Bytes quaisquer, inclusive valores fora dos intervalos
+  for(i = 0; i < NTESTS; ++i) {
+    randombytes(buf, POLYZ_PACKEDBYTES);
+    polyeta_unpack(&b, buf);
+    ref_polyeta_unpack(&c, buf);
+    err |= check_poly("polyeta_unpack", &b, &c);
+    polyt1_unpack(&b, buf);
+    ref_polyt1_unpack(&c, buf);
+    err |= check_poly("polyt1_unpack", &b, &c);
+    polyt0_unpack(&b, buf);
+    ref_polyt0_unpack(&c, buf);
+    err |= check_poly("polyt0_unpack", &b, &c);
+    polyz_unpack(&b, buf);
+    ref_polyz_unpack(&c, buf);
+    err |= check_poly("polyz_unpack", &b, &c);
+    if(err)
+      return -1;
+  }
+
+  /* power2round com empacotamento de t1 e t0: A*s1 com |c| < Q - ETA e
+   * s2 com coeficientes em [-ETA, ETA] */
+  for(i = 0; i < NTESTS; ++i) {
+    randombytes((uint8_t *)rnd, sizeof(rnd));
+    for(j = 0; j < N; ++j) {
+      a.coeffs[j] = (int32_t)(rnd[j] % (2*(Q - ETA) - 1)) - (Q - ETA - 1);
+      b.coeffs[j] = (int32_t)((rnd[j] >> 24) % (2*ETA + 1)) - ETA;
+    }
+    if(i == 0)
+      for(j = 0; j < N; ++j)
+        a.coeffs[j] = (j & 1) ? Q - ETA - 1 : -(Q - ETA - 1);
+
+    memset(buf, 0xA5, sizeof(buf));
+    memset(buf1, 0xA5, sizeof(buf1));
+    poly_power2round_pack(buf1, buf, &a, &b);
+    ref_power2round(&c, &a, &a, &b);
+    ref_polyt1_pack(ref1, &c);
+    ref_polyt0_pack(ref, &a);
+    err |= check_bytes("poly_power2round_pack (t1)", buf1, ref1, POLYT1_PACKEDBYTES);
+    err |= check_bytes("poly_power2round_pack (t0)", buf, ref, POLYT0_PACKEDBYTES);
+    if(err)
+      return -1;
+  }
+
+  /* decompose com empacotamento de w1: coeficientes em ]-Q, Q[, inclusive
+   * os extremos e os vizinhos de Q - GAMMA2, onde c1 volta a 0 */
+  for(i = 0; i < NTESTS; ++i) {
+    randombytes((uint8_t *)rnd, sizeof(rnd));
+    for(j = 0; j < N; ++j)
+      a.coeffs[j] = (int32_t)(rnd[j] % (2*Q - 1)) - (Q - 1);
+    if(i == 0)
+      for(j = 0; j < N; ++j)
+        a.coeffs[j] = w_edge[j % (sizeof(w_edge)/sizeof(w_edge[0]))];
+    for(j = 0; j < N; ++j) {
+      v = a.coeffs[j] + ((a.coeffs[j] >> 31) & Q);
+      d.coeffs[j] = decompose(&e.coeffs[j], v);
+    }
+
+    memset(buf, 0xA5, sizeof(buf));
+    poly_decompose_w1(buf, &b, &c, &a);
+    ref_polyw1_pack(ref, &d);
+    err |= check_bytes("poly_decompose_w1", buf, ref, POLYW1_PACKEDBYTES);
+    err |= check_poly("poly_decompose_w1 (a1)", &b, &d);
+    err |= check_poly("poly_decompose_w1 (a0)", &c, &e);
+    if(err)
+      return -1;
+  }
+
+  // w1: todos os valores em [0, (Q-1)/(2*GAMMA2) - 1] em todas as posições
+  for(r = 0; r < N; ++r) {
+    for(j = 0; j < N; ++j)
+      a.coeffs[j] = (j + r) % ((Q-1)/(2*GAMMA2));
+
+    memset(buf, 0xA5, sizeof(buf));
+    polyw1_pack(buf, &a);
+    ref_polyw1_pack(ref, &a);
+    err |= check_bytes("polyw1_pack", buf, ref, POLYW1_PACKEDBYTES);
+    if(err)
+      return -1;
+  }
+
+  return 0;
+}
@@ -10,6 +10,7 @@
 #define NTESTS 1000
 
 uint64_t t[NTESTS];
+static dilithium_workspace ws;
 
 int main(void)
 {
@@ -23,6 +24,8 @@ int main(void)
   poly *a = &mat[0].vec[0];
   poly *b = &mat[0].vec[1];
   poly *c = &mat[0].vec[2];
+  sparse_challenge cs;
+  dilithium_mu_prefix skprefix, pkprefix;
 
   for(i = 0; i < NTESTS; ++i) {
     t[i] = cpucycles();
@@ -67,6 +70,13 @@ int main(void)
   }
   print_results("poly_challenge:", t, NTESTS);
 
+  poly_challenge_sparse(&cs, seed);
+  for(i = 0; i < NTESTS; ++i) {
+    t[i] = cpucycles();
+    poly_sparse_mul(c, &cs, a);
+  }
+  print_results("poly_sparse_mul:", t, NTESTS);
+
   for(i = 0; i < NTESTS; ++i) {
     t[i] = cpucycles();
     crypto_sign_keypair(pk, sk);
@@ -85,5 +95,19 @@ int main(void)
   }
   print_results("Verify:", t, NTESTS);
 
+  crypto_sign_prefix_sk(&skprefix, NULL, 0, sk);
+  for(i = 0; i < NTESTS; ++i) {
+    t[i] = cpucycles();
+    crypto_sign_signature_prefix_ws(sig, &siglen, sig, CRHBYTES, &skprefix, sk, &ws);
+  }
+  print_results("Sign (cached mu prefix):", t, NTESTS);
+
+  crypto_sign_prefix_pk(&pkprefix, NULL, 0, pk);
+  for(i = 0; i < NTESTS; ++i) {
+    t[i] = cpucycles();
+    crypto_sign_verify_prefix_ws(sig, CRYPTO_BYTES, sig, CRHBYTES, &pkprefix, pk, &ws);
+  }
+  print_results("Verify (cached mu prefix):", t, NTESTS);
+
   return 0;
 }
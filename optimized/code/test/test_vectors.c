@@ -35,6 +35,7 @@ int main(void) {
   poly c, tmp;
   polyvecl s, y, mat[K];
   polyveck w, w1, w0, t1, t0, h;
+  bitset_hint hb;
 
   snprintf((char*)ctx,CTXLEN,"test_vectors");
 
@@ -238,8 +239,10 @@ int main(void) {
       else printf("]\n");
     }
 
-    polyveck_make_hint(&h, &w0, &w1);
-    pack_sig(buf, seed, &y, &h);
+    for(j = 0; j < K; ++j)
+      poly_make_hint(&h.vec[j], &w0.vec[j], &w1.vec[j]);
+    polyveck_make_hint(&hb, &w0, &w1);
+    pack_sig(buf, seed, &y, &hb);
     unpack_sig(seed, &y, &w, buf);
     if(memcmp(&h,&w,sizeof(h)))
       fprintf(stderr, "ERROR in (un)pack_sig!\n");
@@ -0,0 +1,90 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "params.h"
+#include "sign.h"
+
+/* Exportações do módulo WebAssembly (make ARCH=wasm wasm): um módulo
+ * reactor por modo, chamado a partir de JavaScript ou de um runtime WASI.
+ * Os buffers vêm de mldsa_alloc, na memória linear do módulo. A pilha
+ * padrão do wasm-ld é de 64 KiB, menor que as matrizes de sign.c, por
+ * isso todas as chamadas usam um dilithium_workspace estático. */
+
+#define WASM_EXPORT(name) __attribute__((export_name(#name)))
+
+static dilithium_workspace ws;
+static dilithium_mu_prefix prefix;
+
+WASM_EXPORT(mldsa_publickeybytes)
+size_t mldsa_publickeybytes(void);
+size_t mldsa_publickeybytes(void) {
+  return CRYPTO_PUBLICKEYBYTES;
+}
+
+WASM_EXPORT(mldsa_secretkeybytes)
+size_t mldsa_secretkeybytes(void);
+size_t mldsa_secretkeybytes(void) {
+  return CRYPTO_SECRETKEYBYTES;
+}
+
+WASM_EXPORT(mldsa_signaturebytes)
+size_t mldsa_signaturebytes(void);
+size_t mldsa_signaturebytes(void) {
+  return CRYPTO_BYTES;
+}
+
+WASM_EXPORT(mldsa_alloc)
+void *mldsa_alloc(size_t len);
+void *mldsa_alloc(size_t len) {
+  return malloc(len);
+}
+
+WASM_EXPORT(mldsa_free)
+void mldsa_free(void *p);
+void mldsa_free(void *p) {
+  free(p);
+}
+
+WASM_EXPORT(mldsa_keypair)
+int mldsa_keypair(uint8_t *pk, uint8_t *sk);
+int mldsa_keypair(uint8_t *pk, uint8_t *sk) {
+  return crypto_sign_keypair_ws(pk, sk, &ws);
+}
+
+// Retorna o tamanho da assinatura, ou -1 em caso de erro
+WASM_EXPORT(mldsa_sign)
+int mldsa_sign(uint8_t *sig, const uint8_t *m, size_t mlen,
+               const uint8_t *ctx, size_t ctxlen, const uint8_t *sk);
+int mldsa_sign(uint8_t *sig, const uint8_t *m, size_t mlen,
+               const uint8_t *ctx, size_t ctxlen, const uint8_t *sk) {
+  size_t siglen;
+
+  if(crypto_sign_signature_ws(sig, &siglen, m, mlen, ctx, ctxlen, sk, &ws))
+    return -1;
+  return (int)siglen;
+}
+
+WASM_EXPORT(mldsa_verify)
+int mldsa_verify(const uint8_t *sig, size_t siglen, const uint8_t *m, size_t mlen,
+                 const uint8_t *ctx, size_t ctxlen, const uint8_t *pk);
+int mldsa_verify(const uint8_t *sig, size_t siglen, const uint8_t *m, size_t mlen,
+                 const uint8_t *ctx, size_t ctxlen, const uint8_t *pk) {
+  return crypto_sign_verify_ws(sig, siglen, m, mlen, ctx, ctxlen, pk, &ws);
+}
+
+/* Verificação de muitas mensagens com a mesma chave pública e o mesmo
+ * contexto: mldsa_verify_init absorve tr || 0 || ctxlen || ctx uma única
+ * vez e mldsa_verify_prefixed só absorve a mensagem. */
+WASM_EXPORT(mldsa_verify_init)
+int mldsa_verify_init(const uint8_t *ctx, size_t ctxlen, const uint8_t *pk);
+int mldsa_verify_init(const uint8_t *ctx, size_t ctxlen, const uint8_t *pk) {
+  return crypto_sign_prefix_pk(&prefix, ctx, ctxlen, pk);
+}
+
+WASM_EXPORT(mldsa_verify_prefixed)
+int mldsa_verify_prefixed(const uint8_t *sig, size_t siglen,
+                          const uint8_t *m, size_t mlen, const uint8_t *pk);
+int mldsa_verify_prefixed(const uint8_t *sig, size_t siglen,
+                          const uint8_t *m, size_t mlen, const uint8_t *pk) {
+  return crypto_sign_verify_prefix_ws(sig, siglen, m, mlen, &prefix, pk, &ws);
+}